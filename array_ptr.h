@@ -5,51 +5,61 @@
 #include <cassert>
 #include <cstdlib>
 #include <algorithm>
+#include <type_traits>
 
 template <typename Type>
 class ArrayPtr 
 {
 public:
     
-    //   
-    ArrayPtr() = default; 
+    // Инициализирует нулевым указателем
+    constexpr ArrayPtr() = default; 
 
-    //    
-    explicit ArrayPtr(size_t size)
+    // Создает в куче массив
+    constexpr explicit ArrayPtr(size_t size)
     {
         if (size == 0)
         {
             raw_ptr = nullptr;
         }
+        else if (std::is_constant_evaluated())
+        {
+            // При вычислении на этапе компиляции нужен обычный new без отладочной подмены из detector.h,
+            // а элементы инициализируются значениями, потому что неинициализированные читать нельзя
+#pragma push_macro("new")
+#undef new
+            raw_ptr = new Type[size]();
+#pragma pop_macro("new")
+        }
         else
         {
             raw_ptr = new Type[size];
         }
     }
  
-    //      
-    explicit ArrayPtr(Type* raw_ptr_) noexcept : raw_ptr(raw_ptr_){}
+    // Конструктор хранящий адрус массива в куче
+    constexpr explicit ArrayPtr(Type* raw_ptr_) noexcept : raw_ptr(raw_ptr_){}
 
-    //  
+    // Запрет копирования
     ArrayPtr(const ArrayPtr&) = delete;
 
-    //  
-    ArrayPtr(ArrayPtr&& other) noexcept : raw_ptr(other.raw_ptr)
+    // Конструктор перемещения
+    constexpr ArrayPtr(ArrayPtr&& other) noexcept : raw_ptr(other.raw_ptr)
     {
         other.raw_ptr = nullptr;
     }
 
-    // 
-    ~ArrayPtr() 
+    // Деструктор
+    constexpr ~ArrayPtr() 
     {
-        //delete[] raw_ptr;
+        delete[] raw_ptr;
     }
 
-    //  
+    // Запрет присваивания
     ArrayPtr& operator=(const ArrayPtr&) = delete;
 
-    //   
-    ArrayPtr& operator=(ArrayPtr&& other) noexcept
+    // Оператор присваивания перемещением
+    constexpr ArrayPtr& operator=(ArrayPtr&& other) noexcept
     {
         if (this != &other)
         {
@@ -60,8 +70,8 @@ public:
         return *this;
     }
 
-    //      
-    Type* release() noexcept 
+    // Прекращает владение массивом и удаляет указатель
+    constexpr Type* release() noexcept 
     {
         Type* tmp = raw_ptr;
         raw_ptr = nullptr;
@@ -69,20 +79,20 @@ public:
         
     }
 
-    //     O(1)
-    Type& operator[](size_t index) noexcept 
+    // Получение ссылки по индексу O(1)
+    constexpr Type& operator[](size_t index) noexcept 
     {
         return raw_ptr[index];
     }
 
-    //      O(1)
-    const Type& operator[](size_t index) const noexcept 
+    // Получение константной ссылки по индексу O(1)
+    constexpr const Type& operator[](size_t index) const noexcept 
     {
         return raw_ptr[index];
     }
 
-    //     O(1)
-    explicit operator bool() const 
+    // Проверка на нулевой указатель O(1)
+    constexpr explicit operator bool() const 
     {
         if (raw_ptr)
         {
@@ -91,14 +101,14 @@ public:
         return false;
     }
 
-    //    O(1)
-    Type* get() const noexcept 
+    // Получение адреса массива O(1)
+    constexpr Type* get() const noexcept 
     {
         return raw_ptr;
     }
 
-    //   O(1)
-    void swap(ArrayPtr& other) noexcept 
+    // Обмен значений O(1)
+    constexpr void swap(ArrayPtr& other) noexcept 
     {
         std::swap(other.raw_ptr, raw_ptr);
     }
@@ -0,0 +1,1520 @@
+#pragma once
+
+#include "log.h"
+#include "simple_vector.h"
+#include "soa_vector.h"
+#include "packed_vector.h"
+#include "flat_map.h"
+#include "flat_hash_map.h"
+#include "ring_buffer.h"
+#include "concurrent_queue.h"
+#include "gap_buffer.h"
+#include "tiered_vector.h"
+#include "static_vector.h"
+#include "range_pipeline.h"
+#include "sort.h"
+#include "thread_pool.h"
+#include "parallel_expression.h"
+#include "erase.h"
+#include "memory_pages.h"
+#include "heterogeneous_vector.h"
+#include "nd_vector.h"
+#include "buffer_recycler.h"
+
+#include <iostream>
+#include <map>
+#include <mutex>
+#include <numeric>
+#include <set>
+#include <random>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <variant>
+
+using namespace std;
+
+// Частица из 12 полей: горячий цикл читает только position_x и mass
+struct Particle
+{
+    float position_x = 0, position_y = 0, position_z = 0;
+    float velocity_x = 0, velocity_y = 0, velocity_z = 0;
+    float force_x = 0, force_y = 0, force_z = 0;
+    float mass = 0, charge = 0, radius = 0;
+};
+
+using ParticleColumns = SoAVector<float, float, float, float, float, float, float, float, float, float, float, float>;
+
+// Редукция по двум полям: массив структур против структуры массивов
+inline void BenchmarkSoAVector(size_t rows)
+{
+    SimpleVector<Particle> aos;
+    aos.reserve(rows);
+
+    ParticleColumns soa;
+    soa.reserve(rows);
+
+    for (size_t i = 0; i < rows; ++i)
+    {
+        const float value = static_cast<float>(i % 1024);
+
+        Particle particle;
+        particle.position_x = value;
+        particle.mass = value * 0.5f;
+
+        aos.push_back(particle);
+        soa.push_back(value, 0, 0, 0, 0, 0, 0, 0, 0, value * 0.5f, 0, 0);
+    }
+
+    double aos_sum = 0;
+    {
+        LOG_DURATION("SoAVector: AoS reduction of 2 fields");
+
+        for (const Particle& particle : aos)
+        {
+            aos_sum += particle.position_x * particle.mass;
+        }
+    }
+
+    double soa_sum = 0;
+    {
+        LOG_DURATION("SoAVector: SoA reduction of 2 fields");
+
+        const auto positions = soa.column<0>();
+        const auto masses = soa.column<9>();
+
+        for (size_t i = 0; i < positions.size(); ++i)
+        {
+            soa_sum += positions[i] * masses[i];
+        }
+    }
+
+    cerr << "SoAVector: rows = "s << rows << ", sums = "s << aos_sum << " / "s << soa_sum << endl;
+}
+
+// Сумма значений упакованного вектора последовательным итератором
+template <typename Packed>
+inline void BenchmarkPackedScan(const string& name, const SimpleVector<uint64_t>& values)
+{
+    uint64_t plain_sum = 0;
+    {
+        LOG_DURATION("PackedVector: "s + name + ": SimpleVector scan"s);
+
+        for (uint64_t value : values)
+        {
+            plain_sum += value;
+        }
+    }
+
+    const Packed packed(values);
+
+    uint64_t packed_sum = 0;
+    {
+        LOG_DURATION("PackedVector: "s + name + ": packed scan"s);
+
+        for (uint64_t value : packed)
+        {
+            packed_sum += value;
+        }
+    }
+
+    const double ratio = static_cast<double>(values.get_size() * sizeof(uint64_t)) / static_cast<double>(packed.memory_bytes());
+    cerr << "PackedVector: "s << name << ": memory ratio = "s << ratio << ", sums equal = "s << (plain_sum == packed_sum) << endl;
+}
+
+// Распаковка блоков пакетным чтением с переносом слова между итерациями и развернутыми функциями фиксированной разрядности
+inline void BenchmarkPackedUnpack(size_t blocks)
+{
+    mt19937_64 generator(42);
+
+    for (unsigned width : { 3u, 10u, 17u, 33u, 50u })
+    {
+        const size_t block_words = PackedBits::WordCount(PackedBits::kBlockSize, width);
+        SimpleVector<uint64_t> words(blocks * block_words);
+        generate(words.begin(), words.end(), [&generator]() { return generator(); });
+
+        array<uint64_t, PackedBits::kBlockSize> out{};
+        uint64_t stream_sum = 0;
+        {
+            LOG_DURATION("PackedUnpack: width "s + to_string(width) + ": Unpack"s);
+
+            for (size_t block = 0; block < blocks; ++block)
+            {
+                PackedBits::Unpack(words.data(), block * block_words * 64, width, PackedBits::kBlockSize, out.data());
+                stream_sum += out[block % PackedBits::kBlockSize];
+            }
+        }
+
+        uint64_t block_sum = 0;
+        {
+            LOG_DURATION("PackedUnpack: width "s + to_string(width) + ": UnpackBlock"s);
+
+            for (size_t block = 0; block < blocks; ++block)
+            {
+                PackedBits::UnpackBlock(words.data() + block * block_words, width, out.data());
+                block_sum += out[block % PackedBits::kBlockSize];
+            }
+        }
+
+        cerr << "PackedUnpack: width "s << width << ": sums equal = "s << (stream_sum == block_sum) << endl;
+    }
+}
+
+// Степень сжатия и скорость сканирования на типичных распределениях идентификаторов
+inline void BenchmarkPackedVector(size_t count)
+{
+    mt19937_64 generator(42);
+
+    SimpleVector<uint64_t> small_values;
+    SimpleVector<uint64_t> clustered_values;
+    SimpleVector<uint64_t> sorted_ids;
+    small_values.reserve(count);
+    clustered_values.reserve(count);
+    sorted_ids.reserve(count);
+
+    uint64_t current_id = 1'000'000;
+    for (size_t i = 0; i < count; ++i)
+    {
+        // Малые значения, идентификаторы вокруг медленно растущей базы и отсортированные идентификаторы с редкими пропусками
+        small_values.push_back(generator() % 1000);
+        clustered_values.push_back(5'000'000'000ull + i / 64 + generator() % 4096);
+        current_id += 1 + generator() % 16;
+        sorted_ids.push_back(current_id);
+    }
+
+    BenchmarkPackedScan<BitPackedVector>("bit-packed small values"s, small_values);
+    BenchmarkPackedScan<FrameOfReferenceVector>("frame-of-reference clustered ids"s, clustered_values);
+    BenchmarkPackedScan<DeltaVector>("delta sorted ids"s, sorted_ids);
+}
+
+// Построение и поиск: FlatSet/FlatMap против узловых std::set/std::map
+inline void BenchmarkFlatContainers(size_t count, size_t lookups)
+{
+    mt19937_64 generator(42);
+
+    SimpleVector<uint64_t> keys;
+    keys.reserve(count);
+    for (size_t i = 0; i < count; ++i)
+    {
+        keys.push_back(generator() % (count * 4));
+    }
+
+    SimpleVector<uint64_t> queries;
+    queries.reserve(lookups);
+    for (size_t i = 0; i < lookups; ++i)
+    {
+        queries.push_back(generator() % (count * 4));
+    }
+
+    std::set<uint64_t> node_set;
+    std::map<uint64_t, uint64_t> node_map;
+    {
+        LOG_DURATION("FlatContainers: std::set + std::map build"s);
+
+        for (uint64_t key : keys)
+        {
+            node_set.insert(key);
+            node_map.emplace(key, key);
+        }
+    }
+
+    FlatSet<uint64_t> flat_set;
+    FlatMap<uint64_t, uint64_t> flat_map;
+    {
+        LOG_DURATION("FlatContainers: FlatSet + FlatMap bulk build"s);
+
+        SimpleVector<pair<uint64_t, uint64_t>> pairs;
+        pairs.reserve(keys.get_size());
+        for (uint64_t key : keys)
+        {
+            pairs.push_back({ key, key });
+        }
+
+        flat_set = FlatSet<uint64_t>(keys);
+        flat_map = FlatMap<uint64_t, uint64_t>(move(pairs));
+    }
+
+    size_t set_hits = 0;
+    {
+        LOG_DURATION("FlatContainers: std::set find"s);
+
+        for (uint64_t query : queries)
+        {
+            set_hits += node_set.count(query);
+        }
+    }
+
+    size_t flat_set_hits = 0;
+    {
+        LOG_DURATION("FlatContainers: FlatSet find"s);
+
+        for (uint64_t query : queries)
+        {
+            flat_set_hits += flat_set.count(query);
+        }
+    }
+
+    uint64_t map_sum = 0;
+    {
+        LOG_DURATION("FlatContainers: std::map find"s);
+
+        for (uint64_t query : queries)
+        {
+            const auto it = node_map.find(query);
+            map_sum += it != node_map.end() ? it->second : 0;
+        }
+    }
+
+    uint64_t flat_map_sum = 0;
+    {
+        LOG_DURATION("FlatContainers: FlatMap find"s);
+
+        for (uint64_t query : queries)
+        {
+            const auto it = flat_map.find(query);
+            flat_map_sum += it != flat_map.end() ? it->second : 0;
+        }
+    }
+
+    cerr << "FlatContainers: keys = "s << count << ", results equal = "s
+         << (set_hits == flat_set_hits && map_sum == flat_map_sum) << endl;
+}
+
+// Вставка, успешный и неуспешный поиск, удаление: FlatHashMap против std::unordered_map.
+// Малые таблицы прогоняются несколько раз, чтобы общее число операций не зависело от размера
+template <typename Map>
+inline void BenchmarkHashMapOperations(const string& name, const SimpleVector<uint64_t>& keys, const SimpleVector<uint64_t>& misses, size_t rounds)
+{
+    uint64_t checksum = 0;
+    const string prefix = "HashMap: "s + name + " size "s + to_string(keys.get_size()) + ": "s;
+
+    SimpleVector<Map> maps(rounds);
+    {
+        LOG_DURATION(prefix + "insert"s);
+
+        for (Map& map : maps)
+        {
+            for (uint64_t key : keys)
+            {
+                map[key] = key;
+            }
+        }
+    }
+    {
+        LOG_DURATION(prefix + "find hit"s);
+
+        for (const Map& map : maps)
+        {
+            for (uint64_t key : keys)
+            {
+                checksum += map.find(key)->second;
+            }
+        }
+    }
+    {
+        LOG_DURATION(prefix + "find miss"s);
+
+        for (const Map& map : maps)
+        {
+            for (uint64_t key : misses)
+            {
+                checksum += map.find(key) == map.end() ? 0 : 1;
+            }
+        }
+    }
+    {
+        LOG_DURATION(prefix + "erase"s);
+
+        for (Map& map : maps)
+        {
+            for (uint64_t key : keys)
+            {
+                checksum += map.erase(key);
+            }
+        }
+    }
+
+    cerr << prefix << "checksum = "s << checksum << endl;
+}
+
+inline void BenchmarkFlatHashMap(size_t operations)
+{
+    mt19937_64 generator(42);
+
+    for (size_t count = 1'000; count <= operations; count *= 10)
+    {
+        SimpleVector<uint64_t> keys;
+        SimpleVector<uint64_t> misses;
+        keys.reserve(count);
+        misses.reserve(count);
+
+        // Четные ключи вставляются, нечетные гарантированно отсутствуют
+        for (size_t i = 0; i < count; ++i)
+        {
+            keys.push_back(generator() & ~uint64_t(1));
+            misses.push_back(generator() | 1);
+        }
+
+        const size_t rounds = operations / count;
+        BenchmarkHashMapOperations<std::unordered_map<uint64_t, uint64_t>>("std::unordered_map"s, keys, misses, rounds);
+        BenchmarkHashMapOperations<FlatHashMap<uint64_t, uint64_t>>("FlatHashMap"s, keys, misses, rounds);
+    }
+}
+
+// Очередь FIFO постоянной длины: RingBuffer против SimpleVector с erase(begin())
+inline void BenchmarkRingBuffer(size_t queue_length, size_t operations)
+{
+    uint64_t vector_sum = 0;
+    {
+        LOG_DURATION("RingBuffer: SimpleVector erase-front FIFO"s);
+
+        SimpleVector<uint64_t> queue;
+        for (size_t i = 0; i < queue_length; ++i)
+        {
+            queue.push_back(i);
+        }
+        for (size_t i = 0; i < operations; ++i)
+        {
+            vector_sum += queue.front();
+            queue.erase(queue.begin());
+            queue.push_back(i);
+        }
+    }
+
+    uint64_t ring_sum = 0;
+    {
+        LOG_DURATION("RingBuffer: RingBuffer FIFO"s);
+
+        RingBuffer<uint64_t> queue;
+        for (size_t i = 0; i < queue_length; ++i)
+        {
+            queue.push_back(i);
+        }
+        for (size_t i = 0; i < operations; ++i)
+        {
+            ring_sum += queue.front();
+            queue.pop_front();
+            queue.push_back(i);
+        }
+    }
+
+    cerr << "RingBuffer: queue length = "s << queue_length << ", sums equal = "s << (vector_sum == ring_sum) << endl;
+}
+
+// Очередь под мьютексом, которой передают задания сейчас: базовая линия для сравнения
+template <typename Type>
+class MutexQueue
+{
+public:
+
+    explicit MutexQueue(size_t capacity) : capacity(capacity) {}
+
+    bool try_push(Type&& item)
+    {
+        lock_guard guard(items_mutex);
+        if (items.get_size() == capacity)
+        {
+            return false;
+        }
+        items.push_back(move(item));
+        return true;
+    }
+
+    bool try_pop(Type& item)
+    {
+        lock_guard guard(items_mutex);
+        if (items.is_empty())
+        {
+            return false;
+        }
+        item = move(items.front());
+        items.pop_front();
+        return true;
+    }
+
+private:
+
+    size_t capacity;
+    std::mutex items_mutex;
+    RingBuffer<Type> items;
+};
+
+// Пропускная способность: pairs производителей и столько же потребителей передают items_per_producer значений каждый
+template <typename Queue, bool Batched = false>
+inline void BenchmarkQueueThroughput(const string& name, size_t pairs, size_t items_per_producer)
+{
+    constexpr size_t kBatch = 32;
+
+    Queue queue(1024);
+    atomic<size_t> consumed{ 0 };
+    atomic<uint64_t> sum{ 0 };
+    const size_t total = pairs * items_per_producer;
+
+    {
+        LOG_DURATION("ConcurrentQueue: "s + name + " x"s + to_string(pairs) + " pairs"s);
+
+        SimpleVector<thread> threads;
+        for (size_t p = 0; p < pairs; ++p)
+        {
+            threads.push_back(thread([&]
+                {
+                    uint64_t batch[kBatch];
+                    for (size_t i = 0; i < items_per_producer;)
+                    {
+                        if constexpr (Batched)
+                        {
+                            const size_t n = std::min(kBatch, items_per_producer - i);
+                            for (size_t j = 0; j < n; ++j)
+                            {
+                                batch[j] = i + j;
+                            }
+                            i += queue.try_push_n(batch, n);
+                        }
+                        else
+                        {
+                            uint64_t value = i;
+                            i += queue.try_push(move(value)) ? 1 : 0;
+                        }
+                    }
+                }));
+
+            threads.push_back(thread([&]
+                {
+                    SimpleVector<uint64_t> out;
+                    uint64_t value = 0;
+                    uint64_t local = 0;
+
+                    while (consumed.load(memory_order_relaxed) < total)
+                    {
+                        if constexpr (Batched)
+                        {
+                            out.clear();
+                            const size_t n = queue.try_pop_n(out, kBatch);
+                            for (uint64_t item : out)
+                            {
+                                local += item;
+                            }
+                            consumed.fetch_add(n, memory_order_relaxed);
+                        }
+                        else if (queue.try_pop(value))
+                        {
+                            local += value;
+                            consumed.fetch_add(1, memory_order_relaxed);
+                        }
+                    }
+                    sum += local;
+                }));
+        }
+
+        for (thread& worker : threads)
+        {
+            worker.join();
+        }
+    }
+
+    cerr << "ConcurrentQueue: "s << name << " checksum = "s << sum.load() << endl;
+}
+
+// Задержка: время полного круга значения между двумя потоками через пару очередей
+template <typename Queue>
+inline void BenchmarkQueueLatency(const string& name, size_t round_trips)
+{
+    Queue forward(64);
+    Queue backward(64);
+
+    const auto start = chrono::steady_clock::now();
+
+    thread echo([&]
+        {
+            uint64_t value = 0;
+            for (size_t i = 0; i < round_trips; ++i)
+            {
+                while (!forward.try_pop(value))
+                {
+                }
+                while (!backward.try_push(move(value)))
+                {
+                }
+            }
+        });
+
+    uint64_t value = 0;
+    for (size_t i = 0; i < round_trips; ++i)
+    {
+        uint64_t sent = i;
+        while (!forward.try_push(move(sent)))
+        {
+        }
+        while (!backward.try_pop(value))
+        {
+        }
+    }
+    echo.join();
+
+    const auto elapsed = chrono::duration_cast<chrono::nanoseconds>(chrono::steady_clock::now() - start);
+    cerr << "ConcurrentQueue: "s << name << " round trip = "s << elapsed.count() / round_trips << " ns"s << endl;
+}
+
+inline void BenchmarkConcurrentQueues(size_t items_per_producer)
+{
+    BenchmarkQueueThroughput<MutexQueue<uint64_t>>("mutex + RingBuffer"s, 1, items_per_producer);
+    BenchmarkQueueThroughput<SpscQueue<uint64_t>>("SpscQueue"s, 1, items_per_producer);
+    BenchmarkQueueThroughput<SpscQueue<uint64_t>, true>("SpscQueue batched"s, 1, items_per_producer);
+
+    for (size_t pairs : { 1, 2, 4 })
+    {
+        BenchmarkQueueThroughput<MutexQueue<uint64_t>>("mutex + RingBuffer"s, pairs, items_per_producer);
+        BenchmarkQueueThroughput<MpmcQueue<uint64_t>>("MpmcQueue"s, pairs, items_per_producer);
+        BenchmarkQueueThroughput<MpmcQueue<uint64_t>, true>("MpmcQueue batched"s, pairs, items_per_producer);
+    }
+
+    BenchmarkQueueLatency<MutexQueue<uint64_t>>("mutex + RingBuffer"s, 100'000);
+    BenchmarkQueueLatency<SpscQueue<uint64_t>>("SpscQueue"s, 100'000);
+    BenchmarkQueueLatency<MpmcQueue<uint64_t>>("MpmcQueue"s, 100'000);
+}
+
+// Вставки в середину: случайные позиции и правки возле курсора, который смещается на несколько элементов
+template <typename Container, typename Insert>
+inline uint64_t BenchmarkMiddleInsertCase(const string& name, size_t base_size, const SimpleVector<size_t>& positions, Insert insert)
+{
+    Container container;
+    for (size_t i = 0; i < base_size; ++i)
+    {
+        container.push_back(i);
+    }
+
+    {
+        LOG_DURATION(name);
+
+        for (size_t i = 0; i < positions.get_size(); ++i)
+        {
+            insert(container, positions[i], i);
+        }
+    }
+
+    uint64_t sum = 0;
+    for (size_t i = 0; i < container.get_size(); i += 997)
+    {
+        sum += container[i] * i;
+    }
+    return sum;
+}
+
+inline void BenchmarkMiddleInsert(size_t base_size, size_t random_inserts, size_t cursor_inserts)
+{
+    const auto vector_insert = [](SimpleVector<uint64_t>& container, size_t index, uint64_t value)
+    {
+        container.insert(container.begin() + index, value);
+    };
+    const auto index_insert = [](auto& container, size_t index, uint64_t value)
+    {
+        container.insert(index, value);
+    };
+
+    mt19937_64 generator(33);
+
+    SimpleVector<size_t> random_positions(random_inserts);
+    for (size_t i = 0; i < random_inserts; ++i)
+    {
+        random_positions[i] = generator() % (base_size + i + 1);
+    }
+
+    SimpleVector<size_t> cursor_positions(cursor_inserts);
+    size_t cursor = base_size / 2;
+    for (size_t i = 0; i < cursor_inserts; ++i)
+    {
+        cursor = min(cursor + generator() % 16, base_size + i) - min<size_t>(cursor, generator() % 8);
+        cursor_positions[i] = cursor;
+    }
+
+    const uint64_t random_vector = BenchmarkMiddleInsertCase<SimpleVector<uint64_t>>("MiddleInsert: SimpleVector random"s, base_size, random_positions, vector_insert);
+    const uint64_t random_gap = BenchmarkMiddleInsertCase<GapBuffer<uint64_t>>("MiddleInsert: GapBuffer random"s, base_size, random_positions, index_insert);
+    const uint64_t random_tiered = BenchmarkMiddleInsertCase<TieredVector<uint64_t>>("MiddleInsert: TieredVector random"s, base_size, random_positions, index_insert);
+
+    const uint64_t cursor_vector = BenchmarkMiddleInsertCase<SimpleVector<uint64_t>>("MiddleInsert: SimpleVector cursor"s, base_size, cursor_positions, vector_insert);
+    const uint64_t cursor_gap = BenchmarkMiddleInsertCase<GapBuffer<uint64_t>>("MiddleInsert: GapBuffer cursor"s, base_size, cursor_positions, index_insert);
+    const uint64_t cursor_tiered = BenchmarkMiddleInsertCase<TieredVector<uint64_t>>("MiddleInsert: TieredVector cursor"s, base_size, cursor_positions, index_insert);
+
+    cerr << "MiddleInsert: base = "s << base_size << ", results equal = "s
+        << (random_vector == random_gap && random_vector == random_tiered && cursor_vector == cursor_gap && cursor_vector == cursor_tiered) << endl;
+}
+
+// Короткоживущие буферы с известной верхней границей: создание, заполнение, чтение и уничтожение
+inline void BenchmarkStaticVector(size_t cycles)
+{
+    constexpr size_t kBufferSize = 64;
+
+    uint64_t simple_sum = 0;
+    {
+        LOG_DURATION("StaticVector: SimpleVector with reserve"s);
+
+        for (size_t cycle = 0; cycle < cycles; ++cycle)
+        {
+            SimpleVector<uint64_t> buffer(::reserve(kBufferSize));
+            for (size_t i = 0; i < kBufferSize; ++i)
+            {
+                buffer.push_back(cycle ^ i);
+            }
+            for (uint64_t value : buffer)
+            {
+                simple_sum += value;
+            }
+        }
+    }
+
+    uint64_t static_sum = 0;
+    {
+        LOG_DURATION("StaticVector: StaticVector"s);
+
+        for (size_t cycle = 0; cycle < cycles; ++cycle)
+        {
+            StaticVector<uint64_t, kBufferSize> buffer;
+            for (size_t i = 0; i < kBufferSize; ++i)
+            {
+                buffer.push_back(cycle ^ i);
+            }
+            for (uint64_t value : buffer)
+            {
+                static_sum += value;
+            }
+        }
+    }
+
+    cerr << "StaticVector: cycles = "s << cycles << ", sums equal = "s << (simple_sum == static_sum) << endl;
+}
+
+// c = a * k + b и маска |c| > порога: поэлементные циклы с промежуточными векторами против слитого выражения
+inline void BenchmarkVectorExpression(size_t size, size_t repeats)
+{
+    SimpleVector<double> a(size);
+    SimpleVector<double> b(size);
+    for (size_t i = 0; i < size; ++i)
+    {
+        a[i] = static_cast<double>(i % 1024) * 0.25;
+        b[i] = static_cast<double>(i % 77) - 38.0;
+    }
+    const double k = 1.5;
+
+    SimpleVector<double> naive(size);
+    {
+        LOG_DURATION("VectorExpression: naive loops with temporaries"s);
+
+        for (size_t repeat = 0; repeat < repeats; ++repeat)
+        {
+            SimpleVector<double> scaled(size);
+            for (size_t i = 0; i < size; ++i)
+            {
+                scaled[i] = a[i] * k;
+            }
+            SimpleVector<double> sum(size);
+            for (size_t i = 0; i < size; ++i)
+            {
+                sum[i] = scaled[i] + b[i];
+            }
+            SimpleVector<double> magnitude(size);
+            for (size_t i = 0; i < size; ++i)
+            {
+                magnitude[i] = sum[i] < 0.0 ? -sum[i] : sum[i];
+            }
+            for (size_t i = 0; i < size; ++i)
+            {
+                naive[i] = magnitude[i] / 2.0;
+            }
+        }
+    }
+
+    SimpleVector<double> fused(size);
+    {
+        LOG_DURATION("VectorExpression: fused expression"s);
+
+        for (size_t repeat = 0; repeat < repeats; ++repeat)
+        {
+            fused = abs(a * k + b) / 2.0;
+        }
+    }
+
+    SimpleVector<double> threaded(size);
+    {
+        LOG_DURATION("VectorExpression: fused parallel expression"s);
+
+        for (size_t repeat = 0; repeat < repeats; ++repeat)
+        {
+            threaded = parallel(abs(a * k + b) / 2.0);
+        }
+    }
+
+    cerr << "VectorExpression: size = "s << size << ", threads = "s << thread::hardware_concurrency()
+        << ", results equal = "s << (naive == fused && fused == threaded) << endl;
+}
+
+// filter -> transform -> filter -> transform: промежуточный SimpleVector после каждой стадии против ленивого конвейера
+inline void BenchmarkRangePipeline(size_t size)
+{
+    SimpleVector<uint64_t> source(size);
+    for (size_t i = 0; i < size; ++i)
+    {
+        source[i] = i * 2654435761u % 1'000'003;
+    }
+
+    const auto is_odd = [](uint64_t value) { return value % 2 == 1; };
+    const auto scale = [](uint64_t value) { return value * 3 + 1; };
+    const auto is_small = [](uint64_t value) { return value < 2'000'000; };
+    const auto halve = [](uint64_t value) { return value / 2; };
+
+    SimpleVector<uint64_t> eager;
+    {
+        LOG_DURATION("RangePipeline: eager stages"s);
+
+        SimpleVector<uint64_t> odd;
+        for (uint64_t value : source)
+        {
+            if (is_odd(value))
+            {
+                odd.push_back(value);
+            }
+        }
+        SimpleVector<uint64_t> scaled;
+        for (uint64_t value : odd)
+        {
+            scaled.push_back(scale(value));
+        }
+        SimpleVector<uint64_t> small;
+        for (uint64_t value : scaled)
+        {
+            if (is_small(value))
+            {
+                small.push_back(value);
+            }
+        }
+        for (uint64_t value : small)
+        {
+            eager.push_back(halve(value));
+        }
+    }
+
+    SimpleVector<uint64_t> lazy;
+    {
+        LOG_DURATION("RangePipeline: lazy pipeline"s);
+
+        lazy = source | filter(is_odd) | transform(scale) | filter(is_small) | transform(halve) | collect();
+    }
+
+    cerr << "RangePipeline: size = "s << size << ", results equal = "s << (eager == lazy) << endl;
+}
+
+struct SortRecord
+{
+    uint64_t key = 0;
+    uint64_t payload = 0;
+
+    bool operator==(const SortRecord&) const = default;
+};
+
+template <typename Type, typename Sort>
+inline bool BenchmarkSortCase(const string& name, const SimpleVector<Type>& source, const SimpleVector<Type>& expected, Sort sort)
+{
+    SimpleVector<Type> vector = source;
+    {
+        LOG_DURATION(name);
+        sort(vector);
+    }
+    return vector == expected;
+}
+
+// std::sort в одном потоке против поразрядной и параллельной сортировок
+inline void BenchmarkSort(size_t size)
+{
+    mt19937_64 generator(39);
+
+    SimpleVector<uint64_t> keys(size);
+    SimpleVector<SortRecord> records(size);
+    for (size_t i = 0; i < size; ++i)
+    {
+        keys[i] = generator();
+        records[i] = { generator() % (size / 4 + 1), i };
+    }
+
+    const auto by_key = [](const SortRecord& lhs, const SortRecord& rhs) { return lhs.key < rhs.key; };
+
+    SimpleVector<uint64_t> sorted_keys = keys;
+    {
+        LOG_DURATION("Sort: uint64 std::sort"s);
+        sort(sorted_keys.begin(), sorted_keys.end());
+    }
+    const bool keys_radix = BenchmarkSortCase("Sort: uint64 radix_sort"s, keys, sorted_keys, [](auto& vector) { radix_sort(vector); });
+    const bool keys_parallel = BenchmarkSortCase("Sort: uint64 parallel_sort"s, keys, sorted_keys, [](auto& vector) { parallel_sort(vector); });
+
+    SimpleVector<SortRecord> sorted_records = records;
+    {
+        LOG_DURATION("Sort: records std::stable_sort"s);
+        stable_sort(sorted_records.begin(), sorted_records.end(), by_key);
+    }
+    const bool records_radix = BenchmarkSortCase("Sort: records radix_sort"s, records, sorted_records,
+        [](auto& vector) { radix_sort(vector, [](const SortRecord& record) { return record.key; }); });
+    const bool records_parallel = BenchmarkSortCase("Sort: records parallel_stable_sort"s, records, sorted_records,
+        [&by_key](auto& vector) { parallel_stable_sort(vector, by_key); });
+
+    cerr << "Sort: size = "s << size << ", threads = "s << thread::hardware_concurrency() << ", results equal = "s
+        << (keys_radix && keys_parallel && records_radix && records_parallel) << endl;
+}
+
+// Суммирование с хешированием каждого элемента: последовательный цикл против parallel_for на пулах разного размера
+inline void BenchmarkParallelFor(size_t size)
+{
+    SimpleVector<uint32_t> values(size);
+    for (size_t i = 0; i < size; ++i)
+    {
+        values[i] = static_cast<uint32_t>(i);
+    }
+
+    const auto mix = [](uint64_t value)
+    {
+        value ^= value >> 33;
+        value *= 0xff51afd7ed558ccdull;
+        value ^= value >> 33;
+        return value & 0xFFFF;
+    };
+
+    uint64_t expected = 0;
+    {
+        LOG_DURATION("ParallelFor: sequential loop"s);
+
+        for (size_t i = 0; i < size; ++i)
+        {
+            expected += mix(values[i]);
+        }
+    }
+
+    bool equal = true;
+    const size_t max_threads = std::max<size_t>(4, thread::hardware_concurrency());
+    for (size_t thread_count = 1; thread_count <= max_threads; thread_count *= 2)
+    {
+        ThreadPool pool(thread_count);
+        std::atomic<uint64_t> sum = 0;
+        {
+            LOG_DURATION("ParallelFor: "s + to_string(thread_count) + " threads"s);
+
+            parallel_for(0, size, [&](size_t first, size_t last)
+                {
+                    uint64_t partial = 0;
+                    for (size_t i = first; i < last; ++i)
+                    {
+                        partial += mix(values[i]);
+                    }
+                    sum.fetch_add(partial, std::memory_order_relaxed);
+                }, 0, pool);
+        }
+        equal = equal && sum == expected;
+    }
+
+    cerr << "ParallelFor: size = "s << size << ", cores = "s << thread::hardware_concurrency() << ", results equal = "s << equal << endl;
+}
+
+// Удаление половины элементов: цикл erase(pos) против однопроходного сжатия.
+// Цикл erase квадратичен, поэтому проверяется на префиксе размером erase_loop_size
+inline void BenchmarkErase(size_t size, size_t erase_loop_size)
+{
+    SimpleVector<int> source(size);
+    std::mt19937 generator(41);
+    for (int& value : source)
+    {
+        value = static_cast<int>(generator());
+    }
+    const auto is_odd = [](int value) { return (value & 1) != 0; };
+
+    SimpleVector<int> looped = source.subvector(0, erase_loop_size);
+    SimpleVector<int> looped_expected = looped;
+    {
+        LOG_DURATION("Erase: erase(pos) loop on "s + to_string(erase_loop_size) + " elements"s);
+
+        for (auto it = looped.begin(); it != looped.end();)
+        {
+            it = is_odd(*it) ? looped.erase(it) : it + 1;
+        }
+    }
+    erase_if(looped_expected, is_odd);
+
+    SimpleVector<int> compacted = source;
+    {
+        LOG_DURATION("Erase: erase_if"s);
+
+        erase_if(compacted, is_odd);
+    }
+
+    SimpleVector<int> removed = source;
+    {
+        LOG_DURATION("Erase: std::remove_if"s);
+
+        removed.resize(std::remove_if(removed.begin(), removed.end(), is_odd) - removed.begin());
+    }
+
+    SimpleVector<int> parallel = source;
+    {
+        LOG_DURATION("Erase: parallel_erase_if"s);
+
+        parallel_erase_if(parallel, is_odd);
+    }
+
+    cerr << "Erase: size = "s << size << ", kept = "s << compacted.get_size()
+        << ", results equal = "s << (looped == looped_expected && compacted == removed && compacted == parallel) << endl;
+}
+
+// Всплески нагрузки: вектор вырастает до burst_size элементов и сжимается до остатка.
+// Резидентная память замеряется после каждого сжатия без политики, с отдачей страниц и с перевыделением
+inline void BenchmarkShrinkPolicy(size_t burst_size, size_t bursts)
+{
+    const auto run = [burst_size, bursts](const string& name, const ShrinkPolicy& policy)
+    {
+        SimpleVector<uint64_t> vector;
+        vector.set_shrink_policy(policy);
+
+        size_t peak = 0;
+        size_t idle = 0;
+        {
+            LOG_DURATION("ShrinkPolicy: "s + name);
+
+            for (size_t burst = 0; burst < bursts; ++burst)
+            {
+                for (size_t i = 0; i < burst_size; ++i)
+                {
+                    vector.push_back(i);
+                }
+                peak = std::max(peak, GetResidentMemory());
+
+                while (vector.get_size() > burst_size / 1000)
+                {
+                    vector.pop_back();
+                }
+                idle = std::max(idle, GetResidentMemory());
+            }
+        }
+
+        cerr << "ShrinkPolicy: "s << name << ": peak RSS = "s << (peak >> 20) << " MB, RSS between bursts = "s << (idle >> 20)
+            << " MB, capacity = "s << vector.get_capacity() << endl;
+        vector.clear();
+        vector.shrink_to_fit();
+    };
+
+    run("no policy"s, ShrinkPolicy{});
+    run("page release"s, ShrinkPolicy{ .patience = 64 });
+    run("reallocation"s, ShrinkPolicy{ .patience = 64, .release_pages = false });
+}
+
+// Проход по вектору через итераторы и через указатель на данные. В сборке без проверок итератор - указатель,
+// и время должно совпадать; со SIMPLE_VECTOR_CHECKED_ITERATORS видна цена проверок
+inline void BenchmarkCheckedIterators(size_t size, size_t repeats)
+{
+    SimpleVector<uint32_t> values(size);
+    for (size_t i = 0; i < size; ++i)
+    {
+        values[i] = static_cast<uint32_t>(i * 2654435761u);
+    }
+
+    uint64_t raw_sum = 0;
+    {
+        LOG_DURATION("CheckedIterators: raw pointer loop"s);
+
+        for (size_t repeat = 0; repeat < repeats; ++repeat)
+        {
+            const uint32_t* first = values.data();
+            const uint32_t* last = first + values.get_size();
+            for (; first != last; ++first)
+            {
+                raw_sum += *first >> 3;
+            }
+        }
+    }
+
+    uint64_t iterator_sum = 0;
+    {
+        LOG_DURATION("CheckedIterators: iterator loop"s);
+
+        for (size_t repeat = 0; repeat < repeats; ++repeat)
+        {
+            for (auto it = values.begin(); it != values.end(); ++it)
+            {
+                iterator_sum += *it >> 3;
+            }
+        }
+    }
+
+    uint64_t algorithm_sum = 0;
+    {
+        LOG_DURATION("CheckedIterators: std::accumulate"s);
+
+        for (size_t repeat = 0; repeat < repeats; ++repeat)
+        {
+            algorithm_sum = std::accumulate(values.begin(), values.end(), algorithm_sum, [](uint64_t sum, uint32_t value) { return sum + (value >> 3); });
+        }
+    }
+
+    cerr << "CheckedIterators: checked = "s << SIMPLE_VECTOR_CHECKED_ITERATORS << ", sizeof(Iterator) = "s << sizeof(SimpleVector<uint32_t>::Iterator)
+        << ", results equal = "s << (raw_sum == iterator_sum && iterator_sum == algorithm_sum) << endl;
+}
+
+// Строка с перемещением без noexcept: при перевыделении такие элементы копируются ради строгой гарантии
+struct ThrowingMoveString
+{
+    string value;
+
+    explicit ThrowingMoveString(string value) : value(std::move(value)) {}
+    ThrowingMoveString(const ThrowingMoveString& other) = default;
+    ThrowingMoveString(ThrowingMoveString&& other) noexcept(false) : value(std::move(other.value)) {}
+};
+
+// Заполняет вектор size элементами через push_back без резервирования и возвращает сумму длин для сверки
+template <typename Vector, typename MakeValue>
+inline size_t BenchmarkGrowth(const string& name, size_t size, MakeValue make_value)
+{
+    LOG_DURATION("StrongGuarantee: "s + name);
+
+    Vector vector;
+    for (size_t i = 0; i < size; ++i)
+    {
+        vector.push_back(make_value(i));
+    }
+
+    size_t checksum = 0;
+    for (const auto& item : vector)
+    {
+        if constexpr (is_arithmetic_v<std::remove_cvref_t<decltype(item)>>)
+        {
+            checksum += static_cast<size_t>(item);
+        }
+        else if constexpr (is_same_v<std::remove_cvref_t<decltype(item)>, string>)
+        {
+            checksum += item.size();
+        }
+        else
+        {
+            checksum += item.value.size();
+        }
+    }
+    return checksum;
+}
+
+// Стоимость строгой гарантии при росте: для тривиальных типов перенос - memcpy, для строк - перемещение,
+// и SimpleVector не должен уступать std::vector. Для типа с бросающим перемещением оба вектора копируют элементы
+inline void BenchmarkStrongGuarantee(size_t size, size_t string_size)
+{
+    const auto make_int = [](size_t i) { return static_cast<int>(i); };
+    const auto make_string = [](size_t i) { return string(32, static_cast<char>('a' + i % 26)); };
+    const auto make_throwing = [&make_string](size_t i) { return ThrowingMoveString(make_string(i)); };
+
+    const size_t simple_int = BenchmarkGrowth<SimpleVector<int>>("SimpleVector<int>"s, size, make_int);
+    const size_t std_int = BenchmarkGrowth<vector<int>>("std::vector<int>"s, size, make_int);
+    const size_t simple_string = BenchmarkGrowth<SimpleVector<string>>("SimpleVector<string>"s, string_size, make_string);
+    const size_t std_string = BenchmarkGrowth<vector<string>>("std::vector<string>"s, string_size, make_string);
+    const size_t simple_throwing = BenchmarkGrowth<SimpleVector<ThrowingMoveString>>("SimpleVector<ThrowingMoveString>"s, string_size, make_throwing);
+    const size_t std_throwing = BenchmarkGrowth<vector<ThrowingMoveString>>("std::vector<ThrowingMoveString>"s, string_size, make_throwing);
+
+    cerr << "StrongGuarantee: results equal = "s
+        << (simple_int == std_int && simple_string == std_string && simple_throwing == std_throwing && simple_string == simple_throwing) << endl;
+}
+
+// Цикл добавления в вектор, который очищается каждые chunk элементов и потому остается в кэше:
+// время определяется кодом самого push_back. Размер кода горячего цикла проверяется дизассемблером
+// (objdump -d --no-show-raw-insn): медленный путь должен остаться отдельной функцией EmplaceBackSlow
+template <typename Vector, typename Push>
+inline uint64_t BenchmarkPushLoop(const string& name, size_t count, size_t chunk, Push push)
+{
+    LOG_DURATION("PushBack: "s + name);
+
+    Vector vector;
+    vector.reserve(chunk);
+    uint64_t checksum = 0;
+    for (size_t i = 0; i < count; i += chunk)
+    {
+        const uint32_t last = static_cast<uint32_t>(std::min(chunk, count - i));
+        for (uint32_t value = 0; value < last; ++value)
+        {
+            push(vector, value);
+        }
+        checksum += vector[last / 2] + vector[last - 1];
+        vector.clear();
+    }
+    return checksum;
+}
+
+// Заполняет с нуля векторы по chunk элементов, пока не добавит count, и возвращает количество добавленных
+template <typename Vector>
+inline uint64_t BenchmarkPushGrowth(const string& name, size_t count, size_t chunk)
+{
+    LOG_DURATION("PushBack: "s + name);
+
+    uint64_t total = 0;
+    for (size_t i = 0; i < count; i += chunk)
+    {
+        Vector vector;
+        const uint32_t last = static_cast<uint32_t>(std::min(chunk, count - i));
+        for (uint32_t value = 0; value < last; ++value)
+        {
+            vector.push_back(value);
+        }
+        total += static_cast<uint64_t>(std::distance(vector.begin(), vector.end()));
+    }
+    return total;
+}
+
+inline void BenchmarkPushBack(size_t count)
+{
+    constexpr size_t kChunk = size_t(1) << 14;
+
+    const uint64_t std_sum = BenchmarkPushLoop<vector<uint32_t>>("std::vector::push_back"s, count, kChunk,
+        [](vector<uint32_t>& vector, uint32_t value) { vector.push_back(value); });
+    const uint64_t push_sum = BenchmarkPushLoop<SimpleVector<uint32_t>>("push_back"s, count, kChunk,
+        [](SimpleVector<uint32_t>& vector, uint32_t value) { vector.push_back(value); });
+    const uint64_t emplace_sum = BenchmarkPushLoop<SimpleVector<uint32_t>>("emplace_back"s, count, kChunk,
+        [](SimpleVector<uint32_t>& vector, uint32_t value) { vector.emplace_back(value); });
+    const uint64_t unchecked_sum = BenchmarkPushLoop<SimpleVector<uint32_t>>("push_back_unchecked"s, count, kChunk,
+        [](SimpleVector<uint32_t>& vector, uint32_t value) { vector.push_back_unchecked(value); });
+
+    // Рост с нуля: медленный путь выполняется log2(N) раз на каждый вектор
+    const uint64_t std_growth = BenchmarkPushGrowth<vector<uint32_t>>("std::vector::push_back with growth"s, count, kChunk * 64);
+    const uint64_t growth = BenchmarkPushGrowth<SimpleVector<uint32_t>>("push_back with growth"s, count, kChunk * 64);
+
+    cerr << "PushBack: results equal = "s << (std_sum == push_sum && push_sum == emplace_sum && emplace_sum == unchecked_sum && std_growth == growth && growth == count) << endl;
+}
+
+// Сообщения разного размера для сравнения разнотипного вектора с вектором std::variant
+struct TickMessage
+{
+    uint64_t id;
+    uint32_t price;
+    uint32_t quantity;
+};
+
+struct QuoteMessage
+{
+    uint64_t id;
+    double bids[5];
+    double asks[5];
+};
+
+struct NewsMessage
+{
+    uint64_t id;
+    char text[240];
+};
+
+inline void BenchmarkHeterogeneousVector(size_t count)
+{
+    using Message = variant<TickMessage, QuoteMessage, NewsMessage>;
+
+    // 85% коротких сообщений, 12% средних и 3% длинных
+    SimpleVector<uint8_t> kinds(count);
+    mt19937 generator(48);
+    for (size_t i = 0; i < count; ++i)
+    {
+        const uint32_t roll = generator() % 100;
+        kinds[i] = roll < 85 ? 0 : roll < 97 ? 1 : 2;
+    }
+
+    const auto checksum = [](uint64_t& sum)
+    {
+        return [&sum](const auto& message)
+        {
+            sum += message.id;
+            if constexpr (is_same_v<std::remove_cvref_t<decltype(message)>, TickMessage>)
+            {
+                sum += message.price;
+            }
+        };
+    };
+
+    SimpleVector<Message> variants;
+    {
+        LOG_DURATION("HeterogeneousVector: fill SimpleVector<variant>"s);
+
+        for (size_t i = 0; i < count; ++i)
+        {
+            if (kinds[i] == 0)
+            {
+                variants.push_back(TickMessage{ i, static_cast<uint32_t>(i), 1 });
+            }
+            else if (kinds[i] == 1)
+            {
+                variants.push_back(QuoteMessage{ i, {}, {} });
+            }
+            else
+            {
+                variants.push_back(NewsMessage{ i, {} });
+            }
+        }
+    }
+
+    HeterogeneousVector<TickMessage, QuoteMessage, NewsMessage> messages;
+    {
+        LOG_DURATION("HeterogeneousVector: fill HeterogeneousVector"s);
+
+        for (size_t i = 0; i < count; ++i)
+        {
+            if (kinds[i] == 0)
+            {
+                messages.push_back(TickMessage{ i, static_cast<uint32_t>(i), 1 });
+            }
+            else if (kinds[i] == 1)
+            {
+                messages.push_back(QuoteMessage{ i, {}, {} });
+            }
+            else
+            {
+                messages.push_back(NewsMessage{ i, {} });
+            }
+        }
+    }
+
+    uint64_t variant_sum = 0;
+    {
+        LOG_DURATION("HeterogeneousVector: visit SimpleVector<variant>"s);
+
+        for (const Message& message : variants)
+        {
+            std::visit(checksum(variant_sum), message);
+        }
+    }
+
+    uint64_t for_each_sum = 0;
+    {
+        LOG_DURATION("HeterogeneousVector: for_each"s);
+
+        messages.for_each(checksum(for_each_sum));
+    }
+
+    uint64_t index_sum = 0;
+    {
+        LOG_DURATION("HeterogeneousVector: visit by index"s);
+
+        for (size_t i = 0; i < messages.get_size(); ++i)
+        {
+            messages.visit(i, checksum(index_sum));
+        }
+    }
+
+    cerr << "HeterogeneousVector: SimpleVector<variant> "s << variants.get_capacity() * sizeof(Message) / (1 << 20) << " MB, HeterogeneousVector "s
+        << messages.get_memory_usage() / (1 << 20) << " MB, results equal = "s << (variant_sum == for_each_sum && for_each_sum == index_sum) << endl;
+}
+
+// Суммы по строкам и по столбцам для вектора векторов и NdVector. Каждый проход - отдельная функция,
+// чтобы компилятор оптимизировал его независимо от остального кода замера
+inline double SumNestedRows(const SimpleVector<SimpleVector<double>>& nested)
+{
+    double sum = 0;
+    for (const SimpleVector<double>& row : nested)
+    {
+        for (const double item : row)
+        {
+            sum += item;
+        }
+    }
+    return sum;
+}
+
+inline double SumNestedColumns(const SimpleVector<SimpleVector<double>>& nested)
+{
+    double sum = 0;
+    for (size_t column = 0; column < nested[0].get_size(); ++column)
+    {
+        for (size_t row = 0; row < nested.get_size(); ++row)
+        {
+            sum += nested[row][column];
+        }
+    }
+    return sum;
+}
+
+inline double SumMatrixRows(const NdVector<double, 2>& matrix)
+{
+    double sum = 0;
+    matrix.view().for_each([&sum](double item) { sum += item; });
+    return sum;
+}
+
+inline double SumMatrixColumns(const NdVector<double, 2>& matrix)
+{
+    double sum = 0;
+    matrix.view().transposed().for_each([&sum](double item) { sum += item; });
+    return sum;
+}
+
+inline void BenchmarkNdVector(size_t size)
+{
+    SimpleVector<SimpleVector<double>> nested(size, SimpleVector<double>(size));
+    NdVector<double, 2> matrix({ size, size });
+    for (size_t row = 0; row < size; ++row)
+    {
+        for (size_t column = 0; column < size; ++column)
+        {
+            nested[row][column] = matrix(row, column) = static_cast<double>((row * 31 + column) % 1000);
+        }
+    }
+
+    double nested_rows = 0;
+    {
+        LOG_DURATION("NdVector: vector of vectors, row traversal"s);
+
+        nested_rows = SumNestedRows(nested);
+    }
+
+    double matrix_rows = 0;
+    {
+        LOG_DURATION("NdVector: NdVector, row traversal"s);
+
+        matrix_rows = SumMatrixRows(matrix);
+    }
+
+    double nested_columns = 0;
+    {
+        LOG_DURATION("NdVector: vector of vectors, column traversal"s);
+
+        nested_columns = SumNestedColumns(nested);
+    }
+
+    double matrix_columns = 0;
+    {
+        LOG_DURATION("NdVector: NdVector, column traversal"s);
+
+        matrix_columns = SumMatrixColumns(matrix);
+    }
+
+    SimpleVector<SimpleVector<double>> nested_transposed(size, SimpleVector<double>(size));
+    {
+        LOG_DURATION("NdVector: vector of vectors, transpose"s);
+
+        for (size_t row = 0; row < size; ++row)
+        {
+            for (size_t column = 0; column < size; ++column)
+            {
+                nested_transposed[column][row] = nested[row][column];
+            }
+        }
+    }
+
+    NdVector<double, 2> naive_transposed({ size, size });
+    {
+        LOG_DURATION("NdVector: NdVector, naive transpose"s);
+
+        for (size_t row = 0; row < size; ++row)
+        {
+            for (size_t column = 0; column < size; ++column)
+            {
+                naive_transposed(column, row) = matrix(row, column);
+            }
+        }
+    }
+
+    NdVector<double, 2> blocked_transposed({ size, size });
+    {
+        LOG_DURATION("NdVector: NdVector, blocked transpose"s);
+
+        transpose_into<double>(matrix.view(), blocked_transposed.view());
+    }
+
+    bool equal = nested_rows == matrix_rows && nested_columns == matrix_columns;
+    for (size_t row = 0; row < size && equal; row += 7)
+    {
+        equal = std::equal(nested_transposed[row].begin(), nested_transposed[row].end(), blocked_transposed.row(row).begin())
+            && naive_transposed.row(row) == blocked_transposed.row(row);
+    }
+    cerr << "NdVector: results equal = "s << equal << endl;
+}
+
+// Цикл "создать, заполнить, уничтожить" для векторов нескольких размеров в thread_count потоках.
+// Лимит 0 - каждый буфер выделяется и освобождается системным аллокатором, иначе буферы берутся из кэша потока.
+// Без SIMPLE_VECTOR_BUFFER_RECYCLER кэша нет, и время обоих замеров должно совпадать
+inline void BenchmarkBufferRecycler(size_t thread_count, size_t iterations)
+{
+    static constexpr size_t kSizes[] = { 8, 40, 200, 1'000 };
+
+    const auto run = [thread_count, iterations](size_t byte_limit)
+    {
+        std::atomic<uint64_t> checksum = 0;
+        std::mutex stats_mutex;
+        BufferRecyclerStats total;
+
+        SimpleVector<thread> threads;
+        threads.reserve(thread_count);
+        for (size_t t = 0; t < thread_count; ++t)
+        {
+            threads.emplace_back([&, t]()
+                {
+                    BufferRecycler& recycler = BufferRecycler::local();
+                    recycler.set_byte_limit(byte_limit);
+                    recycler.reset_stats();
+
+                    uint64_t sum = 0;
+                    for (size_t i = 0; i < iterations; ++i)
+                    {
+                        const size_t size = kSizes[(i + t) % std::size(kSizes)];
+                        SimpleVector<uint32_t> vector;
+                        for (size_t j = 0; j < size; ++j)
+                        {
+                            vector.push_back(static_cast<uint32_t>(i + j));
+                        }
+                        sum += vector[size / 2];
+                    }
+                    checksum.fetch_add(sum, std::memory_order_relaxed);
+
+                    std::lock_guard guard(stats_mutex);
+                    const BufferRecyclerStats& stats = recycler.get_stats();
+                    total.local_hits += stats.local_hits;
+                    total.shared_hits += stats.shared_hits;
+                    total.misses += stats.misses;
+                    recycler.set_byte_limit(0);
+                    recycler.release();
+                });
+        }
+        for (thread& worker : threads)
+        {
+            worker.join();
+        }
+        BufferRecycler::shared().release();
+        return std::pair{ checksum.load(), total };
+    };
+
+    pair<uint64_t, BufferRecyclerStats> plain;
+    {
+        LOG_DURATION("BufferRecycler: "s + to_string(thread_count) + " threads, system allocator"s);
+
+        plain = run(0);
+    }
+
+    pair<uint64_t, BufferRecyclerStats> recycled;
+    {
+        LOG_DURATION("BufferRecycler: "s + to_string(thread_count) + " threads, recycled buffers"s);
+
+        recycled = run(size_t(1) << 20);
+    }
+
+    cerr << "BufferRecycler: enabled = "s << SIMPLE_VECTOR_BUFFER_RECYCLER << ", hit rate = "s << recycled.second.get_hit_rate() << ", results equal = "s << (plain.first == recycled.first) << endl;
+}
+
+void BenchmarkRun()
+{
+    // В нагрузочном сценарии используется 1e8 строк, здесь размер уменьшен, чтобы уместиться в память обоих представлений
+    BenchmarkSoAVector(10'000'000);
+    BenchmarkPackedVector(10'000'000);
+    BenchmarkPackedUnpack(200'000);
+    BenchmarkFlatContainers(1'000'000, 2'000'000);
+    // В нагрузочном сценарии размеры доходят до 1e8 ключей
+    BenchmarkFlatHashMap(10'000'000);
+    BenchmarkRingBuffer(10'000, 1'000'000);
+    BenchmarkConcurrentQueues(1'000'000);
+    BenchmarkMiddleInsert(1'000'000, 10'000, 10'000);
+    BenchmarkStaticVector(1'000'000);
+    BenchmarkVectorExpression(10'000'000, 10);
+    BenchmarkRangePipeline(10'000'000);
+    // В ночной задаче сортируется 5e8 элементов
+    BenchmarkSort(10'000'000);
+    // Нагрузочный сценарий проходит 1e9 элементов, здесь 1e8, чтобы вектор занимал 400 МБ
+    BenchmarkParallelFor(100'000'000);
+    BenchmarkErase(100'000'000, 100'000);
+    BenchmarkShrinkPolicy(25'000'000, 4);
+    BenchmarkCheckedIterators(10'000'000, 10);
+    BenchmarkStrongGuarantee(100'000'000, 5'000'000);
+    BenchmarkPushBack(1'000'000'000);
+    // Вектор variant занимает 256 байт на сообщение, поэтому размер ограничен 4e6 сообщений
+    BenchmarkHeterogeneousVector(4'000'000);
+    BenchmarkNdVector(4'000);
+    BenchmarkBufferRecycler(8, 500'000);
+}
@@ -0,0 +1,732 @@
+#pragma once
+
+#include "simple_vector.h"
+
+#include <bit>
+#include <cassert>
+#include <cstdint>
+#include <iterator>
+#include <stdexcept>
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#define BIT_VECTOR_AVX2
+#elif defined(__SSE2__) || defined(_M_X64) || defined(_M_AMD64)
+#include <emmintrin.h>
+#define BIT_VECTOR_SSE2
+#endif
+
+#if defined(__AVX512F__) && defined(__AVX512VPOPCNTDQ__)
+#include <immintrin.h>
+#define BIT_VECTOR_AVX512_POPCNT
+#endif
+
+// Вектор логических значений, упакованных по 64 в слово. Биты за пределами размера всегда нулевые,
+// поэтому пословные операции и подсчет единиц не требуют маскирования хвоста.
+// И, ИЛИ, исключающее ИЛИ обрабатывают по 4 слова командами AVX2 или по 2 слова SSE2, подсчет единиц
+// при сборке с AVX-512 VPOPCNTDQ - по 8 слов; без этих расширений используются пословные циклы
+class BitVector
+{
+public:
+
+    // Значение, возвращаемое при отсутствии искомого бита
+    static constexpr size_t npos = static_cast<size_t>(-1);
+
+    // Прокси-ссылка на отдельный бит
+    class BitReference
+    {
+    public:
+
+        BitReference(BitVector& vector, size_t index) noexcept : vector(vector), index(index) {}
+
+        BitReference(const BitReference&) = default;
+
+        operator bool() const noexcept
+        {
+            return vector.test(index);
+        }
+
+        BitReference& operator=(bool value) noexcept
+        {
+            vector.set(index, value);
+            return *this;
+        }
+
+        BitReference& operator=(const BitReference& other) noexcept
+        {
+            return *this = static_cast<bool>(other);
+        }
+
+        // Инвертирование бита O(1)
+        void flip() noexcept
+        {
+            vector.flip(index);
+        }
+
+    private:
+
+        BitVector& vector;
+        size_t index;
+    };
+
+    // Константный итератор по битам
+    class ConstIterator
+    {
+    public:
+
+        using iterator_category = std::random_access_iterator_tag;
+        using value_type = bool;
+        using difference_type = std::ptrdiff_t;
+        using pointer = void;
+        using reference = bool;
+
+        ConstIterator() = default;
+
+        ConstIterator(const BitVector* vector, size_t index) noexcept : vector(vector), index(index) {}
+
+        bool operator*() const noexcept
+        {
+            return vector->test(index);
+        }
+
+        bool operator[](difference_type offset) const noexcept
+        {
+            return vector->test(index + offset);
+        }
+
+        ConstIterator& operator++() noexcept
+        {
+            ++index;
+            return *this;
+        }
+
+        ConstIterator operator++(int) noexcept
+        {
+            ConstIterator temp(*this);
+            ++index;
+            return temp;
+        }
+
+        ConstIterator& operator--() noexcept
+        {
+            --index;
+            return *this;
+        }
+
+        ConstIterator operator--(int) noexcept
+        {
+            ConstIterator temp(*this);
+            --index;
+            return temp;
+        }
+
+        ConstIterator& operator+=(difference_type offset) noexcept
+        {
+            index += offset;
+            return *this;
+        }
+
+        ConstIterator& operator-=(difference_type offset) noexcept
+        {
+            index -= offset;
+            return *this;
+        }
+
+        ConstIterator operator+(difference_type offset) const noexcept
+        {
+            return ConstIterator(vector, index + offset);
+        }
+
+        ConstIterator operator-(difference_type offset) const noexcept
+        {
+            return ConstIterator(vector, index - offset);
+        }
+
+        difference_type operator-(const ConstIterator& other) const noexcept
+        {
+            return static_cast<difference_type>(index) - static_cast<difference_type>(other.index);
+        }
+
+        bool operator==(const ConstIterator& other) const noexcept
+        {
+            return index == other.index;
+        }
+
+        bool operator!=(const ConstIterator& other) const noexcept
+        {
+            return index != other.index;
+        }
+
+        bool operator<(const ConstIterator& other) const noexcept
+        {
+            return index < other.index;
+        }
+
+        bool operator>(const ConstIterator& other) const noexcept
+        {
+            return index > other.index;
+        }
+
+        bool operator<=(const ConstIterator& other) const noexcept
+        {
+            return index <= other.index;
+        }
+
+        bool operator>=(const ConstIterator& other) const noexcept
+        {
+            return index >= other.index;
+        }
+
+        friend ConstIterator operator+(difference_type offset, const ConstIterator& iterator) noexcept
+        {
+            return iterator + offset;
+        }
+
+    private:
+
+        const BitVector* vector = nullptr;
+        size_t index = 0;
+    };
+
+//===================================================================== Конструкторы и деструктор ==========================================================
+
+    BitVector() noexcept = default;
+
+    // Создает вектор из size битов, равных value
+    explicit BitVector(size_t size, bool value = false)
+    {
+        resize(size, value);
+    }
+
+    // Создает вектор с помощью {}
+    BitVector(std::initializer_list<bool> init)
+    {
+        reserve(init.size());
+        for (bool value : init)
+        {
+            push_back(value);
+        }
+    }
+
+//================================================================ Операторы ===============================================================================
+
+    // Прокси-ссылка на бит по индексу O(1)
+    BitReference operator[](size_t index) noexcept
+    {
+        assert(index < size);
+        return BitReference(*this, index);
+    }
+
+    // Значение бита по индексу O(1)
+    bool operator[](size_t index) const noexcept
+    {
+        assert(index < size);
+        return test(index);
+    }
+
+    // Пословное И с вектором того же размера O(N / 64)
+    BitVector& operator&=(const BitVector& other)
+    {
+        CheckSameSize(other);
+        CombineWords<WordOperation::kAnd>(words.data(), other.words.data(), words.get_size());
+        rank_index.clear();
+        return *this;
+    }
+
+    // Пословное ИЛИ с вектором того же размера O(N / 64)
+    BitVector& operator|=(const BitVector& other)
+    {
+        CheckSameSize(other);
+        CombineWords<WordOperation::kOr>(words.data(), other.words.data(), words.get_size());
+        rank_index.clear();
+        return *this;
+    }
+
+    // Пословное исключающее ИЛИ с вектором того же размера O(N / 64)
+    BitVector& operator^=(const BitVector& other)
+    {
+        CheckSameSize(other);
+        CombineWords<WordOperation::kXor>(words.data(), other.words.data(), words.get_size());
+        rank_index.clear();
+        return *this;
+    }
+
+    // Инвертированная копия O(N / 64)
+    BitVector operator~() const
+    {
+        BitVector result(*this);
+        result.flip();
+        return result;
+    }
+
+//===================================================================== Итераторы ==========================================================================
+
+    ConstIterator begin() const noexcept
+    {
+        return ConstIterator(this, 0);
+    }
+
+    ConstIterator end() const noexcept
+    {
+        return ConstIterator(this, size);
+    }
+
+//===================================================================== Методы =============================================================================
+
+//------------------------------------------------------------- Заполнение и добавление --------------------------------------------------------------------
+
+    // Добавление бита в конец O(1) амортизированно
+    void push_back(bool value)
+    {
+        if (size % 64 == 0)
+        {
+            words.push_back(0);
+        }
+        ++size;
+        set(size - 1, value);
+    }
+
+    // Установка бита O(1)
+    void set(size_t index, bool value = true) noexcept
+    {
+        assert(index < size);
+
+        const uint64_t mask = uint64_t(1) << (index % 64);
+        if (value)
+        {
+            words[index / 64] |= mask;
+        }
+        else
+        {
+            words[index / 64] &= ~mask;
+        }
+        rank_index.clear();
+    }
+
+    // Сброс бита O(1)
+    void reset(size_t index) noexcept
+    {
+        set(index, false);
+    }
+
+    // Инвертирование бита O(1)
+    void flip(size_t index) noexcept
+    {
+        assert(index < size);
+
+        words[index / 64] ^= uint64_t(1) << (index % 64);
+        rank_index.clear();
+    }
+
+    // Инвертирование всех битов O(N / 64)
+    void flip() noexcept
+    {
+        for (size_t i = 0; i < words.get_size(); ++i)
+        {
+            words[i] = ~words[i];
+        }
+        ClearUnusedBits();
+        rank_index.clear();
+    }
+
+    // Установка всех битов в value O(N / 64)
+    void fill(bool value) noexcept
+    {
+        std::fill(words.begin(), words.end(), value ? ~uint64_t(0) : uint64_t(0));
+        ClearUnusedBits();
+        rank_index.clear();
+    }
+
+//-------------------------------------------------------------- Получение значений ------------------------------------------------------------------------
+
+    // Значение бита O(1)
+    bool test(size_t index) const noexcept
+    {
+        assert(index < size);
+        return (words[index / 64] >> (index % 64)) & 1;
+    }
+
+    // Значение бита с проверкой индекса O(1)
+    bool at(size_t index) const
+    {
+        if (index >= size)
+        {
+            throw std::out_of_range("Out of range");
+        }
+        return test(index);
+    }
+
+    // Количество битов O(1)
+    size_t get_size() const noexcept
+    {
+        return size;
+    }
+
+    // Проверка на пустоту O(1)
+    bool is_empty() const noexcept
+    {
+        return size == 0;
+    }
+
+    // Количество единичных битов O(N / 64)
+    size_t count() const noexcept
+    {
+        size_t result = 0;
+        size_t i = 0;
+#if defined(BIT_VECTOR_AVX512_POPCNT)
+        __m512i sums = _mm512_setzero_si512();
+        for (; i + 8 <= words.get_size(); i += 8)
+        {
+            sums = _mm512_add_epi64(sums, _mm512_popcnt_epi64(_mm512_loadu_si512(words.data() + i)));
+        }
+        result = static_cast<size_t>(_mm512_reduce_add_epi64(sums));
+#endif
+        for (; i < words.get_size(); ++i)
+        {
+            result += std::popcount(words[i]);
+        }
+        return result;
+    }
+
+    // Есть ли хотя бы один единичный бит O(N / 64)
+    bool any() const noexcept
+    {
+        return find_first() != npos;
+    }
+
+    // Все ли биты нулевые O(N / 64)
+    bool none() const noexcept
+    {
+        return !any();
+    }
+
+    // Все ли биты единичные O(N / 64)
+    bool all() const noexcept
+    {
+        return count() == size;
+    }
+
+    // Позиция первого единичного бита или npos O(N / 64)
+    size_t find_first() const noexcept
+    {
+        return FindFrom(0);
+    }
+
+    // Позиция первого единичного бита после pos или npos O(N / 64)
+    size_t find_next(size_t pos) const noexcept
+    {
+        return pos + 1 >= size ? npos : FindFrom(pos + 1);
+    }
+
+    // Количество единичных битов в диапазоне [0, pos).
+    // O(1) после build_rank_index, иначе O(pos / 64)
+    size_t rank(size_t pos) const noexcept
+    {
+        assert(pos <= size);
+
+        const size_t word = pos / 64;
+        size_t result = 0;
+        size_t first_word = 0;
+
+        if (!rank_index.is_empty())
+        {
+            result = rank_index[word / kWordsPerBlock];
+            first_word = word / kWordsPerBlock * kWordsPerBlock;
+        }
+        for (size_t i = first_word; i < word; ++i)
+        {
+            result += std::popcount(words[i]);
+        }
+        if (pos % 64 != 0)
+        {
+            result += std::popcount(words[word] & ((uint64_t(1) << (pos % 64)) - 1));
+        }
+        return result;
+    }
+
+    // Позиция единичного бита с порядковым номером k (с нуля) или npos.
+    // O(log(N)) после build_rank_index, иначе O(N / 64)
+    size_t select(size_t k) const noexcept
+    {
+        size_t block = 0;
+        if (!rank_index.is_empty())
+        {
+            // Последний блок, в начале которого единиц не больше k
+            block = std::upper_bound(rank_index.begin(), rank_index.end(), k) - rank_index.begin() - 1;
+            k -= rank_index[block];
+        }
+
+        for (size_t i = block * kWordsPerBlock; i < words.get_size(); ++i)
+        {
+            const size_t ones = std::popcount(words[i]);
+            if (k < ones)
+            {
+                return i * 64 + SelectInWord(words[i], k);
+            }
+            k -= ones;
+        }
+        return npos;
+    }
+
+//------------------------------------------------------------------- Работа с размером --------------------------------------------------------------------
+
+    // Изменить размер, новые биты равны value O(N / 64)
+    void resize(size_t new_size, bool value = false)
+    {
+        const size_t old_size = size;
+
+        while (words.get_size() < (new_size + 63) / 64)
+        {
+            words.push_back(value ? ~uint64_t(0) : uint64_t(0));
+        }
+        while (words.get_size() > (new_size + 63) / 64)
+        {
+            words.pop_back();
+        }
+
+        if (new_size > old_size && old_size % 64 != 0)
+        {
+            // Дозаполнение неполного слова, которое было последним до изменения размера
+            const uint64_t tail_mask = ~uint64_t(0) << (old_size % 64);
+            uint64_t& word = words[old_size / 64];
+            word = value ? word | tail_mask : word & ~tail_mask;
+        }
+
+        size = new_size;
+        ClearUnusedBits();
+        rank_index.clear();
+    }
+
+    // Резервирование места под capacity битов O(N / 64)
+    void reserve(size_t capacity)
+    {
+        words.reserve((capacity + 63) / 64);
+    }
+
+    // Строит индекс накопленных количеств единиц по блокам из kWordsPerBlock слов.
+    // Индекс сбрасывается при любом изменении вектора O(N / 64)
+    void build_rank_index()
+    {
+        SimpleVector<size_t> index;
+        index.reserve(words.get_size() / kWordsPerBlock + 1);
+
+        size_t total = 0;
+        for (size_t i = 0; i < words.get_size(); ++i)
+        {
+            if (i % kWordsPerBlock == 0)
+            {
+                index.push_back(total);
+            }
+            total += std::popcount(words[i]);
+        }
+        if (words.get_size() % kWordsPerBlock == 0)
+        {
+            index.push_back(total);
+        }
+
+        rank_index.swap(index);
+    }
+
+//------------------------------------------------------------------------ Очистка и удаление --------------------------------------------------------------
+
+    // Очистить вектор O(1)
+    void clear() noexcept
+    {
+        words.clear();
+        rank_index.clear();
+        size = 0;
+    }
+
+    // Удаление последнего бита O(1)
+    void pop_back() noexcept
+    {
+        assert(size > 0);
+
+        reset(size - 1);
+        --size;
+        if (size % 64 == 0)
+        {
+            words.pop_back();
+        }
+    }
+
+//--------------------------------------------------------------------- Прочие методы ----------------------------------------------------------------------
+
+    // Непосредственный доступ к словам для пакетной обработки O(1)
+    const uint64_t* data() const noexcept
+    {
+        return words.data();
+    }
+
+    // Количество слов O(1)
+    size_t word_count() const noexcept
+    {
+        return words.get_size();
+    }
+
+    // Обмен значений O(1)
+    void swap(BitVector& other) noexcept
+    {
+        words.swap(other.words);
+        rank_index.swap(other.rank_index);
+        std::swap(size, other.size);
+    }
+
+private:
+
+    // Количество слов в блоке индекса rank: 512 битов, одна кэш-линия
+    static constexpr size_t kWordsPerBlock = 8;
+
+    SimpleVector<uint64_t> words;
+    SimpleVector<size_t> rank_index;
+    size_t size = 0;
+
+    enum class WordOperation
+    {
+        kAnd,
+        kOr,
+        kXor
+    };
+
+    // lhs[i] = lhs[i] op rhs[i] для count слов: блоки по 4 (AVX2) или 2 (SSE2) слова одной командой, остаток по слову O(count)
+    template <WordOperation Operation>
+    static void CombineWords(uint64_t* lhs, const uint64_t* rhs, size_t count) noexcept
+    {
+        size_t i = 0;
+#if defined(BIT_VECTOR_AVX2)
+        for (; i + 4 <= count; i += 4)
+        {
+            const __m256i a = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(lhs + i));
+            const __m256i b = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(rhs + i));
+            __m256i result;
+            if constexpr (Operation == WordOperation::kAnd)
+            {
+                result = _mm256_and_si256(a, b);
+            }
+            else if constexpr (Operation == WordOperation::kOr)
+            {
+                result = _mm256_or_si256(a, b);
+            }
+            else
+            {
+                result = _mm256_xor_si256(a, b);
+            }
+            _mm256_storeu_si256(reinterpret_cast<__m256i*>(lhs + i), result);
+        }
+#elif defined(BIT_VECTOR_SSE2)
+        for (; i + 2 <= count; i += 2)
+        {
+            const __m128i a = _mm_loadu_si128(reinterpret_cast<const __m128i*>(lhs + i));
+            const __m128i b = _mm_loadu_si128(reinterpret_cast<const __m128i*>(rhs + i));
+            __m128i result;
+            if constexpr (Operation == WordOperation::kAnd)
+            {
+                result = _mm_and_si128(a, b);
+            }
+            else if constexpr (Operation == WordOperation::kOr)
+            {
+                result = _mm_or_si128(a, b);
+            }
+            else
+            {
+                result = _mm_xor_si128(a, b);
+            }
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(lhs + i), result);
+        }
+#endif
+        for (; i < count; ++i)
+        {
+            if constexpr (Operation == WordOperation::kAnd)
+            {
+                lhs[i] &= rhs[i];
+            }
+            else if constexpr (Operation == WordOperation::kOr)
+            {
+                lhs[i] |= rhs[i];
+            }
+            else
+            {
+                lhs[i] ^= rhs[i];
+            }
+        }
+    }
+
+    void CheckSameSize(const BitVector& other) const
+    {
+        if (size != other.size)
+        {
+            throw std::invalid_argument("Bit vectors must have the same size");
+        }
+    }
+
+    // Обнуляет биты последнего слова за пределами размера O(1)
+    void ClearUnusedBits() noexcept
+    {
+        if (size % 64 != 0)
+        {
+            words[size / 64] &= (uint64_t(1) << (size % 64)) - 1;
+        }
+    }
+
+    // Поиск первого единичного бита, начиная с pos O(N / 64)
+    size_t FindFrom(size_t pos) const noexcept
+    {
+        if (pos >= size)
+        {
+            return npos;
+        }
+
+        size_t word = pos / 64;
+        uint64_t bits = words[word] & (~uint64_t(0) << (pos % 64));
+
+        while (bits == 0)
+        {
+            if (++word == words.get_size())
+            {
+                return npos;
+            }
+            bits = words[word];
+        }
+        return word * 64 + std::countr_zero(bits);
+    }
+
+    // Позиция единичного бита с номером k внутри слова O(k)
+    static size_t SelectInWord(uint64_t word, size_t k) noexcept
+    {
+        for (size_t i = 0; i < k; ++i)
+        {
+            word &= word - 1;
+        }
+        return std::countr_zero(word);
+    }
+};
+
+//================================================= Блок перегруженных операторов =========================================================
+
+inline bool operator==(const BitVector& lhs, const BitVector& rhs)
+{
+    return lhs.get_size() == rhs.get_size() && std::equal(lhs.data(), lhs.data() + lhs.word_count(), rhs.data());
+}
+
+inline bool operator!=(const BitVector& lhs, const BitVector& rhs)
+{
+    return !(lhs == rhs);
+}
+
+inline BitVector operator&(BitVector lhs, const BitVector& rhs)
+{
+    lhs &= rhs;
+    return lhs;
+}
+
+inline BitVector operator|(BitVector lhs, const BitVector& rhs)
+{
+    lhs |= rhs;
+    return lhs;
+}
+
+inline BitVector operator^(BitVector lhs, const BitVector& rhs)
+{
+    lhs ^= rhs;
+    return lhs;
+}
@@ -0,0 +1,402 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <bit>
+#include <cassert>
+#include <cstddef>
+#include <memory>
+#include <mutex>
+
+// Повторное использование буферов RawMemory. Буферы до kMaxBytes байт выделяются размером, округленным
+// до степени двойки (классом), и при освобождении могут не отдаваться системе, а оставаться в кэше потока:
+// следующее выделение того же класса берет буфер из кэша без обращения к системному аллокатору.
+// Кэширование включается для потока заданием лимита байтов (по умолчанию 0 - кэш выключен, буферы сразу освобождаются).
+// Буфер, освобожденный не тем потоком, который его выделил, попадает в кэш освобождающего потока, а когда тот
+// переполнен - в общее хранилище, откуда потоки с пустым кэшем забирают буферы пачками.
+// Включается сборкой с SIMPLE_VECTOR_BUFFER_RECYCLER = 1: округление до класса увеличивает память небольших буферов
+// до двух раз, поэтому по умолчанию RawMemory выделяет ровно нужный размер у std::allocator
+#if !defined(SIMPLE_VECTOR_BUFFER_RECYCLER)
+#define SIMPLE_VECTOR_BUFFER_RECYCLER 0
+#endif
+
+// Счетчики выделений и освобождений одного потока
+struct BufferRecyclerStats
+{
+    // Выделения из кэша потока
+    size_t local_hits = 0;
+    // Выделения из общего хранилища
+    size_t shared_hits = 0;
+    // Выделения у системного аллокатора
+    size_t misses = 0;
+    // Освобождения, оставленные в кэше потока
+    size_t cached = 0;
+    // Освобождения, переданные в общее хранилище
+    size_t forwarded = 0;
+    // Освобождения, отданные системному аллокатору
+    size_t released = 0;
+
+    // Доля выделений, обошедшихся без системного аллокатора; 0, если выделений не было O(1)
+    double get_hit_rate() const noexcept
+    {
+        const size_t hits = local_hits + shared_hits;
+        return hits + misses == 0 ? 0.0 : static_cast<double>(hits) / static_cast<double>(hits + misses);
+    }
+};
+
+class BufferRecycler
+{
+    // Свободный буфер хранит указатель на следующий прямо в себе, поэтому списки не требуют выделений
+    struct FreeBlock
+    {
+        FreeBlock* next;
+    };
+
+    struct FreeList
+    {
+        FreeBlock* head = nullptr;
+        size_t count = 0;
+    };
+
+public:
+
+    // Наименьший и наибольший классы в байтах: меньшие запросы округляются до kMinBytes, большие не кэшируются
+    static constexpr size_t kMinBytes = 64;
+    static constexpr size_t kMaxBytes = size_t(1) << 20;
+    static constexpr size_t kClassCount = std::bit_width(kMaxBytes) - std::bit_width(kMinBytes) + 1;
+    // Сколько буферов забирается из общего хранилища за одно обращение
+    static constexpr size_t kSharedBatch = 8;
+
+    // Общее хранилище буферов, вытесненных из кэшей потоков, и буферов завершившихся потоков
+    class SharedDepot
+    {
+    public:
+
+        SharedDepot(const SharedDepot&) = delete;
+        SharedDepot& operator=(const SharedDepot&) = delete;
+
+        // После уничтожения хранилища буферы, которые в него передаются, сразу отдаются системе
+        ~SharedDepot()
+        {
+            release();
+            destroyed.store(true, std::memory_order_release);
+        }
+
+        // Установить лимит байтов в хранилище; лишние буферы отдаются системе O(N)
+        void set_byte_limit(size_t limit)
+        {
+            std::lock_guard guard(mutex);
+            byte_limit = limit;
+            for (size_t index = kClassCount; index-- > 0 && cached_bytes > byte_limit;)
+            {
+                cached_bytes -= ReleaseList(lists[index], index);
+            }
+        }
+
+        size_t get_byte_limit() const
+        {
+            std::lock_guard guard(mutex);
+            return byte_limit;
+        }
+
+        size_t get_cached_bytes() const
+        {
+            std::lock_guard guard(mutex);
+            return cached_bytes;
+        }
+
+        // Отдать системе все буферы хранилища O(N)
+        void release()
+        {
+            std::lock_guard guard(mutex);
+            for (size_t index = 0; index < kClassCount; ++index)
+            {
+                cached_bytes -= ReleaseList(lists[index], index);
+            }
+        }
+
+    private:
+
+        friend class BufferRecycler;
+
+        // Флаг переживает само хранилище: у него тривиальный деструктор
+        inline static std::atomic<bool> destroyed{ false };
+
+        mutable std::mutex mutex;
+        std::array<FreeList, kClassCount> lists{};
+        size_t cached_bytes = 0;
+        size_t byte_limit = size_t(16) << 20;
+
+        SharedDepot() = default;
+
+        // Забирает до max_count буферов класса index в список to O(max_count)
+        size_t Take(size_t index, FreeList& to, size_t max_count)
+        {
+            if (destroyed.load(std::memory_order_acquire))
+            {
+                return 0;
+            }
+            std::lock_guard guard(mutex);
+            FreeList& from = lists[index];
+            size_t taken = 0;
+            while (from.head != nullptr && taken < max_count)
+            {
+                FreeBlock* block = from.head;
+                from.head = block->next;
+                block->next = to.head;
+                to.head = block;
+                ++taken;
+            }
+            from.count -= taken;
+            to.count += taken;
+            cached_bytes -= taken * GetClassBytes(index);
+            return taken;
+        }
+
+        // Принимает весь список from класса index; что не помещается в лимит, отдается системе.
+        // Возвращает количество буферов, оставленных в хранилище O(N)
+        size_t Put(size_t index, FreeList& from)
+        {
+            if (destroyed.load(std::memory_order_acquire))
+            {
+                ReleaseList(from, index);
+                return 0;
+            }
+            const size_t bytes = GetClassBytes(index);
+            std::lock_guard guard(mutex);
+            FreeList& to = lists[index];
+            size_t kept = 0;
+            while (from.head != nullptr)
+            {
+                FreeBlock* block = from.head;
+                from.head = block->next;
+                if (cached_bytes + bytes <= byte_limit)
+                {
+                    block->next = to.head;
+                    to.head = block;
+                    cached_bytes += bytes;
+                    ++kept;
+                }
+                else
+                {
+                    Free(block, index);
+                }
+            }
+            to.count += kept;
+            from.count = 0;
+            return kept;
+        }
+    };
+
+    BufferRecycler(const BufferRecycler&) = delete;
+    BufferRecycler& operator=(const BufferRecycler&) = delete;
+
+    // Буферы завершающегося потока передаются в общее хранилище
+    ~BufferRecycler()
+    {
+        for (size_t index = 0; index < kClassCount; ++index)
+        {
+            if (lists[index].head != nullptr)
+            {
+                shared().Put(index, lists[index]);
+            }
+        }
+        local_destroyed = true;
+    }
+
+    // Кэш текущего потока O(1). Не вызывается после уничтожения кэша при завершении потока:
+    // RawMemory обращается к кэшу через allocate_buffer и deallocate_buffer, которые это проверяют
+    static BufferRecycler& local() noexcept
+    {
+        thread_local BufferRecycler recycler;
+        return recycler;
+    }
+
+    // Общее хранилище всех потоков O(1)
+    static SharedDepot& shared() noexcept
+    {
+        static SharedDepot depot;
+        return depot;
+    }
+
+    // Выделение через кэш текущего потока. Векторы, которые живут дольше кэша (статические или
+    // thread_local, созданные раньше него), получают и возвращают буферы напрямую у системы O(1)
+    static void* allocate_buffer(size_t bytes)
+    {
+        if (local_destroyed)
+        {
+            return std::allocator<std::byte>().allocate(get_class_bytes(bytes));
+        }
+        return local().allocate(bytes);
+    }
+
+    static void deallocate_buffer(void* buffer, size_t bytes) noexcept
+    {
+        if (local_destroyed)
+        {
+            Free(static_cast<FreeBlock*>(buffer), GetClassIndex(bytes));
+            return;
+        }
+        local().deallocate(buffer, bytes);
+    }
+
+    // Размер класса, к которому относится запрос на bytes байт (bytes <= kMaxBytes) O(1)
+    static constexpr size_t get_class_bytes(size_t bytes) noexcept
+    {
+        return GetClassBytes(GetClassIndex(bytes));
+    }
+
+    // Выделить буфер не меньше bytes байт (bytes <= kMaxBytes), выровненный по __STDCPP_DEFAULT_NEW_ALIGNMENT__.
+    // Сначала проверяется кэш потока, затем общее хранилище, затем системный аллокатор O(1)
+    void* allocate(size_t bytes)
+    {
+        assert(bytes <= kMaxBytes);
+        const size_t index = GetClassIndex(bytes);
+        FreeList& list = lists[index];
+
+        if (list.head != nullptr)
+        {
+            ++stats.local_hits;
+        }
+        else if (byte_limit != 0 && shared().Take(index, list, std::max<size_t>(1, std::min(kSharedBatch, byte_limit / GetClassBytes(index)))) != 0)
+        {
+            cached_bytes += list.count * GetClassBytes(index);
+            ++stats.shared_hits;
+        }
+        else
+        {
+            ++stats.misses;
+            return std::allocator<std::byte>().allocate(GetClassBytes(index));
+        }
+
+        FreeBlock* block = list.head;
+        list.head = block->next;
+        --list.count;
+        cached_bytes -= GetClassBytes(index);
+        return block;
+    }
+
+    // Вернуть буфер, выделенный allocate с тем же bytes в любом потоке. Буфер остается в кэше потока,
+    // если тот включен; при переполнении кэша буферы этого класса уходят в общее хранилище O(1) амортизированно
+    void deallocate(void* buffer, size_t bytes) noexcept
+    {
+        assert(bytes <= kMaxBytes);
+        const size_t index = GetClassIndex(bytes);
+        const size_t class_bytes = GetClassBytes(index);
+        FreeList& list = lists[index];
+
+        FreeBlock* block = static_cast<FreeBlock*>(buffer);
+        if (cached_bytes + class_bytes <= byte_limit)
+        {
+            block->next = list.head;
+            list.head = block;
+            ++list.count;
+            cached_bytes += class_bytes;
+            ++stats.cached;
+            return;
+        }
+        if (byte_limit == 0)
+        {
+            Free(block, index);
+            ++stats.released;
+            return;
+        }
+
+        // Кэш переполнен: весь список этого класса вместе с новым буфером передается в общее хранилище
+        block->next = list.head;
+        list.head = block;
+        const size_t count = ++list.count;
+        cached_bytes -= (count - 1) * class_bytes;
+        const size_t kept = shared().Put(index, list);
+        stats.forwarded += kept;
+        stats.released += count - kept;
+    }
+
+    // Установить лимит байтов в кэше потока; 0 выключает кэш. Лишние буферы передаются в общее хранилище O(N)
+    void set_byte_limit(size_t limit)
+    {
+        byte_limit = limit;
+        for (size_t index = kClassCount; index-- > 0 && cached_bytes > byte_limit;)
+        {
+            if (lists[index].head != nullptr)
+            {
+                cached_bytes -= lists[index].count * GetClassBytes(index);
+                shared().Put(index, lists[index]);
+            }
+        }
+    }
+
+    size_t get_byte_limit() const noexcept
+    {
+        return byte_limit;
+    }
+
+    // Байты в буферах, лежащих в кэше потока O(1)
+    size_t get_cached_bytes() const noexcept
+    {
+        return cached_bytes;
+    }
+
+    // Отдать системе все буферы из кэша потока O(N)
+    void release() noexcept
+    {
+        for (size_t index = 0; index < kClassCount; ++index)
+        {
+            stats.released += lists[index].count;
+            cached_bytes -= lists[index].count * GetClassBytes(index);
+            ReleaseList(lists[index], index);
+        }
+    }
+
+    const BufferRecyclerStats& get_stats() const noexcept
+    {
+        return stats;
+    }
+
+    void reset_stats() noexcept
+    {
+        stats = BufferRecyclerStats();
+    }
+
+private:
+
+    // Кэш потока уже уничтожен; тривиальный деструктор флага позволяет читать его до конца потока
+    inline static thread_local bool local_destroyed = false;
+
+    std::array<FreeList, kClassCount> lists{};
+    size_t cached_bytes = 0;
+    size_t byte_limit = 0;
+    BufferRecyclerStats stats;
+
+    BufferRecycler() = default;
+
+    static constexpr size_t GetClassIndex(size_t bytes) noexcept
+    {
+        return bytes <= kMinBytes ? 0 : std::bit_width(bytes - 1) - std::bit_width(kMinBytes - 1);
+    }
+
+    static constexpr size_t GetClassBytes(size_t index) noexcept
+    {
+        return kMinBytes << index;
+    }
+
+    static void Free(FreeBlock* block, size_t index) noexcept
+    {
+        std::allocator<std::byte>().deallocate(reinterpret_cast<std::byte*>(block), GetClassBytes(index));
+    }
+
+    // Отдает системе все буферы списка класса index, возвращает их суммарный размер O(N)
+    static size_t ReleaseList(FreeList& list, size_t index) noexcept
+    {
+        const size_t bytes = list.count * GetClassBytes(index);
+        while (list.head != nullptr)
+        {
+            FreeBlock* block = list.head;
+            list.head = block->next;
+            Free(block, index);
+        }
+        list.count = 0;
+        return bytes;
+    }
+};
@@ -0,0 +1,437 @@
+#pragma once
+
+#include "array_ptr.h"
+#include "raw_memory.h"
+#include "simple_vector.h"
+
+#include <atomic>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <utility>
+
+// Размер кэш-линии, по которому разносятся разделяемые потоками данные
+constexpr size_t kCacheLineSize = 64;
+
+// Значение, занимающее целую кэш-линию, чтобы соседние значения не делили её между ядрами
+template <typename Type>
+struct alignas(kCacheLineSize) CacheLinePadded
+{
+    Type value{};
+};
+
+//================================================================ Очередь один производитель - один потребитель ======================================================
+
+// Ограниченная очередь без блокировок для одного производителя и одного потребителя.
+// Индексы записи и чтения лежат в разных кэш-линиях, и каждая сторона кэширует чужой индекс,
+// обращаясь к нему только когда кэшированное значение говорит о переполнении или пустоте.
+// Элемент создается в ячейке при добавлении и уничтожается при извлечении
+template <typename Type>
+class SpscQueue
+{
+public:
+
+    // Создает очередь, вместимость округляется до степени двойки
+    explicit SpscQueue(size_t capacity) : capacity(std::bit_ceil(std::max<size_t>(capacity, 2))), slots(this->capacity) {}
+
+    SpscQueue(const SpscQueue&) = delete;
+    SpscQueue& operator=(const SpscQueue&) = delete;
+
+    // Уничтожает оставшиеся в очереди элементы O(N)
+    ~SpscQueue()
+    {
+        const size_t tail = producer.value.tail.load(std::memory_order_acquire);
+        for (size_t head = consumer.value.head.load(std::memory_order_relaxed); head != tail; ++head)
+        {
+            std::destroy_at(slots + (head & (capacity - 1)));
+        }
+    }
+
+//------------------------------------------------------------- Производитель --------------------------------------------------------------------
+
+    // Добавление с перемещением, false при заполненной очереди O(1)
+    bool try_push(Type&& item)
+    {
+        const size_t tail = producer.value.tail.load(std::memory_order_relaxed);
+        if (!HasSpace(tail, 1))
+        {
+            return false;
+        }
+
+        std::construct_at(slots + (tail & (capacity - 1)), std::move(item));
+        producer.value.tail.store(tail + 1, std::memory_order_release);
+        return true;
+    }
+
+    // Добавление с копированием, false при заполненной очереди O(1)
+    bool try_push(const Type& item)
+    {
+        Type copy(item);
+        return try_push(std::move(copy));
+    }
+
+    // Перемещает в очередь до count элементов из [first, first + count) одной публикацией индекса.
+    // Если перемещение выбросит исключение, уже перемещенные элементы публикуются.
+    // Возвращает количество перемещенных элементов O(count)
+    size_t try_push_n(Type* first, size_t count)
+    {
+        const size_t tail = producer.value.tail.load(std::memory_order_relaxed);
+
+        HasSpace(tail, count);
+        count = std::min(count, capacity - (tail - producer.value.cached_head));
+
+        size_t pushed = 0;
+        try
+        {
+            for (; pushed < count; ++pushed)
+            {
+                std::construct_at(slots + ((tail + pushed) & (capacity - 1)), std::move(first[pushed]));
+            }
+        }
+        catch (...)
+        {
+            producer.value.tail.store(tail + pushed, std::memory_order_release);
+            throw;
+        }
+        producer.value.tail.store(tail + count, std::memory_order_release);
+        return count;
+    }
+
+//------------------------------------------------------------- Потребитель --------------------------------------------------------------------
+
+    // Извлечение первого элемента, false при пустой очереди O(1)
+    bool try_pop(Type& item)
+    {
+        const size_t head = consumer.value.head.load(std::memory_order_relaxed);
+        if (!HasItems(head, 1))
+        {
+            return false;
+        }
+
+        Type& slot = slots[head & (capacity - 1)];
+        item = std::move(slot);
+        std::destroy_at(&slot);
+        consumer.value.head.store(head + 1, std::memory_order_release);
+        return true;
+    }
+
+    // Переносит в конец out до max_count элементов одной публикацией индекса.
+    // Возвращает количество перенесенных элементов O(max_count)
+    size_t try_pop_n(SimpleVector<Type>& out, size_t max_count)
+    {
+        const size_t head = consumer.value.head.load(std::memory_order_relaxed);
+
+        HasItems(head, max_count);
+        const size_t count = std::min(max_count, consumer.value.cached_tail - head);
+
+        // Память выделяется до переноса: нехватка памяти не оставит в очереди уже перенесенные элементы
+        out.reserve(out.get_size() + count);
+        size_t popped = 0;
+        try
+        {
+            for (; popped < count; ++popped)
+            {
+                Type& slot = slots[(head + popped) & (capacity - 1)];
+                out.push_back_unchecked(std::move(slot));
+                std::destroy_at(&slot);
+            }
+        }
+        catch (...)
+        {
+            // Перенесенные до исключения элементы освобождают свои ячейки, остальные остаются в очереди
+            consumer.value.head.store(head + popped, std::memory_order_release);
+            throw;
+        }
+        consumer.value.head.store(head + count, std::memory_order_release);
+        return count;
+    }
+
+//------------------------------------------------------------- Общие методы --------------------------------------------------------------------
+
+    // Приблизительное количество элементов O(1)
+    size_t get_size() const noexcept
+    {
+        return producer.value.tail.load(std::memory_order_acquire) - consumer.value.head.load(std::memory_order_acquire);
+    }
+
+    // Вместимость O(1)
+    size_t get_capacity() const noexcept
+    {
+        return capacity;
+    }
+
+private:
+
+    struct ProducerState
+    {
+        std::atomic<size_t> tail{ 0 };
+        size_t cached_head = 0;
+    };
+
+    struct ConsumerState
+    {
+        std::atomic<size_t> head{ 0 };
+        size_t cached_tail = 0;
+    };
+
+    const size_t capacity;
+    RawMemory<Type> slots;
+    CacheLinePadded<ProducerState> producer;
+    CacheLinePadded<ConsumerState> consumer;
+
+    // Есть ли место под count элементов; чужой индекс перечитывается только при нехватке места
+    bool HasSpace(size_t tail, size_t count) noexcept
+    {
+        if (capacity - (tail - producer.value.cached_head) < count)
+        {
+            producer.value.cached_head = consumer.value.head.load(std::memory_order_acquire);
+        }
+        return capacity - (tail - producer.value.cached_head) >= count;
+    }
+
+    // Есть ли count элементов; чужой индекс перечитывается только при их нехватке
+    bool HasItems(size_t head, size_t count) noexcept
+    {
+        if (consumer.value.cached_tail - head < count)
+        {
+            consumer.value.cached_tail = producer.value.tail.load(std::memory_order_acquire);
+        }
+        return consumer.value.cached_tail - head >= count;
+    }
+};
+
+//================================================================ Очередь многие производители - многие потребители ===================================================
+
+// Ограниченная очередь для многих производителей и потребителей на последовательностях ячеек (схема Вьюкова).
+// Каждая ячейка занимает отдельную кэш-линию, поэтому соседние операции разных потоков не мешают друг другу
+template <typename Type>
+class MpmcQueue
+{
+public:
+
+    // Создает очередь, вместимость округляется до степени двойки
+    explicit MpmcQueue(size_t capacity) : capacity(std::bit_ceil(std::max<size_t>(capacity, 2))), cells(this->capacity)
+    {
+        for (size_t i = 0; i < this->capacity; ++i)
+        {
+            cells[i].sequence.store(i, std::memory_order_relaxed);
+        }
+    }
+
+    MpmcQueue(const MpmcQueue&) = delete;
+    MpmcQueue& operator=(const MpmcQueue&) = delete;
+
+//------------------------------------------------------------- Производители --------------------------------------------------------------------
+
+    // Добавление с перемещением, false при заполненной очереди O(1) без блокировок
+    bool try_push(Type&& item)
+    {
+        size_t position = enqueue_position.value.load(std::memory_order_relaxed);
+        Cell* cell = nullptr;
+
+        for (;;)
+        {
+            cell = &cells[position & (capacity - 1)];
+            const size_t sequence = cell->sequence.load(std::memory_order_acquire);
+            const std::ptrdiff_t difference = static_cast<std::ptrdiff_t>(sequence - position);
+
+            if (difference == 0)
+            {
+                if (enqueue_position.value.compare_exchange_weak(position, position + 1, std::memory_order_relaxed))
+                {
+                    break;
+                }
+            }
+            else if (difference < 0)
+            {
+                return false;
+            }
+            else
+            {
+                position = enqueue_position.value.load(std::memory_order_relaxed);
+            }
+        }
+
+        cell->data = std::move(item);
+        cell->sequence.store(position + 1, std::memory_order_release);
+        return true;
+    }
+
+    // Добавление с копированием, false при заполненной очереди O(1) без блокировок
+    bool try_push(const Type& item)
+    {
+        Type copy(item);
+        return try_push(std::move(copy));
+    }
+
+    // Захватывает одной операцией до count подряд идущих позиций и перемещает в них элементы из [first, first + count).
+    // Захватываются только ячейки, уже освобожденные потребителями, поэтому после захвата ждать некого.
+    // Возвращает количество перемещенных элементов O(count) без блокировок
+    size_t try_push_n(Type* first, size_t count)
+    {
+        if (count == 0)
+        {
+            return 0;
+        }
+
+        size_t position = enqueue_position.value.load(std::memory_order_relaxed);
+
+        for (;;)
+        {
+            const size_t sequence = cells[position & (capacity - 1)].sequence.load(std::memory_order_acquire);
+            const std::ptrdiff_t difference = static_cast<std::ptrdiff_t>(sequence - position);
+
+            if (difference < 0)
+            {
+                return 0;
+            }
+            if (difference > 0)
+            {
+                position = enqueue_position.value.load(std::memory_order_relaxed);
+                continue;
+            }
+
+            const size_t ready = CountReady(position, count, 0);
+            if (enqueue_position.value.compare_exchange_weak(position, position + ready, std::memory_order_relaxed))
+            {
+                count = ready;
+                break;
+            }
+        }
+
+        for (size_t i = 0; i < count; ++i)
+        {
+            Cell& cell = cells[(position + i) & (capacity - 1)];
+            cell.data = std::move(first[i]);
+            cell.sequence.store(position + i + 1, std::memory_order_release);
+        }
+        return count;
+    }
+
+//------------------------------------------------------------- Потребители --------------------------------------------------------------------
+
+    // Извлечение первого элемента, false при пустой очереди O(1) без блокировок
+    bool try_pop(Type& item)
+    {
+        size_t position = dequeue_position.value.load(std::memory_order_relaxed);
+        Cell* cell = nullptr;
+
+        for (;;)
+        {
+            cell = &cells[position & (capacity - 1)];
+            const size_t sequence = cell->sequence.load(std::memory_order_acquire);
+            const std::ptrdiff_t difference = static_cast<std::ptrdiff_t>(sequence - (position + 1));
+
+            if (difference == 0)
+            {
+                if (dequeue_position.value.compare_exchange_weak(position, position + 1, std::memory_order_relaxed))
+                {
+                    break;
+                }
+            }
+            else if (difference < 0)
+            {
+                return false;
+            }
+            else
+            {
+                position = dequeue_position.value.load(std::memory_order_relaxed);
+            }
+        }
+
+        item = std::move(cell->data);
+        cell->sequence.store(position + capacity, std::memory_order_release);
+        return true;
+    }
+
+    // Захватывает одной операцией до max_count подряд идущих позиций и переносит элементы в конец out.
+    // Захватываются только уже заполненные производителями ячейки, поэтому после захвата ждать некого.
+    // Возвращает количество перенесенных элементов O(max_count) без блокировок
+    size_t try_pop_n(SimpleVector<Type>& out, size_t max_count)
+    {
+        if (max_count == 0)
+        {
+            return 0;
+        }
+
+        // Память выделяется до захвата позиций: захваченные ячейки должны быть освобождены в любом случае.
+        // Больше вместимости очереди за раз не извлекается
+        out.reserve(out.get_size() + std::min(max_count, capacity));
+
+        size_t position = dequeue_position.value.load(std::memory_order_relaxed);
+        size_t count = 0;
+
+        for (;;)
+        {
+            const size_t sequence = cells[position & (capacity - 1)].sequence.load(std::memory_order_acquire);
+            const std::ptrdiff_t difference = static_cast<std::ptrdiff_t>(sequence - (position + 1));
+
+            if (difference < 0)
+            {
+                return 0;
+            }
+            if (difference > 0)
+            {
+                position = dequeue_position.value.load(std::memory_order_relaxed);
+                continue;
+            }
+
+            count = CountReady(position, max_count, 1);
+            if (dequeue_position.value.compare_exchange_weak(position, position + count, std::memory_order_relaxed))
+            {
+                break;
+            }
+        }
+
+        for (size_t i = 0; i < count; ++i)
+        {
+            Cell& cell = cells[(position + i) & (capacity - 1)];
+            out.push_back_unchecked(std::move(cell.data));
+            cell.sequence.store(position + i + capacity, std::memory_order_release);
+        }
+        return count;
+    }
+
+//------------------------------------------------------------- Общие методы --------------------------------------------------------------------
+
+    // Приблизительное количество элементов O(1)
+    size_t get_size() const noexcept
+    {
+        const size_t enqueued = enqueue_position.value.load(std::memory_order_acquire);
+        const size_t dequeued = dequeue_position.value.load(std::memory_order_acquire);
+        return static_cast<std::ptrdiff_t>(enqueued - dequeued) > 0 ? enqueued - dequeued : 0;
+    }
+
+    // Вместимость O(1)
+    size_t get_capacity() const noexcept
+    {
+        return capacity;
+    }
+
+private:
+
+    struct alignas(kCacheLineSize) Cell
+    {
+        std::atomic<size_t> sequence{ 0 };
+        Type data{};
+    };
+
+    const size_t capacity;
+    ArrayPtr<Cell> cells;
+    CacheLinePadded<std::atomic<size_t>> enqueue_position;
+    CacheLinePadded<std::atomic<size_t>> dequeue_position;
+
+    // Длина серии готовых ячеек, начиная с position, не больше max_count: ячейка позиции p готова, когда её
+    // последовательность равна p + offset (0 - свободна для записи, 1 - заполнена). Первая ячейка уже проверена.
+    // Серия не длиннее вместимости: ячейка position + capacity совпадает с первой и ждет другого значения O(max_count)
+    size_t CountReady(size_t position, size_t max_count, size_t offset) const noexcept
+    {
+        size_t ready = 1;
+        while (ready < max_count && cells[(position + ready) & (capacity - 1)].sequence.load(std::memory_order_acquire) == position + ready + offset)
+        {
+            ++ready;
+        }
+        return ready;
+    }
+};
@@ -14,16 +14,16 @@ class MemoryLeakDetector
 public:
     MemoryLeakDetector()
     {
-        //     
+        // Настройка режима отчета о памяти
         _CrtSetReportMode(_CRT_WARN, _CRTDBG_MODE_FILE);
 
-        //     
+        // Настройка файла для записи отчетов
         _CrtSetReportFile(_CRT_WARN, _CRTDBG_FILE_STDERR);
     }
 
     ~MemoryLeakDetector()
     {
-        //     
+        // Проверка на наличие утечек памяти
         _CrtDumpMemoryLeaks();
     }
 };
\ No newline at end of file
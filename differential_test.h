@@ -0,0 +1,520 @@
+#pragma once
+
+#include "simple_vector.h"
+#include "erase.h"
+
+#include <cstdint>
+#include <cstdlib>
+#include <iostream>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+// Дифференциальная проверка SimpleVector: случайная последовательность операций выполняется
+// одновременно над SimpleVector<Type> и std::vector<Type>, и после каждой операции содержимое сравнивается.
+// Операции и их аргументы читаются из массива байтов, поэтому одна и та же функция служит и целью для libFuzzer,
+// и обычным тестом на псевдослучайных данных. Ошибка останавливает программу с номером операции и её названием
+
+//================================================================ Типы элементов ===========================================================================
+
+// Исключение, которое выбрасывают элементы по заказу проверки
+struct InjectedFailure : std::runtime_error
+{
+    InjectedFailure() : std::runtime_error("Injected failure") {}
+};
+
+// Элемент, копирование которого может выбросить исключение. Перемещение не бросает.
+// Считает живые экземпляры, чтобы проверять отсутствие утечек и двойного уничтожения
+class ThrowingCopy
+{
+public:
+
+    ThrowingCopy() : ThrowingCopy(0) {}
+
+    explicit ThrowingCopy(int value) : value(value)
+    {
+        ++live;
+    }
+
+    ThrowingCopy(const ThrowingCopy& other) : value(other.value)
+    {
+        MaybeThrow();
+        ++live;
+    }
+
+    ThrowingCopy(ThrowingCopy&& other) noexcept : value(other.value)
+    {
+        ++live;
+    }
+
+    ThrowingCopy& operator=(const ThrowingCopy& other)
+    {
+        MaybeThrow();
+        value = other.value;
+        return *this;
+    }
+
+    ThrowingCopy& operator=(ThrowingCopy&& other) noexcept = default;
+
+    ~ThrowingCopy()
+    {
+        --live;
+    }
+
+    bool operator==(const ThrowingCopy& other) const noexcept
+    {
+        return value == other.value;
+    }
+
+    int get_value() const noexcept
+    {
+        return value;
+    }
+
+    // Количество копирований до исключения; отрицательное значение отключает исключения
+    inline static int copies_until_failure = -1;
+    inline static size_t live = 0;
+
+private:
+
+    int value;
+
+    static void MaybeThrow()
+    {
+        if (copies_until_failure >= 0 && copies_until_failure-- == 0)
+        {
+            throw InjectedFailure();
+        }
+    }
+};
+
+// Элемент, который можно только перемещать
+class MoveOnly
+{
+public:
+
+    explicit MoveOnly(int value = 0) : value(value) {}
+
+    MoveOnly(const MoveOnly&) = delete;
+    MoveOnly& operator=(const MoveOnly&) = delete;
+
+    MoveOnly(MoveOnly&& other) noexcept : value(std::exchange(other.value, -1)) {}
+
+    MoveOnly& operator=(MoveOnly&& other) noexcept
+    {
+        value = std::exchange(other.value, -1);
+        return *this;
+    }
+
+    bool operator==(const MoveOnly& other) const noexcept
+    {
+        return value == other.value;
+    }
+
+private:
+
+    int value;
+};
+
+// Создание элемента из байта входных данных
+template <typename Type>
+Type MakeDifferentialValue(uint8_t byte)
+{
+    if constexpr (std::is_same_v<Type, std::string>)
+    {
+        // Длинные строки не помещаются во внутренний буфер и проверяют владение памятью в куче
+        return std::string(byte % 40, static_cast<char>('a' + byte % 26));
+    }
+    else
+    {
+        return Type(static_cast<int>(byte));
+    }
+}
+
+//================================================================ Входные данные ==========================================================================
+
+// Последовательное чтение байтов; после конца данных возвращает нули
+class ByteReader
+{
+public:
+
+    ByteReader(const uint8_t* data, size_t size) noexcept : data(data), size(size) {}
+
+    uint8_t next() noexcept
+    {
+        return position < size ? data[position++] : 0;
+    }
+
+    bool is_empty() const noexcept
+    {
+        return position >= size;
+    }
+
+private:
+
+    const uint8_t* data;
+    size_t size;
+    size_t position = 0;
+};
+
+//================================================================ Проверка ================================================================================
+
+// Выполняет операции над SimpleVector<Type> и std::vector<Type> параллельно и сравнивает результат.
+// Для ThrowingCopy перед каждой операцией заказывается исключение на случайном копировании.
+// Если SimpleVector выбросил его, проверяется гарантия операции: при строгой вектор не изменился,
+// при базовой он корректен и не потерял элементов, после чего эталон приравнивается к нему
+template <typename Type>
+class DifferentialHarness
+{
+public:
+
+    explicit DifferentialHarness(ByteReader& input) : input(input) {}
+
+    void run()
+    {
+        while (!input.is_empty() && step < kMaxSteps)
+        {
+            Step();
+            CheckEqual();
+            ++step;
+        }
+
+        actual.clear();
+        expected.clear();
+        if constexpr (kCountsInstances)
+        {
+            Check(ThrowingCopy::live == 0, "elements leaked or destroyed twice");
+        }
+    }
+
+private:
+
+    static constexpr bool kCopyable = std::is_copy_constructible_v<Type>;
+    static constexpr bool kCountsInstances = std::is_same_v<Type, ThrowingCopy>;
+    static constexpr size_t kMaxSteps = 4096;
+    // Ограничение размера, чтобы случайные resize и reserve не исчерпали память
+    static constexpr size_t kMaxSize = 512;
+
+    enum class Guarantee
+    {
+        kStrong,
+        kBasic
+    };
+
+    ByteReader& input;
+    SimpleVector<Type> actual;
+    std::vector<Type> expected;
+    size_t step = 0;
+    const char* operation = "";
+
+    void Check(bool condition, const char* message) const
+    {
+        if (!condition)
+        {
+            std::cerr << "Differential test failed at step " << step << " (" << operation << "): " << message << std::endl;
+            std::abort();
+        }
+    }
+
+    void CheckEqual() const
+    {
+        Check(actual.get_size() == expected.size(), "size differs from std::vector");
+        Check(actual.get_size() <= actual.get_capacity(), "size exceeds capacity");
+        Check(actual.end() - actual.begin() == static_cast<std::ptrdiff_t>(actual.get_size()), "end() - begin() differs from size");
+        for (size_t i = 0; i < expected.size(); ++i)
+        {
+            Check(actual[i] == expected[i], "element differs from std::vector");
+        }
+        if constexpr (kCountsInstances)
+        {
+            Check(ThrowingCopy::live == actual.get_size() + expected.size(), "live element count differs from sizes");
+        }
+    }
+
+    Type MakeValue()
+    {
+        return MakeDifferentialValue<Type>(input.next());
+    }
+
+    size_t MakeIndex(size_t bound)
+    {
+        const size_t index = static_cast<size_t>(input.next()) | static_cast<size_t>(input.next()) << 8;
+        return bound == 0 ? 0 : index % bound;
+    }
+
+    // Выполняет операцию над SimpleVector с возможным исключением и повторяет её над эталоном, если она удалась
+    template <typename ActualOperation, typename ExpectedOperation>
+    void Apply(const char* name, Guarantee guarantee, ActualOperation actual_operation, ExpectedOperation expected_operation)
+    {
+        operation = name;
+
+        const uint8_t failure = input.next();
+        bool failed = false;
+
+        if constexpr (kCountsInstances)
+        {
+            ThrowingCopy::copies_until_failure = failure < 64 ? failure % 8 : -1;
+        }
+        try
+        {
+            actual_operation();
+        }
+        catch (const InjectedFailure&)
+        {
+            failed = true;
+        }
+        if constexpr (kCountsInstances)
+        {
+            ThrowingCopy::copies_until_failure = -1;
+        }
+
+        if (!failed)
+        {
+            expected_operation();
+            return;
+        }
+
+        // При строгой гарантии эталон не меняется, и сравнение после шага проверяет, что вектор тоже не изменился.
+        // При базовой вектор должен остаться корректным; его содержимое становится новым эталоном
+        if constexpr (kCopyable)
+        {
+            if (guarantee == Guarantee::kBasic)
+            {
+                expected.assign(actual.begin(), actual.end());
+            }
+        }
+    }
+
+    void Step()
+    {
+        switch (input.next() % 21)
+        {
+        case 0:
+            if constexpr (kCopyable)
+            {
+                const Type value = MakeValue();
+                Apply("push_back copy", Guarantee::kStrong, [&]() { actual.push_back(value); }, [&]() { expected.push_back(value); });
+            }
+            break;
+        case 1:
+        {
+            const uint8_t byte = input.next();
+            Type value = MakeDifferentialValue<Type>(byte);
+            Type twin = MakeDifferentialValue<Type>(byte);
+            Apply("push_back move", Guarantee::kStrong, [&]() { actual.push_back(std::move(value)); }, [&]() { expected.push_back(std::move(twin)); });
+            break;
+        }
+        case 2:
+            if (!expected.empty())
+            {
+                Apply("pop_back", Guarantee::kStrong, [&]() { actual.pop_back(); }, [&]() { expected.pop_back(); });
+            }
+            break;
+        case 3:
+            if constexpr (kCopyable)
+            {
+                const size_t index = MakeIndex(expected.size() + 1);
+                const Type value = MakeValue();
+                Apply("insert copy", Guarantee::kStrong, [&]() { actual.insert(actual.begin() + index, value); },
+                    [&]() { expected.insert(expected.begin() + index, value); });
+            }
+            break;
+        case 4:
+        {
+            const size_t index = MakeIndex(expected.size() + 1);
+            const uint8_t byte = input.next();
+            Type value = MakeDifferentialValue<Type>(byte);
+            Type twin = MakeDifferentialValue<Type>(byte);
+            Apply("insert move", Guarantee::kStrong, [&]() { actual.insert(actual.begin() + index, std::move(value)); },
+                [&]() { expected.insert(expected.begin() + index, std::move(twin)); });
+            break;
+        }
+        case 5:
+            if (!expected.empty())
+            {
+                const size_t index = MakeIndex(expected.size());
+                Apply("erase", Guarantee::kStrong, [&]() { actual.erase(actual.begin() + index); }, [&]() { expected.erase(expected.begin() + index); });
+            }
+            break;
+        case 6:
+        {
+            const size_t new_size = MakeIndex(kMaxSize);
+            Apply("resize", Guarantee::kStrong, [&]() { actual.resize(new_size); }, [&]() { expected.resize(new_size); });
+            break;
+        }
+        case 7:
+        {
+            const size_t new_capacity = MakeIndex(kMaxSize);
+            Apply("reserve", Guarantee::kStrong, [&]() { actual.reserve(new_capacity); }, [&]() { expected.reserve(new_capacity); });
+            Check(actual.get_capacity() >= new_capacity, "reserve did not reach the requested capacity");
+            break;
+        }
+        case 8:
+            Apply("shrink_to_fit", Guarantee::kStrong, [&]() { actual.shrink_to_fit(); }, [&]() {});
+            break;
+        case 9:
+            Apply("clear", Guarantee::kStrong, [&]() { actual.clear(); }, [&]() { expected.clear(); });
+            break;
+        case 10:
+            if constexpr (kCopyable)
+            {
+                const size_t new_size = MakeIndex(kMaxSize / 4);
+                const Type value = MakeValue();
+                Apply("assign", Guarantee::kBasic, [&]() { actual.assign(new_size, value); }, [&]() { expected.assign(new_size, value); });
+            }
+            break;
+        case 11:
+            if constexpr (kCopyable)
+            {
+                std::vector<Type> range;
+                for (size_t count = input.next() % 8; count > 0; --count)
+                {
+                    range.push_back(MakeValue());
+                }
+                Apply("append_range", Guarantee::kStrong, [&]() { actual.append_range(range.begin(), range.end()); },
+                    [&]() { expected.insert(expected.end(), range.begin(), range.end()); });
+            }
+            break;
+        case 12:
+            if constexpr (kCopyable)
+            {
+                Apply("copy", Guarantee::kStrong, [&]()
+                    {
+                        SimpleVector<Type> copy(actual);
+                        Check(copy == actual, "copy differs from the original");
+                        actual = copy;
+                    }, [&]() {});
+            }
+            break;
+        case 13:
+            Apply("move", Guarantee::kStrong, [&]()
+                {
+                    SimpleVector<Type> moved(std::move(actual));
+                    Check(actual.is_empty(), "moved-from vector is not empty");
+                    actual = std::move(moved);
+                }, [&]() {});
+            break;
+        case 14:
+        {
+            SimpleVector<Type> other;
+            std::vector<Type> other_expected;
+            for (size_t count = input.next() % 8; count > 0; --count)
+            {
+                const uint8_t byte = input.next();
+                other.push_back(MakeDifferentialValue<Type>(byte));
+                other_expected.push_back(MakeDifferentialValue<Type>(byte));
+            }
+            Apply("swap", Guarantee::kStrong, [&]() { actual.swap(other); }, [&]() { expected.swap(other_expected); });
+            break;
+        }
+        case 15:
+        {
+            const uint8_t mask = input.next();
+            size_t actual_calls = 0;
+            size_t expected_calls = 0;
+            Apply("erase_if", Guarantee::kStrong, [&]() { erase_if(actual, [&](const Type&) { return (mask >> (actual_calls++ % 8)) & 1; }); },
+                [&]() { std::erase_if(expected, [&](const Type&) { return (mask >> (expected_calls++ % 8)) & 1; }); });
+            break;
+        }
+        case 16:
+            Apply("unique", Guarantee::kStrong, [&]() { unique(actual); },
+                [&]() { expected.erase(std::unique(expected.begin(), expected.end()), expected.end()); });
+            break;
+        case 17:
+        {
+            operation = "at";
+            const size_t index = MakeIndex(expected.size() + 2);
+            bool thrown = false;
+            try
+            {
+                const Type& value = actual.at(index);
+                Check(index < expected.size() && value == expected[index], "at() returned a different element");
+            }
+            catch (const std::out_of_range&)
+            {
+                thrown = true;
+            }
+            Check(thrown == (index >= expected.size()), "at() range check differs from std::vector");
+            break;
+        }
+        case 18:
+        {
+            operation = "front and back";
+            bool thrown = false;
+            try
+            {
+                const Type& front = actual.front();
+                const Type& back = actual.back();
+                Check(!expected.empty() && front == expected.front() && back == expected.back(), "front() or back() returned a different element");
+            }
+            catch (const std::out_of_range&)
+            {
+                thrown = true;
+            }
+            Check(thrown == expected.empty(), "front() and back() on an empty vector must throw");
+            break;
+        }
+        case 19:
+        {
+            const size_t first = MakeIndex(expected.size() + 1);
+            const size_t count = MakeIndex(expected.size() - first + 1);
+            if constexpr (kCopyable)
+            {
+                if (input.next() % 2 == 0)
+                {
+                    Apply("subvector copy", Guarantee::kStrong, [&]() { actual = actual.subvector(first, count); },
+                        [&]() { expected = std::vector<Type>(expected.begin() + first, expected.begin() + first + count); });
+                    break;
+                }
+            }
+            Apply("subvector move", Guarantee::kStrong, [&]() { actual = std::move(actual).subvector(first, count); },
+                [&]()
+                {
+                    expected.erase(expected.begin() + first + count, expected.end());
+                    expected.erase(expected.begin(), expected.begin() + first);
+                });
+            break;
+        }
+        case 20:
+        {
+            SimpleVector<size_t> indices;
+            for (size_t index = input.next() % 4; index < expected.size(); index += 1 + input.next() % 4)
+            {
+                indices.push_back(index);
+            }
+            Apply("remove_indices", Guarantee::kStrong, [&]() { remove_indices(actual, indices); },
+                [&]()
+                {
+                    for (size_t i = indices.get_size(); i > 0; --i)
+                    {
+                        expected.erase(expected.begin() + indices[i - 1]);
+                    }
+                });
+            break;
+        }
+        }
+    }
+};
+
+// Прогоняет операции из data для всех проверяемых типов элементов
+inline void RunDifferentialTest(const uint8_t* data, size_t size)
+{
+    {
+        ByteReader input(data, size);
+        DifferentialHarness<int>(input).run();
+    }
+    {
+        ByteReader input(data, size);
+        DifferentialHarness<std::string>(input).run();
+    }
+    {
+        ByteReader input(data, size);
+        DifferentialHarness<MoveOnly>(input).run();
+    }
+    {
+        ByteReader input(data, size);
+        DifferentialHarness<ThrowingCopy>(input).run();
+    }
+}
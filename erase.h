@@ -0,0 +1,206 @@
+#pragma once
+
+#include "simple_vector.h"
+#include "thread_pool.h"
+
+#include <algorithm>
+#include <bit>
+#include <cstdint>
+#include <functional>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+
+#if defined(__AVX512F__)
+#include <immintrin.h>
+#endif
+
+// Пакетное удаление элементов SimpleVector за один проход: каждый оставшийся элемент сдвигается
+// не больше одного раза, в отличие от цикла erase(pos), сдвигающего весь хвост на каждом шаге.
+// Функции возвращают количество удаленных элементов; вместимость вектора не меняется
+
+// Минимальный размер, начиная с которого parallel_erase_if делит работу между потоками
+inline constexpr size_t kParallelEraseThreshold = size_t(1) << 16;
+
+//================================================================ Сжатие диапазона ========================================================================
+
+#if defined(__AVX512F__)
+// Записывает подряд в out элементы блока in, отмеченные битами mask. Блок читается целиком до записи,
+// поэтому out может перекрываться с in слева
+template <typename Type>
+inline void CompressStoreBlock(Type* out, const Type* in, uint32_t mask) noexcept
+{
+    if constexpr (sizeof(Type) == 4)
+    {
+        _mm512_mask_compressstoreu_epi32(out, static_cast<__mmask16>(mask), _mm512_loadu_si512(in));
+    }
+    else
+    {
+        _mm512_mask_compressstoreu_epi64(out, static_cast<__mmask8>(mask), _mm512_loadu_si512(in));
+    }
+}
+#endif
+
+// Переносит в начало [first, first + size) элементы, для которых predicate ложен, сохраняя их порядок.
+// Возвращает количество оставшихся элементов O(N).
+// Для арифметических типов запись безусловная: элемент пишется всегда, а позиция сдвигается на результат
+// предиката, поэтому в цикле нет непредсказуемых ветвлений. При сборке с AVX-512 для 4- и 8-байтовых типов
+// предикат заполняет маску блока из 64 байт, и оставшиеся элементы блока записываются одной командой сжатия
+template <typename Type, typename Predicate>
+size_t CompactRange(Type* first, size_t size, Predicate& predicate)
+{
+    if constexpr (std::is_arithmetic_v<Type>)
+    {
+        size_t kept = 0;
+        size_t i = 0;
+
+#if defined(__AVX512F__)
+        if constexpr (sizeof(Type) == 4 || sizeof(Type) == 8)
+        {
+            constexpr size_t kLanes = 64 / sizeof(Type);
+
+            for (; i + kLanes <= size; i += kLanes)
+            {
+                uint32_t mask = 0;
+                for (size_t lane = 0; lane < kLanes; ++lane)
+                {
+                    mask |= uint32_t(!static_cast<bool>(std::invoke(predicate, first[i + lane]))) << lane;
+                }
+                CompressStoreBlock(first + kept, first + i, mask);
+                kept += static_cast<size_t>(std::popcount(mask));
+            }
+        }
+#endif
+
+        for (; i < size; ++i)
+        {
+            const Type value = first[i];
+            first[kept] = value;
+            kept += !static_cast<bool>(std::invoke(predicate, value));
+        }
+        return kept;
+    }
+    else
+    {
+        return static_cast<size_t>(std::remove_if(first, first + size, std::ref(predicate)) - first);
+    }
+}
+
+//================================================================ Удаление ================================================================================
+
+// Удаляет все элементы, для которых predicate(element) истинен O(N)
+template <typename Type, typename Predicate>
+size_t erase_if(SimpleVector<Type>& vector, Predicate predicate)
+{
+    const size_t size = vector.get_size();
+    const size_t kept = CompactRange(vector.data(), size, predicate);
+
+    vector.resize(kept);
+    return size - kept;
+}
+
+// Удаляет все элементы, равные value O(N)
+template <typename Type, typename Value>
+size_t erase(SimpleVector<Type>& vector, const Value& value)
+{
+    return erase_if(vector, [&value](const Type& item) { return item == value; });
+}
+
+// Удаляет элементы с индексами из indices, которые должны строго возрастать O(N).
+// Индексы проверяются до переноса элементов, поэтому при исключении вектор не меняется;
+// indices обходится дважды
+template <typename Type, typename Indices>
+size_t remove_indices(SimpleVector<Type>& vector, const Indices& indices)
+{
+    const size_t size = vector.get_size();
+
+    bool first_index = true;
+    size_t previous = 0;
+    for (const size_t index : indices)
+    {
+        if (index >= size)
+        {
+            throw std::out_of_range("Index is out of range");
+        }
+        if (!first_index && index <= previous)
+        {
+            throw std::invalid_argument("Indices must be strictly increasing");
+        }
+        previous = index;
+        first_index = false;
+    }
+
+    Type* data = vector.data();
+    size_t kept = 0;
+    size_t next = 0;
+    for (const size_t index : indices)
+    {
+        // Между удаляемыми индексами элементы переносятся одним блоком
+        if (kept != next)
+        {
+            std::move(data + next, data + index, data + kept);
+        }
+        kept += index - next;
+        next = index + 1;
+    }
+
+    if (kept != next)
+    {
+        std::move(data + next, data + size, data + kept);
+    }
+    kept += size - next;
+
+    vector.resize(kept);
+    return size - kept;
+}
+
+// Оставляет первый элемент из каждой группы подряд идущих равных элементов O(N)
+template <typename Type, typename Equal = std::equal_to<>>
+size_t unique(SimpleVector<Type>& vector, Equal equal = {})
+{
+    const size_t size = vector.get_size();
+    const size_t kept = static_cast<size_t>(std::unique(vector.begin(), vector.end(), equal) - vector.begin());
+
+    vector.resize(kept);
+    return size - kept;
+}
+
+// Параллельный erase_if: вектор делится на thread_count частей, каждая сжимается в пуле потоков,
+// затем оставшиеся части сдвигаются друг к другу. Предикат вызывается из нескольких потоков одновременно.
+// O(N / P + K), где K - количество оставшихся элементов
+template <typename Type, typename Predicate>
+size_t parallel_erase_if(SimpleVector<Type>& vector, Predicate predicate,
+    size_t thread_count = DefaultThreadPool().get_thread_count(), ThreadPool& pool = DefaultThreadPool())
+{
+    const size_t size = vector.get_size();
+    if (thread_count < 2 || size < kParallelEraseThreshold)
+    {
+        return erase_if(vector, std::move(predicate));
+    }
+
+    Type* data = vector.data();
+    SimpleVector<size_t> kept(thread_count, 0);
+
+    parallel_for(0, thread_count, [&](size_t part_first, size_t part_last)
+        {
+            for (size_t part = part_first; part < part_last; ++part)
+            {
+                Predicate part_predicate = predicate;
+                const size_t first = size * part / thread_count;
+                const size_t last = size * (part + 1) / thread_count;
+                kept[part] = CompactRange(data + first, last - first, part_predicate);
+            }
+        }, 1, pool);
+
+    // Части сдвигаются влево по порядку, поэтому источник каждой ещё не затерт
+    size_t total = kept[0];
+    for (size_t part = 1; part < thread_count; ++part)
+    {
+        const size_t first = size * part / thread_count;
+        std::move(data + first, data + first + kept[part], data + total);
+        total += kept[part];
+    }
+
+    vector.resize(total);
+    return size - total;
+}
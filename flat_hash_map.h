@@ -0,0 +1,495 @@
+#pragma once
+
+#include "simple_vector.h"
+
+#include <bit>
+#include <cstdint>
+#include <functional>
+#include <iterator>
+#include <stdexcept>
+#include <utility>
+
+#if defined(__SSE2__) || defined(_M_X64) || defined(_M_AMD64)
+#include <emmintrin.h>
+#define FLAT_HASH_MAP_SSE2
+#endif
+
+// Группа управляющих байтов, просматриваемая за одну операцию сравнения
+class ControlGroup
+{
+public:
+
+    static constexpr size_t kSize = 16;
+
+    // Пустая ячейка. У занятых ячеек старший бит нулевой, младшие 7 битов хранят часть хеша
+    static constexpr int8_t kEmpty = -128;
+
+    explicit ControlGroup(const int8_t* control) noexcept : control(control) {}
+
+    // Битовая маска ячеек группы, управляющий байт которых равен h2 O(1)
+    uint32_t Match(int8_t h2) const noexcept
+    {
+#ifdef FLAT_HASH_MAP_SSE2
+        const __m128i group = _mm_loadu_si128(reinterpret_cast<const __m128i*>(control));
+        return static_cast<uint32_t>(_mm_movemask_epi8(_mm_cmpeq_epi8(group, _mm_set1_epi8(h2))));
+#else
+        uint32_t mask = 0;
+        for (size_t i = 0; i < kSize; ++i)
+        {
+            mask |= static_cast<uint32_t>(control[i] == h2) << i;
+        }
+        return mask;
+#endif
+    }
+
+    // Битовая маска пустых ячеек группы O(1)
+    uint32_t MatchEmpty() const noexcept
+    {
+#ifdef FLAT_HASH_MAP_SSE2
+        // У пустых ячеек и только у них установлен старший бит
+        const __m128i group = _mm_loadu_si128(reinterpret_cast<const __m128i*>(control));
+        return static_cast<uint32_t>(_mm_movemask_epi8(group));
+#else
+        return Match(kEmpty);
+#endif
+    }
+
+private:
+
+    const int8_t* control;
+};
+
+// Хеш-таблица с открытой адресацией в духе Swiss table: управляющие байты просматриваются группами по 16,
+// пары хранятся в одном непрерывном SimpleVector. Используется линейное пробирование, а удаление
+// сдвигает последующие элементы назад, поэтому надгробия не накапливаются и поиск промаха не деградирует
+template <typename Key, typename Value, typename Hash = std::hash<Key>, typename KeyEqual = std::equal_to<Key>>
+class FlatHashMap
+{
+public:
+
+    using Slot = std::pair<Key, Value>;
+
+    // Итератор по занятым ячейкам, разыменование дает пару ссылок на ключ и значение
+    template <bool IsConst>
+    class BasicIterator
+    {
+    public:
+
+        using MappedReference = std::conditional_t<IsConst, const Value&, Value&>;
+        using MapPointer = std::conditional_t<IsConst, const FlatHashMap*, FlatHashMap*>;
+
+        using iterator_category = std::forward_iterator_tag;
+        using value_type = std::pair<Key, Value>;
+        using difference_type = std::ptrdiff_t;
+        using reference = std::pair<const Key&, MappedReference>;
+
+        // Обертка, позволяющая писать it->first и it->second
+        class Pointer
+        {
+        public:
+
+            explicit Pointer(reference pair) : pair(pair) {}
+
+            const reference* operator->() const noexcept
+            {
+                return &pair;
+            }
+
+        private:
+
+            reference pair;
+        };
+
+        using pointer = Pointer;
+
+        BasicIterator() = default;
+
+        BasicIterator(MapPointer map, size_t index) noexcept : map(map), index(index)
+        {
+            SkipEmpty();
+        }
+
+        // Неконстантный итератор приводится к константному
+        operator BasicIterator<true>() const noexcept requires (!IsConst)
+        {
+            return BasicIterator<true>(map, index);
+        }
+
+        reference operator*() const noexcept
+        {
+            return reference(map->slots[index].first, map->slots[index].second);
+        }
+
+        Pointer operator->() const noexcept
+        {
+            return Pointer(**this);
+        }
+
+        BasicIterator& operator++() noexcept
+        {
+            ++index;
+            SkipEmpty();
+            return *this;
+        }
+
+        BasicIterator operator++(int) noexcept
+        {
+            BasicIterator temp(*this);
+            ++(*this);
+            return temp;
+        }
+
+        bool operator==(const BasicIterator& other) const noexcept
+        {
+            return index == other.index;
+        }
+
+        bool operator!=(const BasicIterator& other) const noexcept
+        {
+            return index != other.index;
+        }
+
+    private:
+
+        MapPointer map = nullptr;
+        size_t index = 0;
+
+        void SkipEmpty() noexcept
+        {
+            while (index < map->slots.get_size() && map->control[index] == ControlGroup::kEmpty)
+            {
+                ++index;
+            }
+        }
+    };
+
+    using Iterator = BasicIterator<false>;
+    using ConstIterator = BasicIterator<true>;
+
+//===================================================================== Конструкторы и деструктор ==========================================================
+
+    FlatHashMap() = default;
+
+    // Создает таблицу, вмещающую count элементов без перехеширования
+    explicit FlatHashMap(size_t count)
+    {
+        reserve(count);
+    }
+
+    // Создает таблицу с помощью {}
+    FlatHashMap(std::initializer_list<Slot> init)
+    {
+        reserve(init.size());
+        for (const Slot& slot : init)
+        {
+            insert(slot.first, slot.second);
+        }
+    }
+
+//================================================================ Операторы ===============================================================================
+
+    // Значение по ключу, отсутствующий ключ вставляется со значением по умолчанию O(1) в среднем
+    Value& operator[](const Key& key)
+    {
+        return insert(key, Value()).first->second;
+    }
+
+//===================================================================== Итераторы ==========================================================================
+
+    Iterator begin() noexcept
+    {
+        return Iterator(this, 0);
+    }
+
+    Iterator end() noexcept
+    {
+        return Iterator(this, slots.get_size());
+    }
+
+    ConstIterator begin() const noexcept
+    {
+        return ConstIterator(this, 0);
+    }
+
+    ConstIterator end() const noexcept
+    {
+        return ConstIterator(this, slots.get_size());
+    }
+
+//===================================================================== Методы =============================================================================
+
+//------------------------------------------------------------- Заполнение и добавление --------------------------------------------------------------------
+
+    // Вставка пары, существующее значение не изменяется O(1) в среднем
+    std::pair<Iterator, bool> insert(const Key& key, const Value& value)
+    {
+        const uint64_t hash = HashOf(key);
+
+        const size_t found = FindIndex(key, hash);
+        if (found != slots.get_size())
+        {
+            return { Iterator(this, found), false };
+        }
+
+        // Пара строится до перехеширования: key и value могут ссылаться на элементы самой таблицы
+        Slot slot(key, value);
+        if (size + 1 > MaxLoad(slots.get_size()))
+        {
+            Rehash(std::max(kMinCapacity, slots.get_size() * 2));
+        }
+
+        const size_t index = FindEmptyIndex(hash);
+        slots[index] = std::move(slot);
+        SetControl(index, H2(hash));
+        ++size;
+
+        return { Iterator(this, index), true };
+    }
+
+    // Вставка пары с заменой существующего значения O(1) в среднем
+    std::pair<Iterator, bool> insert_or_assign(const Key& key, const Value& value)
+    {
+        auto result = insert(key, value);
+        if (!result.second)
+        {
+            result.first->second = value;
+        }
+        return result;
+    }
+
+//-------------------------------------------------------------- Получение значений ------------------------------------------------------------------------
+
+    // Поиск по ключу, end() при отсутствии O(1) в среднем
+    Iterator find(const Key& key)
+    {
+        return Iterator(this, FindIndex(key, HashOf(key)));
+    }
+
+    // Поиск по ключу, end() при отсутствии O(1) в среднем
+    ConstIterator find(const Key& key) const
+    {
+        return ConstIterator(this, FindIndex(key, HashOf(key)));
+    }
+
+    // Проверка наличия ключа O(1) в среднем
+    bool contains(const Key& key) const
+    {
+        return FindIndex(key, HashOf(key)) != slots.get_size();
+    }
+
+    // Значение по ключу с проверкой наличия O(1) в среднем
+    Value& at(const Key& key)
+    {
+        const size_t index = FindIndex(key, HashOf(key));
+        if (index == slots.get_size())
+        {
+            throw std::out_of_range("Key not found");
+        }
+        return slots[index].second;
+    }
+
+    // Константное значение по ключу с проверкой наличия O(1) в среднем
+    const Value& at(const Key& key) const
+    {
+        const size_t index = FindIndex(key, HashOf(key));
+        if (index == slots.get_size())
+        {
+            throw std::out_of_range("Key not found");
+        }
+        return slots[index].second;
+    }
+
+    // Количество элементов O(1)
+    size_t get_size() const noexcept
+    {
+        return size;
+    }
+
+    // Проверка на пустоту O(1)
+    bool is_empty() const noexcept
+    {
+        return size == 0;
+    }
+
+    // Количество ячеек O(1)
+    size_t get_capacity() const noexcept
+    {
+        return slots.get_size();
+    }
+
+//------------------------------------------------------------------- Работа с размером --------------------------------------------------------------------
+
+    // Резервирование ячеек под count элементов одним перехешированием O(N)
+    void reserve(size_t count)
+    {
+        size_t capacity = kMinCapacity;
+        while (MaxLoad(capacity) < count)
+        {
+            capacity *= 2;
+        }
+        if (capacity > slots.get_size())
+        {
+            Rehash(capacity);
+        }
+    }
+
+//------------------------------------------------------------------------ Очистка и удаление --------------------------------------------------------------
+
+    // Удаление по ключу со сдвигом последующих элементов цепочки назад O(1) в среднем
+    size_t erase(const Key& key)
+    {
+        size_t hole = FindIndex(key, HashOf(key));
+        if (hole == slots.get_size())
+        {
+            return 0;
+        }
+
+        const size_t mask = slots.get_size() - 1;
+        for (size_t next = (hole + 1) & mask; control[next] != ControlGroup::kEmpty; next = (next + 1) & mask)
+        {
+            // Элемент переносится в дыру, если его домашняя ячейка не лежит между дырой и им самим
+            const size_t home = H1(HashOf(slots[next].first)) & mask;
+            if (((next - home) & mask) >= ((next - hole) & mask))
+            {
+                slots[hole] = std::move(slots[next]);
+                SetControl(hole, control[next]);
+                hole = next;
+            }
+        }
+
+        slots[hole] = Slot();
+        SetControl(hole, ControlGroup::kEmpty);
+        --size;
+
+        return 1;
+    }
+
+    // Очистить таблицу, сохранив ячейки O(N)
+    void clear()
+    {
+        std::fill(control.begin(), control.end(), ControlGroup::kEmpty);
+        std::fill(slots.begin(), slots.end(), Slot());
+        size = 0;
+    }
+
+    // Обмен значений O(1)
+    void swap(FlatHashMap& other) noexcept
+    {
+        slots.swap(other.slots);
+        control.swap(other.control);
+        std::swap(size, other.size);
+    }
+
+private:
+
+    static constexpr size_t kMinCapacity = ControlGroup::kSize;
+
+    // Ячейки; количество всегда степень двойки или ноль
+    SimpleVector<Slot> slots;
+    // Управляющие байты; первые kSize байтов продублированы в конце, чтобы группа читалась без переноса
+    SimpleVector<int8_t> control;
+    size_t size = 0;
+    Hash hasher;
+    KeyEqual equal;
+
+    // Допустимое количество элементов при загрузке 7/8 O(1)
+    static size_t MaxLoad(size_t capacity) noexcept
+    {
+        return capacity - capacity / 8;
+    }
+
+    // Перемешивание хеша, чтобы тождественные std::hash давали равномерные младшие и старшие биты O(1)
+    uint64_t HashOf(const Key& key) const
+    {
+        uint64_t hash = static_cast<uint64_t>(hasher(key)) * 0x9E3779B97F4A7C15ull;
+        return hash ^ (hash >> 29);
+    }
+
+    // Часть хеша, определяющая домашнюю ячейку
+    static size_t H1(uint64_t hash) noexcept
+    {
+        return static_cast<size_t>(hash >> 7);
+    }
+
+    // Часть хеша, хранимая в управляющем байте
+    static int8_t H2(uint64_t hash) noexcept
+    {
+        return static_cast<int8_t>(hash & 0x7F);
+    }
+
+    void SetControl(size_t index, int8_t value) noexcept
+    {
+        control[index] = value;
+        if (index < ControlGroup::kSize)
+        {
+            control[slots.get_size() + index] = value;
+        }
+    }
+
+    // Индекс ячейки с ключом или количество ячеек при отсутствии O(1) в среднем
+    size_t FindIndex(const Key& key, uint64_t hash) const
+    {
+        if (size == 0)
+        {
+            return slots.get_size();
+        }
+
+        const size_t mask = slots.get_size() - 1;
+        const int8_t h2 = H2(hash);
+
+        for (size_t position = H1(hash) & mask;; position = (position + ControlGroup::kSize) & mask)
+        {
+            const ControlGroup group(control.data() + position);
+
+            for (uint32_t match = group.Match(h2); match != 0; match &= match - 1)
+            {
+                const size_t index = (position + std::countr_zero(match)) & mask;
+                if (equal(slots[index].first, key))
+                {
+                    return index;
+                }
+            }
+            if (group.MatchEmpty() != 0)
+            {
+                return slots.get_size();
+            }
+        }
+    }
+
+    // Первая пустая ячейка по ходу линейного пробирования от домашней O(1) в среднем
+    size_t FindEmptyIndex(uint64_t hash) const noexcept
+    {
+        const size_t mask = slots.get_size() - 1;
+
+        for (size_t position = H1(hash) & mask;; position = (position + ControlGroup::kSize) & mask)
+        {
+            const uint32_t empty = ControlGroup(control.data() + position).MatchEmpty();
+            if (empty != 0)
+            {
+                return (position + std::countr_zero(empty)) & mask;
+            }
+        }
+    }
+
+    // Перенос всех элементов в таблицу из new_capacity ячеек O(N)
+    void Rehash(size_t new_capacity)
+    {
+        SimpleVector<Slot> old_slots(new_capacity);
+        SimpleVector<int8_t> old_control(new_capacity + ControlGroup::kSize, ControlGroup::kEmpty);
+
+        slots.swap(old_slots);
+        control.swap(old_control);
+
+        for (size_t i = 0; i < old_slots.get_size(); ++i)
+        {
+            if (old_control[i] != ControlGroup::kEmpty)
+            {
+                const uint64_t hash = HashOf(old_slots[i].first);
+                const size_t index = FindEmptyIndex(hash);
+
+                slots[index] = std::move(old_slots[i]);
+                SetControl(index, H2(hash));
+            }
+        }
+    }
+};
@@ -0,0 +1,432 @@
+#pragma once
+
+#include "flat_set.h"
+
+#include <initializer_list>
+#include <iterator>
+#include <stdexcept>
+#include <utility>
+
+// Упорядоченный словарь поверх двух SimpleVector: отсортированные ключи и значения хранятся
+// в отдельных столбцах, поэтому бинарный поиск проходит только по плотному массиву ключей
+template <typename Key, typename Value, typename Compare = std::less<Key>>
+class FlatMap
+{
+public:
+
+    // Итератор по парам ключ-значение, разыменование дает пару ссылок на оба столбца
+    template <bool IsConst>
+    class BasicIterator
+    {
+    public:
+
+        using MappedReference = std::conditional_t<IsConst, const Value&, Value&>;
+        using MapPointer = std::conditional_t<IsConst, const FlatMap*, FlatMap*>;
+
+        using iterator_category = std::random_access_iterator_tag;
+        using value_type = std::pair<Key, Value>;
+        using difference_type = std::ptrdiff_t;
+        using reference = std::pair<const Key&, MappedReference>;
+
+        // Обертка, позволяющая писать it->first и it->second
+        class Pointer
+        {
+        public:
+
+            explicit Pointer(reference pair) : pair(pair) {}
+
+            const reference* operator->() const noexcept
+            {
+                return &pair;
+            }
+
+        private:
+
+            reference pair;
+        };
+
+        using pointer = Pointer;
+
+        BasicIterator() = default;
+
+        BasicIterator(MapPointer map, size_t index) noexcept : map(map), index(index) {}
+
+        // Неконстантный итератор приводится к константному
+        operator BasicIterator<true>() const noexcept requires (!IsConst)
+        {
+            return BasicIterator<true>(map, index);
+        }
+
+        reference operator*() const noexcept
+        {
+            return reference(map->keys[index], map->mapped[index]);
+        }
+
+        Pointer operator->() const noexcept
+        {
+            return Pointer(**this);
+        }
+
+        reference operator[](difference_type offset) const noexcept
+        {
+            return *(*this + offset);
+        }
+
+        BasicIterator& operator++() noexcept
+        {
+            ++index;
+            return *this;
+        }
+
+        BasicIterator operator++(int) noexcept
+        {
+            BasicIterator temp(*this);
+            ++index;
+            return temp;
+        }
+
+        BasicIterator& operator--() noexcept
+        {
+            --index;
+            return *this;
+        }
+
+        BasicIterator operator--(int) noexcept
+        {
+            BasicIterator temp(*this);
+            --index;
+            return temp;
+        }
+
+        BasicIterator& operator+=(difference_type offset) noexcept
+        {
+            index += offset;
+            return *this;
+        }
+
+        BasicIterator operator+(difference_type offset) const noexcept
+        {
+            return BasicIterator(map, index + offset);
+        }
+
+        BasicIterator operator-(difference_type offset) const noexcept
+        {
+            return BasicIterator(map, index - offset);
+        }
+
+        difference_type operator-(const BasicIterator& other) const noexcept
+        {
+            return static_cast<difference_type>(index) - static_cast<difference_type>(other.index);
+        }
+
+        bool operator==(const BasicIterator& other) const noexcept
+        {
+            return index == other.index;
+        }
+
+        bool operator!=(const BasicIterator& other) const noexcept
+        {
+            return index != other.index;
+        }
+
+        bool operator<(const BasicIterator& other) const noexcept
+        {
+            return index < other.index;
+        }
+
+        // Позиция в столбцах O(1)
+        size_t get_index() const noexcept
+        {
+            return index;
+        }
+
+    private:
+
+        MapPointer map = nullptr;
+        size_t index = 0;
+    };
+
+    using Iterator = BasicIterator<false>;
+    using ConstIterator = BasicIterator<true>;
+
+//===================================================================== Конструкторы и деструктор ==========================================================
+
+    FlatMap() = default;
+
+    explicit FlatMap(const Compare& compare) : compare(compare) {}
+
+    // Построение из неупорядоченных пар. Для повторяющихся ключей остается первое значение O(N*log(N))
+    explicit FlatMap(SimpleVector<std::pair<Key, Value>> pairs, const Compare& compare = Compare()) : compare(compare)
+    {
+        const size_t count = Search::SortUnique(pairs.data(), pairs.get_size(), compare, KeyOf());
+        AssignColumns(pairs.data(), pairs.data() + count);
+    }
+
+    // Создает словарь с помощью {}
+    FlatMap(std::initializer_list<std::pair<Key, Value>> init, const Compare& compare = Compare())
+        : FlatMap(SimpleVector<std::pair<Key, Value>>(init), compare) {}
+
+//================================================================ Операторы ===============================================================================
+
+    // Значение по ключу, отсутствующий ключ вставляется со значением по умолчанию O(N)
+    Value& operator[](const Key& key)
+    {
+        return insert(key, Value()).first->second;
+    }
+
+//===================================================================== Итераторы ==========================================================================
+
+    Iterator begin() noexcept
+    {
+        return Iterator(this, 0);
+    }
+
+    Iterator end() noexcept
+    {
+        return Iterator(this, keys.get_size());
+    }
+
+    ConstIterator begin() const noexcept
+    {
+        return ConstIterator(this, 0);
+    }
+
+    ConstIterator end() const noexcept
+    {
+        return ConstIterator(this, keys.get_size());
+    }
+
+//===================================================================== Методы =============================================================================
+
+//------------------------------------------------------------- Заполнение и добавление --------------------------------------------------------------------
+
+    // Вставка пары, существующее значение не изменяется O(N)
+    std::pair<Iterator, bool> insert(const Key& key, const Value& value)
+    {
+        const size_t index = LowerBoundIndex(key);
+        if (index != keys.get_size() && !compare(key, keys[index]))
+        {
+            return { Iterator(this, index), false };
+        }
+
+        // Если вставка значения бросит исключение, ключ убирается, и столбцы остаются одной длины
+        keys.insert(keys.begin() + index, key);
+        try
+        {
+            mapped.insert(mapped.begin() + index, value);
+        }
+        catch (...)
+        {
+            keys.erase(keys.begin() + index);
+            throw;
+        }
+        return { Iterator(this, index), true };
+    }
+
+    // Вставка пары с заменой существующего значения O(N)
+    std::pair<Iterator, bool> insert_or_assign(const Key& key, const Value& value)
+    {
+        auto [position, inserted] = insert(key, value);
+        if (!inserted)
+        {
+            mapped[position.get_index()] = value;
+        }
+        return { position, inserted };
+    }
+
+    // Вставка диапазона пар одним слиянием вместо сдвига хвоста на каждую пару.
+    // Для ключей, уже присутствующих в словаре, сохраняется старое значение O(N + M*log(M))
+    template <typename InputIterator>
+    void insert_range(InputIterator first, InputIterator last)
+    {
+        SimpleVector<std::pair<Key, Value>> incoming;
+        incoming.append_range(first, last);
+        incoming.resize(Search::SortUnique(incoming.data(), incoming.get_size(), compare, KeyOf()));
+
+        SimpleVector<Key> merged_keys;
+        SimpleVector<Value> merged_values;
+        merged_keys.reserve(keys.get_size() + incoming.get_size());
+        merged_values.reserve(keys.get_size() + incoming.get_size());
+
+        size_t lhs = 0;
+        size_t rhs = 0;
+
+        while (lhs < keys.get_size() || rhs < incoming.get_size())
+        {
+            const bool take_incoming = lhs == keys.get_size()
+                || (rhs < incoming.get_size() && compare(incoming[rhs].first, keys[lhs]));
+
+            if (take_incoming)
+            {
+                merged_keys.push_back(std::move(incoming[rhs].first));
+                merged_values.push_back(std::move(incoming[rhs].second));
+                ++rhs;
+                continue;
+            }
+
+            if (rhs < incoming.get_size() && !compare(keys[lhs], incoming[rhs].first))
+            {
+                ++rhs;
+            }
+            merged_keys.push_back(std::move(keys[lhs]));
+            merged_values.push_back(std::move(mapped[lhs]));
+            ++lhs;
+        }
+
+        keys.swap(merged_keys);
+        mapped.swap(merged_values);
+    }
+
+//-------------------------------------------------------------- Получение значений ------------------------------------------------------------------------
+
+    // Поиск по ключу, end() при отсутствии O(log(N))
+    Iterator find(const Key& key)
+    {
+        const size_t index = FindIndex(key);
+        return Iterator(this, index);
+    }
+
+    // Поиск по ключу, end() при отсутствии O(log(N))
+    ConstIterator find(const Key& key) const
+    {
+        const size_t index = FindIndex(key);
+        return ConstIterator(this, index);
+    }
+
+    // Первый элемент с ключом, не меньшим key O(log(N))
+    ConstIterator lower_bound(const Key& key) const
+    {
+        return ConstIterator(this, LowerBoundIndex(key));
+    }
+
+    // Значение по ключу с проверкой наличия O(log(N))
+    Value& at(const Key& key)
+    {
+        const size_t index = FindIndex(key);
+        if (index == keys.get_size())
+        {
+            throw std::out_of_range("Key not found");
+        }
+        return mapped[index];
+    }
+
+    // Константное значение по ключу с проверкой наличия O(log(N))
+    const Value& at(const Key& key) const
+    {
+        const size_t index = FindIndex(key);
+        if (index == keys.get_size())
+        {
+            throw std::out_of_range("Key not found");
+        }
+        return mapped[index];
+    }
+
+    // Проверка наличия ключа O(log(N))
+    bool contains(const Key& key) const
+    {
+        return FindIndex(key) != keys.get_size();
+    }
+
+    // Количество элементов O(1)
+    size_t get_size() const noexcept
+    {
+        return keys.get_size();
+    }
+
+    // Проверка на пустоту O(1)
+    bool is_empty() const noexcept
+    {
+        return keys.is_empty();
+    }
+
+    // Столбец отсортированных ключей O(1)
+    const SimpleVector<Key>& key_column() const noexcept
+    {
+        return keys;
+    }
+
+    // Столбец значений в порядке ключей O(1)
+    const SimpleVector<Value>& value_column() const noexcept
+    {
+        return mapped;
+    }
+
+//------------------------------------------------------------------- Работа с размером --------------------------------------------------------------------
+
+    // Резервирование места в обоих столбцах O(N)
+    void reserve(size_t capacity)
+    {
+        keys.reserve(capacity);
+        mapped.reserve(capacity);
+    }
+
+//------------------------------------------------------------------------ Очистка и удаление --------------------------------------------------------------
+
+    // Удаление по ключу, возвращает количество удаленных элементов O(N)
+    size_t erase(const Key& key)
+    {
+        const size_t index = FindIndex(key);
+        if (index == keys.get_size())
+        {
+            return 0;
+        }
+        keys.erase(keys.begin() + index);
+        mapped.erase(mapped.begin() + index);
+        return 1;
+    }
+
+    // Очистить словарь O(1)
+    void clear() noexcept
+    {
+        keys.clear();
+        mapped.clear();
+    }
+
+    // Обмен значений O(1)
+    void swap(FlatMap& other) noexcept
+    {
+        keys.swap(other.keys);
+        mapped.swap(other.mapped);
+        std::swap(compare, other.compare);
+    }
+
+private:
+
+    using Search = SortedSearch<Key, Compare>;
+
+    struct KeyOf
+    {
+        const Key& operator()(const std::pair<Key, Value>& pair) const noexcept
+        {
+            return pair.first;
+        }
+    };
+
+    SimpleVector<Key> keys;
+    SimpleVector<Value> mapped;
+    Compare compare;
+
+    size_t LowerBoundIndex(const Key& key) const
+    {
+        return Search::LowerBound(keys.data(), keys.get_size(), key, compare) - keys.data();
+    }
+
+    // Индекс ключа или размер словаря при отсутствии O(log(N))
+    size_t FindIndex(const Key& key) const
+    {
+        const size_t index = LowerBoundIndex(key);
+        return index != keys.get_size() && !compare(key, keys[index]) ? index : keys.get_size();
+    }
+
+    // Раскладывает отсортированные уникальные пары по столбцам O(N)
+    void AssignColumns(std::pair<Key, Value>* first, std::pair<Key, Value>* last)
+    {
+        keys.reserve(last - first);
+        mapped.reserve(last - first);
+        for (; first != last; ++first)
+        {
+            keys.push_back(std::move(first->first));
+            mapped.push_back(std::move(first->second));
+        }
+    }
+};
@@ -0,0 +1,271 @@
+#pragma once
+
+#include "simple_vector.h"
+
+#include <algorithm>
+#include <functional>
+#include <initializer_list>
+#include <utility>
+
+// Поиск в отсортированном непрерывном массиве
+template <typename Key, typename Compare>
+class SortedSearch
+{
+public:
+
+    // Первый элемент, не меньший key. Без ветвлений внутри цикла: каждая итерация
+    // сокращает диапазон вдвое условным сдвигом, который компилятор превращает в cmov O(log(N))
+    static const Key* LowerBound(const Key* first, size_t count, const Key& key, const Compare& compare)
+    {
+        if (count == 0)
+        {
+            return first;
+        }
+
+        const Key* base = first;
+        while (count > 1)
+        {
+            const size_t half = count / 2;
+            base = compare(base[half], key) ? base + half : base;
+            count -= half;
+        }
+        return base + (compare(*base, key) ? 1 : 0);
+    }
+
+    // Первый элемент, больший key O(log(N))
+    static const Key* UpperBound(const Key* first, size_t count, const Key& key, const Compare& compare)
+    {
+        return std::upper_bound(first, first + count, key, compare);
+    }
+
+    // Сортирует последовательность и удаляет повторы, возвращает новый размер O(N*log(N))
+    template <typename Type, typename Projection>
+    static size_t SortUnique(Type* first, size_t count, const Compare& compare, Projection project)
+    {
+        std::stable_sort(first, first + count, [&](const Type& lhs, const Type& rhs) { return compare(project(lhs), project(rhs)); });
+
+        const Type* last = std::unique(first, first + count, [&](const Type& lhs, const Type& rhs)
+            {
+                return !compare(project(lhs), project(rhs)) && !compare(project(rhs), project(lhs));
+            });
+        return last - first;
+    }
+};
+
+// Упорядоченное множество поверх отсортированного SimpleVector:
+// поиск идет по непрерывной памяти без переходов по указателям узлов
+template <typename Key, typename Compare = std::less<Key>>
+class FlatSet
+{
+public:
+
+    using Iterator = const Key*;
+    using ConstIterator = const Key*;
+
+//===================================================================== Конструкторы и деструктор ==========================================================
+
+    FlatSet() = default;
+
+    explicit FlatSet(const Compare& compare) : compare(compare) {}
+
+    // Построение из неупорядоченных значений сортировкой с удалением повторов O(N*log(N))
+    explicit FlatSet(SimpleVector<Key> values, const Compare& compare = Compare()) : keys(std::move(values)), compare(compare)
+    {
+        keys.resize(Search::SortUnique(keys.data(), keys.get_size(), compare, Identity()));
+    }
+
+    // Создает множество с помощью {}
+    FlatSet(std::initializer_list<Key> init, const Compare& compare = Compare()) : FlatSet(SimpleVector<Key>(init), compare) {}
+
+//===================================================================== Итераторы ==========================================================================
+
+    ConstIterator begin() const noexcept
+    {
+        return keys.data();
+    }
+
+    ConstIterator end() const noexcept
+    {
+        return keys.data() + keys.get_size();
+    }
+
+//===================================================================== Методы =============================================================================
+
+//------------------------------------------------------------- Заполнение и добавление --------------------------------------------------------------------
+
+    // Вставка одного значения со сдвигом хвоста O(N)
+    std::pair<Iterator, bool> insert(const Key& key)
+    {
+        const Key* position = lower_bound(key);
+        if (position != end() && !compare(key, *position))
+        {
+            return { position, false };
+        }
+
+        const size_t index = position - begin();
+        keys.insert(keys.begin() + index, key);
+        return { begin() + index, true };
+    }
+
+    // Вставка диапазона: новые значения сортируются отдельно и сливаются с текущими
+    // за один проход вместо сдвига хвоста на каждое значение O(N + M*log(M))
+    template <typename InputIterator>
+    void insert_range(InputIterator first, InputIterator last)
+    {
+        SimpleVector<Key> incoming;
+        incoming.append_range(first, last);
+        incoming.resize(Search::SortUnique(incoming.data(), incoming.get_size(), compare, Identity()));
+
+        SimpleVector<Key> merged;
+        merged.reserve(keys.get_size() + incoming.get_size());
+
+        Key* lhs = keys.data();
+        Key* rhs = incoming.data();
+        Key* const lhs_last = keys.data() + keys.get_size();
+        Key* const rhs_last = incoming.data() + incoming.get_size();
+
+        while (lhs != lhs_last && rhs != rhs_last)
+        {
+            if (compare(*lhs, *rhs))
+            {
+                merged.push_back(std::move(*lhs++));
+            }
+            else if (compare(*rhs, *lhs))
+            {
+                merged.push_back(std::move(*rhs++));
+            }
+            else
+            {
+                merged.push_back(std::move(*lhs++));
+                ++rhs;
+            }
+        }
+        merged.append_range(std::make_move_iterator(lhs), std::make_move_iterator(lhs_last));
+        merged.append_range(std::make_move_iterator(rhs), std::make_move_iterator(rhs_last));
+
+        keys.swap(merged);
+    }
+
+//-------------------------------------------------------------- Получение значений ------------------------------------------------------------------------
+
+    // Первый элемент, не меньший key O(log(N))
+    ConstIterator lower_bound(const Key& key) const
+    {
+        return Search::LowerBound(keys.data(), keys.get_size(), key, compare);
+    }
+
+    // Первый элемент, больший key O(log(N))
+    ConstIterator upper_bound(const Key& key) const
+    {
+        return Search::UpperBound(keys.data(), keys.get_size(), key, compare);
+    }
+
+    // Поиск значения, end() при отсутствии O(log(N))
+    ConstIterator find(const Key& key) const
+    {
+        const Key* position = lower_bound(key);
+        return position != end() && !compare(key, *position) ? position : end();
+    }
+
+    // Проверка наличия значения O(log(N))
+    bool contains(const Key& key) const
+    {
+        return find(key) != end();
+    }
+
+    // Количество элементов, равных key (0 или 1) O(log(N))
+    size_t count(const Key& key) const
+    {
+        return contains(key) ? 1 : 0;
+    }
+
+    // Количество элементов O(1)
+    size_t get_size() const noexcept
+    {
+        return keys.get_size();
+    }
+
+    // Проверка на пустоту O(1)
+    bool is_empty() const noexcept
+    {
+        return keys.is_empty();
+    }
+
+    // Отсортированные значения O(1)
+    const SimpleVector<Key>& values() const noexcept
+    {
+        return keys;
+    }
+
+//------------------------------------------------------------------- Работа с размером --------------------------------------------------------------------
+
+    // Резервирование места O(N)
+    void reserve(size_t capacity)
+    {
+        keys.reserve(capacity);
+    }
+
+//------------------------------------------------------------------------ Очистка и удаление --------------------------------------------------------------
+
+    // Удаление значения, возвращает количество удаленных элементов O(N)
+    size_t erase(const Key& key)
+    {
+        const Key* position = find(key);
+        if (position == end())
+        {
+            return 0;
+        }
+        erase(position);
+        return 1;
+    }
+
+    // Удаление элемента по итератору O(N)
+    Iterator erase(ConstIterator position)
+    {
+        const size_t index = position - begin();
+        keys.erase(keys.begin() + index);
+        return begin() + index;
+    }
+
+    // Очистить множество O(1)
+    void clear() noexcept
+    {
+        keys.clear();
+    }
+
+    // Обмен значений O(1)
+    void swap(FlatSet& other) noexcept
+    {
+        keys.swap(other.keys);
+        std::swap(compare, other.compare);
+    }
+
+private:
+
+    using Search = SortedSearch<Key, Compare>;
+
+    struct Identity
+    {
+        const Key& operator()(const Key& key) const noexcept
+        {
+            return key;
+        }
+    };
+
+    SimpleVector<Key> keys;
+    Compare compare;
+};
+
+//================================================= Блок перегруженных операторов =========================================================
+
+template <typename Key, typename Compare>
+inline bool operator==(const FlatSet<Key, Compare>& lhs, const FlatSet<Key, Compare>& rhs)
+{
+    return lhs.values() == rhs.values();
+}
+
+template <typename Key, typename Compare>
+inline bool operator!=(const FlatSet<Key, Compare>& lhs, const FlatSet<Key, Compare>& rhs)
+{
+    return !(lhs == rhs);
+}
@@ -0,0 +1,83 @@
+// Цель для фаззинга SimpleVector: сравнение со std::vector на последовательностях операций из differential_test.h.
+//
+// Сборка с libFuzzer:
+//     clang++ -std=c++20 -g -O1 -fsanitize=fuzzer,address,undefined -DSIMPLE_VECTOR_LIBFUZZER fuzz_simple_vector.cpp -o fuzz_simple_vector
+//     ./fuzz_simple_vector corpus/
+//
+// Сборка без libFuzzer (любой компилятор C++20):
+//     g++ -std=c++20 -g -O1 -fsanitize=address,undefined fuzz_simple_vector.cpp -o fuzz_simple_vector
+//     ./fuzz_simple_vector crash-file ...     - повторить найденные входные данные
+//     ./fuzz_simple_vector                    - 10000 прогонов на псевдослучайных данных
+//     ./fuzz_simple_vector -runs=N -seed=S    - N прогонов с начальным значением S
+
+#include "differential_test.h"
+
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <iterator>
+#include <random>
+#include <string>
+#include <vector>
+
+extern "C" int LLVMFuzzerTestOneInput(const uint8_t* data, size_t size)
+{
+    RunDifferentialTest(data, size);
+    return 0;
+}
+
+#if !defined(SIMPLE_VECTOR_LIBFUZZER)
+
+int main(int argc, char* argv[])
+{
+    size_t runs = 10000;
+    unsigned seed = std::random_device()();
+    bool has_files = false;
+
+    for (int i = 1; i < argc; ++i)
+    {
+        if (std::strncmp(argv[i], "-runs=", 6) == 0)
+        {
+            runs = std::stoul(argv[i] + 6);
+        }
+        else if (std::strncmp(argv[i], "-seed=", 6) == 0)
+        {
+            seed = static_cast<unsigned>(std::stoul(argv[i] + 6));
+        }
+        else
+        {
+            std::ifstream file(argv[i], std::ios::binary);
+            if (!file)
+            {
+                std::cerr << "Cannot open " << argv[i] << std::endl;
+                return 1;
+            }
+            const std::vector<uint8_t> data((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+            LLVMFuzzerTestOneInput(data.data(), data.size());
+            has_files = true;
+        }
+    }
+
+    if (has_files)
+    {
+        return 0;
+    }
+
+    std::cout << "Seed: " << seed << std::endl;
+    std::mt19937 generator(seed);
+    std::vector<uint8_t> data;
+    for (size_t run = 0; run < runs; ++run)
+    {
+        data.resize(generator() % 4096);
+        for (uint8_t& byte : data)
+        {
+            byte = static_cast<uint8_t>(generator());
+        }
+        LLVMFuzzerTestOneInput(data.data(), data.size());
+    }
+    std::cout << runs << " runs passed" << std::endl;
+    return 0;
+}
+
+#endif
@@ -0,0 +1,465 @@
+#pragma once
+
+#include "raw_memory.h"
+
+#include <algorithm>
+#include <cassert>
+#include <cstring>
+#include <initializer_list>
+#include <iterator>
+#include <memory>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+
+// Буфер с разрывом: свободное место хранится не в конце, а в точке последней правки.
+// Вставки и удаления рядом с этой точкой выполняются за O(1), перенос разрыва стоит
+// столько, сколько элементов лежит между старой и новой позицией.
+// Ячейки разрыва не содержат объектов: удаленный элемент уничтожается сразу
+template <typename Type>
+class GapBuffer
+{
+public:
+
+    // Итератор произвольного доступа в обход разрыва
+    template <bool IsConst>
+    class BasicIterator
+    {
+    public:
+
+        using BufferPointer = std::conditional_t<IsConst, const GapBuffer*, GapBuffer*>;
+
+        using iterator_category = std::random_access_iterator_tag;
+        using value_type = Type;
+        using difference_type = std::ptrdiff_t;
+        using pointer = std::conditional_t<IsConst, const Type*, Type*>;
+        using reference = std::conditional_t<IsConst, const Type&, Type&>;
+
+        BasicIterator() = default;
+
+        BasicIterator(BufferPointer buffer, size_t index) noexcept : buffer(buffer), index(index) {}
+
+        reference operator*() const noexcept
+        {
+            return (*buffer)[index];
+        }
+
+        pointer operator->() const noexcept
+        {
+            return &(*buffer)[index];
+        }
+
+        BasicIterator& operator++() noexcept
+        {
+            ++index;
+            return *this;
+        }
+
+        BasicIterator operator++(int) noexcept
+        {
+            BasicIterator temp(*this);
+            ++index;
+            return temp;
+        }
+
+        BasicIterator& operator--() noexcept
+        {
+            --index;
+            return *this;
+        }
+
+        BasicIterator operator--(int) noexcept
+        {
+            BasicIterator temp(*this);
+            --index;
+            return temp;
+        }
+
+        BasicIterator& operator+=(difference_type offset) noexcept
+        {
+            index += offset;
+            return *this;
+        }
+
+        BasicIterator operator+(difference_type offset) const noexcept
+        {
+            return BasicIterator(buffer, index + offset);
+        }
+
+        BasicIterator operator-(difference_type offset) const noexcept
+        {
+            return BasicIterator(buffer, index - offset);
+        }
+
+        difference_type operator-(const BasicIterator& other) const noexcept
+        {
+            return static_cast<difference_type>(index) - static_cast<difference_type>(other.index);
+        }
+
+        bool operator==(const BasicIterator& other) const noexcept
+        {
+            return index == other.index;
+        }
+
+        bool operator!=(const BasicIterator& other) const noexcept
+        {
+            return index != other.index;
+        }
+
+        bool operator<(const BasicIterator& other) const noexcept
+        {
+            return index < other.index;
+        }
+
+    private:
+
+        BufferPointer buffer = nullptr;
+        size_t index = 0;
+    };
+
+    using Iterator = BasicIterator<false>;
+    using ConstIterator = BasicIterator<true>;
+
+//===================================================================== Конструкторы и деструктор ==========================================================
+
+    GapBuffer() noexcept = default;
+
+    // Создает буфер с помощью {}, разрыв располагается в конце
+    GapBuffer(std::initializer_list<Type> init)
+    {
+        Append(init.begin(), init.end(), init.size());
+    }
+
+    // Конструктор копирования O(N)
+    GapBuffer(const GapBuffer& other)
+    {
+        Append(other.begin(), other.end(), other.get_size());
+    }
+
+    // Конструктор перемещения
+    GapBuffer(GapBuffer&& other) noexcept
+    {
+        swap(other);
+    }
+
+    ~GapBuffer()
+    {
+        clear();
+    }
+
+//================================================================ Операторы ===============================================================================
+
+    // Элемент по логическому индексу O(1)
+    Type& operator[](size_t index) noexcept
+    {
+        assert(index < get_size());
+        return items[index < gap_begin ? index : index + (gap_end - gap_begin)];
+    }
+
+    // Константный элемент по логическому индексу O(1)
+    const Type& operator[](size_t index) const noexcept
+    {
+        assert(index < get_size());
+        return items[index < gap_begin ? index : index + (gap_end - gap_begin)];
+    }
+
+    // Оператор присваивания O(N)
+    GapBuffer& operator=(const GapBuffer& rhs)
+    {
+        if (this != &rhs)
+        {
+            GapBuffer temp(rhs);
+            swap(temp);
+        }
+        return *this;
+    }
+
+    // Оператор присваивания перемещением O(1)
+    GapBuffer& operator=(GapBuffer&& rhs) noexcept
+    {
+        if (this != &rhs)
+        {
+            GapBuffer temp(std::move(rhs));
+            swap(temp);
+        }
+        return *this;
+    }
+
+//===================================================================== Итераторы ==========================================================================
+
+    Iterator begin() noexcept
+    {
+        return Iterator(this, 0);
+    }
+
+    Iterator end() noexcept
+    {
+        return Iterator(this, get_size());
+    }
+
+    ConstIterator begin() const noexcept
+    {
+        return ConstIterator(this, 0);
+    }
+
+    ConstIterator end() const noexcept
+    {
+        return ConstIterator(this, get_size());
+    }
+
+//===================================================================== Методы =============================================================================
+
+//------------------------------------------------------------- Заполнение и добавление --------------------------------------------------------------------
+
+    // Вставка перед index с копированием. O(1) амортизированно рядом с прошлой правкой, иначе O(расстояние)
+    void insert(size_t index, const Type& value)
+    {
+        Type copy(value);
+        insert(index, std::move(copy));
+    }
+
+    // Вставка перед index с перемещением. O(1) амортизированно рядом с прошлой правкой, иначе O(расстояние)
+    void insert(size_t index, Type&& value)
+    {
+        assert(index <= get_size());
+
+        if (gap_begin == gap_end)
+        {
+            // Новый элемент создается в новой памяти до переноса старых: при исключении буфер не меняется
+            RawMemory<Type> temp(std::max<size_t>(1, get_capacity() * 2));
+            std::construct_at(temp + index, std::move(value));
+            Relocate(temp, index, 1);
+        }
+        else
+        {
+            MoveGap(index);
+            std::construct_at(items + gap_begin, std::move(value));
+        }
+        ++gap_begin;
+    }
+
+    // Добавление в конец с копированием O(1) амортизированно, если разрыв уже в конце
+    void push_back(const Type& value)
+    {
+        insert(get_size(), value);
+    }
+
+    // Добавление в конец с перемещением O(1) амортизированно, если разрыв уже в конце
+    void push_back(Type&& value)
+    {
+        insert(get_size(), std::move(value));
+    }
+
+//-------------------------------------------------------------- Получение значений ------------------------------------------------------------------------
+
+    // Текущий размер O(1)
+    size_t get_size() const noexcept
+    {
+        return get_capacity() - (gap_end - gap_begin);
+    }
+
+    // Вместимость O(1)
+    size_t get_capacity() const noexcept
+    {
+        return items.get_capacity();
+    }
+
+    // Проверка на пустоту O(1)
+    bool is_empty() const noexcept
+    {
+        return get_size() == 0;
+    }
+
+    // Логическая позиция разрыва, то есть место последней правки O(1)
+    size_t get_gap_position() const noexcept
+    {
+        return gap_begin;
+    }
+
+    // Ссылка на элемент по индексу с проверкой O(1)
+    Type& at(size_t index)
+    {
+        if (index >= get_size())
+        {
+            throw std::out_of_range("Out of range");
+        }
+        return (*this)[index];
+    }
+
+    // Константная ссылка на элемент по индексу с проверкой O(1)
+    const Type& at(size_t index) const
+    {
+        if (index >= get_size())
+        {
+            throw std::out_of_range("Out of range");
+        }
+        return (*this)[index];
+    }
+
+//------------------------------------------------------------------- Работа с размером --------------------------------------------------------------------
+
+    // Резервирование места, разрыв переносится в конец O(N)
+    void reserve(size_t new_capacity)
+    {
+        if (new_capacity > get_capacity())
+        {
+            RawMemory<Type> temp(new_capacity);
+            Relocate(temp, get_size());
+        }
+    }
+
+//------------------------------------------------------------------------ Очистка и удаление --------------------------------------------------------------
+
+    // Удаление элемента по индексу. O(1) рядом с прошлой правкой, иначе O(расстояние)
+    void erase(size_t index)
+    {
+        assert(index < get_size());
+
+        MoveGap(index);
+        std::destroy_at(items + gap_end);
+        ++gap_end;
+    }
+
+    // Удаление последнего элемента O(1), если разрыв уже в конце
+    void pop_back()
+    {
+        assert(!is_empty());
+
+        erase(get_size() - 1);
+    }
+
+    // Очистить буфер, сохранив память O(N)
+    void clear() noexcept
+    {
+        std::destroy_n(items.get(), gap_begin);
+        std::destroy(items + gap_end, items + get_capacity());
+        gap_begin = 0;
+        gap_end = get_capacity();
+    }
+
+//--------------------------------------------------------------------- Прочие методы ----------------------------------------------------------------------
+
+    // Обмен значений O(1)
+    void swap(GapBuffer& other) noexcept
+    {
+        items.swap(other.items);
+        std::swap(gap_begin, other.gap_begin);
+        std::swap(gap_end, other.gap_end);
+    }
+
+private:
+
+    // Элементы лежат в [0, gap_begin) и [gap_end, capacity)
+    RawMemory<Type> items;
+    size_t gap_begin = 0;
+    size_t gap_end = 0;
+
+    // Добавляет count элементов из [first, last) в пустой буфер. Используется конструкторами: деструктор
+    // недостроенного буфера не вызывается, поэтому при исключении созданные элементы уничтожаются здесь O(N)
+    template <typename InputIterator>
+    void Append(InputIterator first, InputIterator last, size_t count)
+    {
+        reserve(count);
+        try
+        {
+            for (; first != last; ++first)
+            {
+                push_back(*first);
+            }
+        }
+        catch (...)
+        {
+            clear();
+            throw;
+        }
+    }
+
+    // Переносит разрыв так, чтобы он начинался с логического индекса index O(|index - gap_begin|).
+    // Тривиально копируемые элементы сдвигаются одним memmove, остальные - по одному: элемент создается
+    // на другой стороне разрыва и уничтожается на старом месте, так что при исключении буфер остается целым
+    void MoveGap(size_t index)
+    {
+        if (gap_begin == gap_end)
+        {
+            // Пустой разрыв переносится без перемещения элементов
+            gap_begin = gap_end = index;
+        }
+        else if constexpr (std::is_trivially_copyable_v<Type>)
+        {
+            if (index < gap_begin)
+            {
+                const size_t count = gap_begin - index;
+                std::memmove(static_cast<void*>(items + (gap_end - count)), static_cast<const void*>(items + index), count * sizeof(Type));
+                gap_begin -= count;
+                gap_end -= count;
+            }
+            else if (index > gap_begin)
+            {
+                const size_t count = index - gap_begin;
+                std::memmove(static_cast<void*>(items + gap_begin), static_cast<const void*>(items + gap_end), count * sizeof(Type));
+                gap_begin += count;
+                gap_end += count;
+            }
+        }
+        else
+        {
+            for (; gap_begin > index; --gap_begin, --gap_end)
+            {
+                std::construct_at(items + (gap_end - 1), std::move(items[gap_begin - 1]));
+                std::destroy_at(items + (gap_begin - 1));
+            }
+            for (; gap_begin < index; ++gap_begin, ++gap_end)
+            {
+                std::construct_at(items + gap_begin, std::move(items[gap_end]));
+                std::destroy_at(items + gap_end);
+            }
+        }
+    }
+
+    // Переносит элементы в new_items, размещая разрыв перед логическим индексом gap_position, уничтожает старые
+    // и забирает new_items себе O(N). В new_items с позиции gap_position уже могут быть созданы added_count новых
+    // элементов: если перенос выбросит исключение, они уничтожаются, а элементы буфера остаются на месте
+    void Relocate(RawMemory<Type>& new_items, size_t gap_position, size_t added_count = 0)
+    {
+        const size_t tail = get_size() - gap_position;
+        const size_t new_gap_end = new_items.get_capacity() - tail;
+        try
+        {
+            MoveGap(gap_position);
+            UninitializedRelocate(items.get(), items + gap_begin, new_items.get());
+            try
+            {
+                UninitializedRelocate(items + gap_end, items + get_capacity(), new_items + new_gap_end);
+            }
+            catch (...)
+            {
+                std::destroy_n(new_items.get(), gap_begin);
+                throw;
+            }
+        }
+        catch (...)
+        {
+            std::destroy_n(new_items + gap_position, added_count);
+            throw;
+        }
+
+        std::destroy_n(items.get(), gap_begin);
+        std::destroy(items + gap_end, items + get_capacity());
+        items.swap(new_items);
+        gap_end = new_gap_end;
+    }
+};
+
+//================================================= Блок перегруженных операторов =========================================================
+
+template <typename Type>
+inline bool operator==(const GapBuffer<Type>& lhs, const GapBuffer<Type>& rhs)
+{
+    return std::equal(lhs.begin(), lhs.end(), rhs.begin(), rhs.end());
+}
+
+template <typename Type>
+inline bool operator!=(const GapBuffer<Type>& lhs, const GapBuffer<Type>& rhs)
+{
+    return !(lhs == rhs);
+}
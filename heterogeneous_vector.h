@@ -0,0 +1,489 @@
+#pragma once
+
+#include "simple_vector.h"
+
+#include <algorithm>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <new>
+#include <stdexcept>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+// Разнотипный вектор: элементы типов Types хранятся подряд в одном байтовом буфере, каждый занимает
+// столько места, сколько нужно его типу, а не самому большому из Types, как в std::variant.
+// Запись - это заголовок с номером типа и размером записи, за которым выровнено лежит сам элемент.
+// Обход идет по буферу от записи к записи, произвольный доступ - через массив смещений записей.
+// Операции над элементом выбираются по номеру типа из таблицы функций
+template <typename... Types>
+class HeterogeneousVector
+{
+public:
+
+    static_assert(sizeof...(Types) > 0, "HeterogeneousVector requires at least one type");
+    static_assert((std::is_nothrow_move_constructible_v<Types> && ...), "HeterogeneousVector types must be nothrow move constructible");
+
+    // Номер типа Type среди Types; sizeof...(Types), если его среди них нет
+    template <typename Type>
+    static constexpr size_t kTypeIndex = []()
+    {
+        constexpr bool matches[] = { std::is_same_v<Type, Types>... };
+        size_t index = 0;
+        while (index < sizeof...(Types) && !matches[index])
+        {
+            ++index;
+        }
+        return index;
+    }();
+
+    // Тип с номером Index
+    template <size_t Index>
+    using Alternative = std::tuple_element_t<Index, std::tuple<Types...>>;
+
+//===================================================================== Конструкторы и деструктор ==========================================================
+
+    HeterogeneousVector() noexcept = default;
+
+    // Конструктор копирования O(N)
+    HeterogeneousVector(const HeterogeneousVector& other) requires (std::is_copy_constructible_v<Types> && ...) : offsets(other.offsets)
+    {
+        if constexpr (kTriviallyCopyable)
+        {
+            bytes = other.bytes;
+        }
+        else
+        {
+            bytes.reserve(other.bytes.get_size());
+            bytes.resize(other.bytes.get_size());
+
+            size_t copied = 0;
+            try
+            {
+                for (; copied < offsets.get_size(); ++copied)
+                {
+                    const size_t offset = offsets[copied];
+                    const Header header = other.GetHeader(offset);
+                    std::memcpy(bytes.data() + offset, other.bytes.data() + offset, sizeof(Header));
+                    kOperations[header.type].copy(GetPayload(offset, header.type), other.GetPayload(offset, header.type));
+                }
+            }
+            catch (...)
+            {
+                DestroyRecords(copied);
+                throw;
+            }
+        }
+    }
+
+    // Конструктор перемещения O(1)
+    HeterogeneousVector(HeterogeneousVector&& other) noexcept
+    {
+        swap(other);
+    }
+
+    // Уничтожает элементы O(N)
+    ~HeterogeneousVector()
+    {
+        DestroyRecords(offsets.get_size());
+    }
+
+//================================================================ Операторы ===============================================================================
+
+    // Оператор присваивания O(N)
+    HeterogeneousVector& operator=(const HeterogeneousVector& rhs) requires (std::is_copy_constructible_v<Types> && ...)
+    {
+        if (this != &rhs)
+        {
+            HeterogeneousVector temp(rhs);
+            swap(temp);
+        }
+        return *this;
+    }
+
+    // Оператор присваивания перемещением O(1)
+    HeterogeneousVector& operator=(HeterogeneousVector&& rhs) noexcept
+    {
+        if (this != &rhs)
+        {
+            HeterogeneousVector temp(std::move(rhs));
+            swap(temp);
+        }
+        return *this;
+    }
+
+//===================================================================== Методы =============================================================================
+
+//------------------------------------------------------------- Заполнение и добавление --------------------------------------------------------------------
+
+    // Создание элемента типа Type в конце из аргументов конструктора, амортизированно O(1).
+    // При росте элемент создается в новой памяти до переноса старых: аргументы могут ссылаться на элементы самого вектора
+    template <typename Type, typename... Args>
+    Type& emplace_back(Args&&... args)
+    {
+        static_assert(kTypeIndex<Type> < sizeof...(Types), "Type is not one of the HeterogeneousVector types");
+
+        constexpr size_t type = kTypeIndex<Type>;
+        const size_t offset = bytes.get_size();
+        const size_t new_size = offset + kRecordSize[type];
+
+        Reserve(0, offsets.get_size() + 1);
+
+        Type* item = nullptr;
+        if (new_size <= bytes.get_capacity())
+        {
+            bytes.resize(new_size);
+            try
+            {
+                item = std::construct_at(static_cast<Type*>(GetPayload(offset, type)), std::forward<Args>(args)...);
+            }
+            catch (...)
+            {
+                bytes.resize(offset);
+                throw;
+            }
+        }
+        else
+        {
+            SimpleVector<std::byte> new_bytes;
+            new_bytes.reserve(std::max(new_size, bytes.get_capacity() * 2));
+            new_bytes.resize(new_size);
+            item = std::construct_at(reinterpret_cast<Type*>(new_bytes.data() + offset + kPayloadOffset[type]), std::forward<Args>(args)...);
+            RelocateInto(new_bytes);
+        }
+
+        const Header header{ static_cast<uint32_t>(type), static_cast<uint32_t>(kRecordSize[type]) };
+        std::memcpy(bytes.data() + offset, &header, sizeof(Header));
+        offsets.push_back_unchecked(offset);
+        return *item;
+    }
+
+    // Добавление элемента в конец; тип элемента определяется по значению, амортизированно O(1)
+    template <typename Value>
+    void push_back(Value&& value)
+    {
+        emplace_back<std::remove_cvref_t<Value>>(std::forward<Value>(value));
+    }
+
+//-------------------------------------------------------------- Получение значений ------------------------------------------------------------------------
+
+    // Количество элементов O(1)
+    size_t get_size() const noexcept
+    {
+        return offsets.get_size();
+    }
+
+    // Проверка на пустоту O(1)
+    bool is_empty() const noexcept
+    {
+        return offsets.is_empty();
+    }
+
+    // Количество байтов, занятых записями O(1)
+    size_t get_byte_size() const noexcept
+    {
+        return bytes.get_size();
+    }
+
+    // Выделенная память в байтах вместе с массивом смещений O(1)
+    size_t get_memory_usage() const noexcept
+    {
+        return bytes.get_capacity() + offsets.get_capacity() * sizeof(size_t);
+    }
+
+    // Номер типа элемента по индексу O(1)
+    size_t get_type_index(size_t index) const
+    {
+        CheckIndex(index);
+        return GetHeader(offsets[index]).type;
+    }
+
+    // Проверка, что элемент по индексу имеет тип Type O(1)
+    template <typename Type>
+    bool holds(size_t index) const
+    {
+        return get_type_index(index) == kTypeIndex<Type>;
+    }
+
+    // Указатель на элемент по индексу, если он имеет тип Type, иначе nullptr O(1)
+    template <typename Type>
+    Type* get_if(size_t index)
+    {
+        return holds<Type>(index) ? static_cast<Type*>(GetPayload(offsets[index], kTypeIndex<Type>)) : nullptr;
+    }
+
+    template <typename Type>
+    const Type* get_if(size_t index) const
+    {
+        return holds<Type>(index) ? static_cast<const Type*>(GetPayload(offsets[index], kTypeIndex<Type>)) : nullptr;
+    }
+
+    // Ссылка на элемент по индексу с проверкой типа O(1)
+    template <typename Type>
+    Type& get(size_t index)
+    {
+        return *CheckType(get_if<Type>(index));
+    }
+
+    template <typename Type>
+    const Type& get(size_t index) const
+    {
+        return *CheckType(get_if<Type>(index));
+    }
+
+//------------------------------------------------------------------------- Обход ---------------------------------------------------------------------------
+
+    // Вызывает visitor для элемента по индексу, передавая ссылку на элемент его настоящего типа O(1).
+    // Результат visitor должен быть одного типа для всех Types
+    template <typename Visitor>
+    decltype(auto) visit(size_t index, Visitor&& visitor)
+    {
+        CheckIndex(index);
+        return VisitRecord<0>(visitor, bytes.data() + offsets[index]);
+    }
+
+    template <typename Visitor>
+    decltype(auto) visit(size_t index, Visitor&& visitor) const
+    {
+        CheckIndex(index);
+        return VisitRecord<0>(visitor, bytes.data() + offsets[index]);
+    }
+
+    // Вызывает visitor для всех элементов по порядку, проходя буфер от записи к записи без массива смещений O(N)
+    template <typename Visitor>
+    void for_each(Visitor&& visitor)
+    {
+        ForEach(bytes.data(), bytes.data() + bytes.get_size(), visitor);
+    }
+
+    template <typename Visitor>
+    void for_each(Visitor&& visitor) const
+    {
+        ForEach(bytes.data(), bytes.data() + bytes.get_size(), visitor);
+    }
+
+//------------------------------------------------------------------- Работа с размером --------------------------------------------------------------------
+
+    // Резервирование места под count элементов и byte_count байтов записей O(N)
+    void reserve(size_t count, size_t byte_count)
+    {
+        Reserve(byte_count, count);
+    }
+
+//------------------------------------------------------------------------ Очистка и удаление --------------------------------------------------------------
+
+    // Удаление последнего элемента O(1)
+    void pop_back() noexcept
+    {
+        assert(!is_empty());
+
+        const size_t offset = offsets[offsets.get_size() - 1];
+        const size_t type = GetHeader(offset).type;
+        kOperations[type].destroy(GetPayload(offset, type));
+        offsets.pop_back();
+        bytes.resize(offset);
+    }
+
+    // Удаление всех элементов; память сохраняется O(N)
+    void clear() noexcept
+    {
+        DestroyRecords(offsets.get_size());
+        offsets.clear();
+        bytes.clear();
+    }
+
+//--------------------------------------------------------------------- Прочие методы ----------------------------------------------------------------------
+
+    // Обмен значений O(1)
+    void swap(HeterogeneousVector& other) noexcept
+    {
+        bytes.swap(other.bytes);
+        offsets.swap(other.offsets);
+    }
+
+//----------------------------------------------------------------------------------------------------------------------------------------------------------
+
+private:
+
+    // Заголовок записи: номер типа и размер записи вместе с заголовком и выравниванием следующей
+    struct Header
+    {
+        uint32_t type;
+        uint32_t size;
+    };
+
+    // Операции над элементом, выбираемые по номеру типа
+    struct Operations
+    {
+        void (*destroy)(void* item) noexcept;
+        void (*relocate)(void* to, void* from) noexcept;
+        void (*copy)(void* to, const void* from);
+    };
+
+    // Все записи начинаются с адреса, кратного kAlignment; начало буфера выровнено operator new
+    static constexpr size_t kAlignment = std::max({ alignof(Header), alignof(Types)... });
+    static_assert(kAlignment <= __STDCPP_DEFAULT_NEW_ALIGNMENT__, "HeterogeneousVector does not support over-aligned types");
+
+    static constexpr bool kTriviallyCopyable = (std::is_trivially_copyable_v<Types> && ...);
+
+    static constexpr size_t RoundUp(size_t value, size_t alignment) noexcept
+    {
+        return (value + alignment - 1) / alignment * alignment;
+    }
+
+    // Смещения элементов внутри записей и размеры записей по номеру типа
+    static constexpr size_t kPayloadOffset[] = { RoundUp(sizeof(Header), alignof(Types))... };
+    static constexpr size_t kRecordSize[] = { RoundUp(RoundUp(sizeof(Header), alignof(Types)) + sizeof(Types), kAlignment)... };
+
+    template <typename Type>
+    static constexpr Operations MakeOperations() noexcept
+    {
+        return Operations
+        {
+            [](void* item) noexcept { std::destroy_at(static_cast<Type*>(item)); },
+            [](void* to, void* from) noexcept
+            {
+                std::construct_at(static_cast<Type*>(to), std::move(*static_cast<Type*>(from)));
+                std::destroy_at(static_cast<Type*>(from));
+            },
+            [](void* to, const void* from)
+            {
+                if constexpr (std::is_copy_constructible_v<Type>)
+                {
+                    std::construct_at(static_cast<Type*>(to), *static_cast<const Type*>(from));
+                }
+            }
+        };
+    }
+
+    static constexpr Operations kOperations[] = { MakeOperations<Types>()... };
+
+    // Байты записей; записи созданы ровно в [0, bytes.get_size())
+    SimpleVector<std::byte> bytes;
+    // Смещения записей от начала bytes
+    SimpleVector<size_t> offsets;
+
+    Header GetHeader(size_t offset) const noexcept
+    {
+        Header header;
+        std::memcpy(&header, bytes.data() + offset, sizeof(Header));
+        return header;
+    }
+
+    void* GetPayload(size_t offset, size_t type) noexcept
+    {
+        return bytes.data() + offset + kPayloadOffset[type];
+    }
+
+    const void* GetPayload(size_t offset, size_t type) const noexcept
+    {
+        return bytes.data() + offset + kPayloadOffset[type];
+    }
+
+    void CheckIndex(size_t index) const
+    {
+        if (index >= offsets.get_size())
+        {
+            throw std::out_of_range("Out of range");
+        }
+    }
+
+    template <typename Pointer>
+    static Pointer CheckType(Pointer item)
+    {
+        if (item == nullptr)
+        {
+            throw std::invalid_argument("Element holds another type");
+        }
+        return item;
+    }
+
+    // Обеспечивает место под byte_count байтов и count смещений. Буфер растет вдвое; элементы
+    // нетривиальных типов переносятся в новый буфер по одному через таблицу операций O(N)
+    void Reserve(size_t byte_count, size_t count)
+    {
+        if (count > offsets.get_capacity())
+        {
+            offsets.reserve(std::max(count, offsets.get_capacity() * 2));
+        }
+        if (byte_count <= bytes.get_capacity())
+        {
+            return;
+        }
+
+        SimpleVector<std::byte> new_bytes;
+        new_bytes.reserve(std::max(byte_count, bytes.get_capacity() * 2));
+        new_bytes.resize(bytes.get_size());
+        RelocateInto(new_bytes);
+    }
+
+    // Переносит записи в new_bytes (размером не меньше текущего) и забирает его себе; байты за последней записью
+    // не трогаются. Тривиально копируемые элементы копируются одним memcpy O(N)
+    void RelocateInto(SimpleVector<std::byte>& new_bytes) noexcept
+    {
+        if constexpr (kTriviallyCopyable)
+        {
+            if (!bytes.is_empty())
+            {
+                std::memcpy(new_bytes.data(), bytes.data(), bytes.get_size());
+            }
+        }
+        else
+        {
+            for (const size_t offset : offsets)
+            {
+                const size_t type = GetHeader(offset).type;
+                std::memcpy(new_bytes.data() + offset, bytes.data() + offset, sizeof(Header));
+                kOperations[type].relocate(new_bytes.data() + offset + kPayloadOffset[type], GetPayload(offset, type));
+            }
+        }
+        bytes.swap(new_bytes);
+    }
+
+    // Уничтожает первые count элементов O(count)
+    void DestroyRecords(size_t count) noexcept
+    {
+        if constexpr (!(std::is_trivially_destructible_v<Types> && ...))
+        {
+            for (size_t i = 0; i < count; ++i)
+            {
+                const size_t type = GetHeader(offsets[i]).type;
+                kOperations[type].destroy(GetPayload(offsets[i], type));
+            }
+        }
+    }
+
+    // Вызывает visitor для элемента записи record. Номер типа сравнивается по цепочке, которую компилятор
+    // сворачивает в таблицу переходов, а вызов visitor для каждого типа встраивается
+    template <size_t Index, typename Visitor, typename Byte>
+    static decltype(auto) VisitRecord(Visitor& visitor, Byte* record)
+    {
+        using Item = std::conditional_t<std::is_const_v<Byte>, const Alternative<Index>, Alternative<Index>>;
+
+        if constexpr (Index + 1 < sizeof...(Types))
+        {
+            Header header;
+            std::memcpy(&header, record, sizeof(Header));
+            if (header.type != Index)
+            {
+                return VisitRecord<Index + 1>(visitor, record);
+            }
+        }
+        return visitor(*std::launder(reinterpret_cast<Item*>(record + kPayloadOffset[Index])));
+    }
+
+    template <typename Byte, typename Visitor>
+    static void ForEach(Byte* first, Byte* last, Visitor& visitor)
+    {
+        while (first != last)
+        {
+            Header header;
+            std::memcpy(&header, first, sizeof(Header));
+            VisitRecord<0>(visitor, first);
+            first += header.size;
+        }
+    }
+};
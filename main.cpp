@@ -1,7 +1,10 @@
 #include "test.h"
 #include "log.h"
+#include "benchmark.h"
 
-int main()
+#include <string>
+
+int main(int argc, char* argv[])
 {
 	MemoryLeakDetector detector;
 
@@ -10,4 +13,9 @@ int main()
 
 		TestRun();
 	}
-}
\ No newline at end of file
+
+	if (argc > 1 && argv[1] == "bench"s)
+	{
+		BenchmarkRun();
+	}
+}
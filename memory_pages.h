@@ -0,0 +1,78 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+#if defined(__linux__) || defined(__APPLE__)
+#include <sys/mman.h>
+#include <unistd.h>
+#endif
+
+#if defined(__linux__)
+#include <fstream>
+#endif
+
+// Работа со страницами памяти: возврат операционной системе неиспользуемых страниц буфера
+// без перемещения данных и измерение резидентной памяти процесса
+
+// Размер страницы памяти в байтах O(1)
+inline size_t GetPageSize() noexcept
+{
+#if defined(__linux__) || defined(__APPLE__)
+    static const size_t page_size = static_cast<size_t>(sysconf(_SC_PAGESIZE));
+    return page_size;
+#else
+    return 4096;
+#endif
+}
+
+// Отдает системе целые страницы, лежащие внутри [first, first + bytes). Содержимое этих байтов
+// после вызова не определено, но память остается доступной: при следующей записи страница выделяется заново.
+// При lazy страницы помечаются свободными (MADV_FREE) и забираются системой только при нехватке памяти,
+// иначе освобождаются сразу (MADV_DONTNEED). Возвращает количество отданных байтов; 0, если платформа не поддерживается
+inline size_t ReleaseMemoryPages(void* first, size_t bytes, bool lazy = false) noexcept
+{
+#if defined(__linux__) || defined(__APPLE__)
+    const uintptr_t page_size = GetPageSize();
+    const uintptr_t begin = (reinterpret_cast<uintptr_t>(first) + page_size - 1) & ~(page_size - 1);
+    const uintptr_t end = (reinterpret_cast<uintptr_t>(first) + bytes) & ~(page_size - 1);
+
+    if (begin >= end)
+    {
+        return 0;
+    }
+
+    int advice = MADV_DONTNEED;
+#if defined(MADV_FREE)
+    if (lazy)
+    {
+        advice = MADV_FREE;
+    }
+#endif
+    if (madvise(reinterpret_cast<void*>(begin), end - begin, advice) != 0)
+    {
+        return 0;
+    }
+    return end - begin;
+#else
+    (void)first;
+    (void)bytes;
+    (void)lazy;
+    return 0;
+#endif
+}
+
+// Резидентная память процесса в байтах; 0, если платформа не поддерживается
+inline size_t GetResidentMemory()
+{
+#if defined(__linux__)
+    std::ifstream statm("/proc/self/statm");
+    size_t total_pages = 0;
+    size_t resident_pages = 0;
+    if (statm >> total_pages >> resident_pages)
+    {
+        return resident_pages * GetPageSize();
+    }
+#endif
+    return 0;
+}
@@ -0,0 +1,587 @@
+#pragma once
+
+#include "simple_vector.h"
+#include "vector_view.h"
+
+#include <algorithm>
+#include <array>
+#include <cassert>
+#include <concepts>
+#include <cstddef>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+
+// Многомерный массив в одном непрерывном буфере SimpleVector вместо вектора векторов: одно выделение памяти
+// на весь массив и вычисление адреса элемента по шагам измерений вместо перехода по указателю на строку.
+// Представления строк, столбцов и прямоугольных блоков не копируют данные
+
+// Порядок элементов в памяти: построчный (последний индекс меняется быстрее всех) или по столбцам (первый)
+enum class Layout
+{
+    kRowMajor,
+    kColumnMajor
+};
+
+// Сторона квадратного блока при транспонировании: блок источника и блок приемника вместе помещаются в L1
+inline constexpr size_t kTransposeTile = 32;
+
+template <typename ElementType, size_t Rank>
+class BasicNdView;
+
+// Только читающее многомерное представление
+template <typename Type, size_t Rank>
+using NdView = BasicNdView<const Type, Rank>;
+
+// Многомерное представление с возможностью изменять элементы
+template <typename Type, size_t Rank>
+using MutableNdView = BasicNdView<Type, Rank>;
+
+//================================================================ Представление ===========================================================================
+
+// Невладеющее представление Rank-мерного массива: указатель на первый элемент, размеры и шаги измерений в элементах.
+// Как и BasicVectorView, становится недействительным при перевыделении памяти владельца
+template <typename ElementType, size_t Rank>
+class BasicNdView
+{
+public:
+
+    static_assert(Rank > 0, "BasicNdView requires at least one dimension");
+
+    using Extents = std::array<size_t, Rank>;
+
+    // Представление на единицу меньшей размерности; одномерное - это BasicVectorView
+    using SliceType = std::conditional_t<Rank == 2, BasicVectorView<ElementType>, BasicNdView<ElementType, (Rank > 1 ? Rank - 1 : 1)>>;
+
+//===================================================================== Конструкторы ========================================================================
+
+    constexpr BasicNdView() noexcept = default;
+
+    constexpr BasicNdView(ElementType* first, const Extents& extents, const Extents& strides) noexcept : first(first), extents(extents), strides(strides) {}
+
+    // Изменяющее представление приводится к только читающему
+    constexpr operator BasicNdView<const ElementType, Rank>() const noexcept requires (!std::is_const_v<ElementType>)
+    {
+        return BasicNdView<const ElementType, Rank>(first, extents, strides);
+    }
+
+//================================================================ Операторы ===============================================================================
+
+    // Элемент по индексам O(Rank)
+    template <typename... Indices> requires (sizeof...(Indices) == Rank && (std::convertible_to<Indices, size_t> && ...))
+    constexpr ElementType& operator()(Indices... indices) const noexcept
+    {
+        const Extents position{ static_cast<size_t>(indices)... };
+        assert(IsInside(position));
+        return first[GetOffset(position)];
+    }
+
+//===================================================================== Методы =============================================================================
+
+    // Элемент по индексам с проверкой O(Rank)
+    template <typename... Indices> requires (sizeof...(Indices) == Rank && (std::convertible_to<Indices, size_t> && ...))
+    constexpr ElementType& at(Indices... indices) const
+    {
+        const Extents position{ static_cast<size_t>(indices)... };
+        if (!IsInside(position))
+        {
+            throw std::out_of_range("Out of range");
+        }
+        return first[GetOffset(position)];
+    }
+
+    // Размер измерения dimension O(1)
+    constexpr size_t get_extent(size_t dimension) const noexcept
+    {
+        assert(dimension < Rank);
+        return extents[dimension];
+    }
+
+    constexpr const Extents& get_extents() const noexcept
+    {
+        return extents;
+    }
+
+    // Шаг измерения dimension в элементах O(1)
+    constexpr size_t get_stride(size_t dimension) const noexcept
+    {
+        assert(dimension < Rank);
+        return strides[dimension];
+    }
+
+    constexpr const Extents& get_strides() const noexcept
+    {
+        return strides;
+    }
+
+    // Количество элементов O(Rank)
+    constexpr size_t get_size() const noexcept
+    {
+        size_t size = 1;
+        for (const size_t extent : extents)
+        {
+            size *= extent;
+        }
+        return size;
+    }
+
+    // Проверка на пустоту O(Rank)
+    constexpr bool is_empty() const noexcept
+    {
+        return get_size() == 0;
+    }
+
+    // Указатель на первый элемент O(1)
+    constexpr ElementType* data() const noexcept
+    {
+        return first;
+    }
+
+    // Лежат ли элементы подряд в построчном порядке без промежутков O(Rank)
+    constexpr bool is_contiguous() const noexcept
+    {
+        size_t expected = 1;
+        for (size_t dimension = Rank; dimension-- > 0;)
+        {
+            if (extents[dimension] > 1 && strides[dimension] != expected)
+            {
+                return false;
+            }
+            expected *= extents[dimension];
+        }
+        return true;
+    }
+
+    // Представление с фиксированным индексом index в измерении dimension O(Rank)
+    constexpr SliceType slice(size_t dimension, size_t index) const requires (Rank > 1)
+    {
+        if (dimension >= Rank || index >= extents[dimension])
+        {
+            throw std::out_of_range("Slice is out of range");
+        }
+
+        typename BasicNdView<ElementType, Rank - 1>::Extents slice_extents{};
+        typename BasicNdView<ElementType, Rank - 1>::Extents slice_strides{};
+        for (size_t from = 0, to = 0; from < Rank; ++from)
+        {
+            if (from != dimension)
+            {
+                slice_extents[to] = extents[from];
+                slice_strides[to] = strides[from];
+                ++to;
+            }
+        }
+
+        ElementType* slice_first = first + index * strides[dimension];
+        if constexpr (Rank == 2)
+        {
+            return BasicVectorView<ElementType>(slice_first, slice_extents[0], std::max<size_t>(slice_strides[0], 1));
+        }
+        else
+        {
+            return BasicNdView<ElementType, Rank - 1>(slice_first, slice_extents, slice_strides);
+        }
+    }
+
+    // Строка матрицы O(1)
+    constexpr BasicVectorView<ElementType> row(size_t index) const requires (Rank == 2)
+    {
+        return slice(0, index);
+    }
+
+    // Столбец матрицы O(1)
+    constexpr BasicVectorView<ElementType> column(size_t index) const requires (Rank == 2)
+    {
+        return slice(1, index);
+    }
+
+    // Прямоугольный блок с началом offset и размерами sub_extents O(Rank)
+    constexpr BasicNdView subview(const Extents& offset, const Extents& sub_extents) const
+    {
+        for (size_t dimension = 0; dimension < Rank; ++dimension)
+        {
+            if (offset[dimension] > extents[dimension] || sub_extents[dimension] > extents[dimension] - offset[dimension])
+            {
+                throw std::out_of_range("Subview is out of range");
+            }
+        }
+        return BasicNdView(first + GetOffset(offset), sub_extents, strides);
+    }
+
+    // Транспонированная матрица без копирования: измерения меняются местами вместе с шагами O(1)
+    constexpr BasicNdView transposed() const noexcept requires (Rank == 2)
+    {
+        return BasicNdView(first, Extents{ extents[1], extents[0] }, Extents{ strides[1], strides[0] });
+    }
+
+    // Вызывает function для каждого блока размером tile (крайние блоки обрезаются) в построчном порядке блоков.
+    // Обработка блоками, помещающимися в кэш, вместо проходов по всему массиву O(N)
+    template <typename Function>
+    constexpr void for_each_tile(const Extents& tile, Function function) const
+    {
+        for (size_t dimension = 0; dimension < Rank; ++dimension)
+        {
+            if (tile[dimension] == 0)
+            {
+                throw std::invalid_argument("Tile extents must be positive");
+            }
+            if (extents[dimension] == 0)
+            {
+                return;
+            }
+        }
+
+        Extents offset{};
+        while (true)
+        {
+            Extents sub_extents;
+            for (size_t dimension = 0; dimension < Rank; ++dimension)
+            {
+                sub_extents[dimension] = std::min(tile[dimension], extents[dimension] - offset[dimension]);
+            }
+            function(BasicNdView(first + GetOffset(offset), sub_extents, strides));
+
+            // Переход к следующему блоку: последнее измерение меняется быстрее всех
+            size_t dimension = Rank;
+            while (dimension > 0)
+            {
+                --dimension;
+                offset[dimension] += tile[dimension];
+                if (offset[dimension] < extents[dimension])
+                {
+                    break;
+                }
+                offset[dimension] = 0;
+                if (dimension == 0)
+                {
+                    return;
+                }
+            }
+        }
+    }
+
+    // Вызывает function(element) для всех элементов в построчном порядке индексов O(N)
+    template <typename Function>
+    constexpr void for_each(Function function) const
+    {
+        ForEach<0>(first, function);
+    }
+
+private:
+
+    ElementType* first = nullptr;
+    Extents extents{};
+    Extents strides{};
+
+    constexpr size_t GetOffset(const Extents& position) const noexcept
+    {
+        size_t offset = 0;
+        for (size_t dimension = 0; dimension < Rank; ++dimension)
+        {
+            offset += position[dimension] * strides[dimension];
+        }
+        return offset;
+    }
+
+    constexpr bool IsInside(const Extents& position) const noexcept
+    {
+        for (size_t dimension = 0; dimension < Rank; ++dimension)
+        {
+            if (position[dimension] >= extents[dimension])
+            {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    template <size_t Dimension, typename Function>
+    constexpr void ForEach(ElementType* item, Function& function) const
+    {
+        const size_t extent = extents[Dimension];
+        const size_t stride = strides[Dimension];
+
+        if constexpr (Dimension + 1 == Rank)
+        {
+            // Непрерывная строка проходится указателем без умножения на шаг
+            if (stride == 1)
+            {
+                for (ElementType* last = item + extent; item != last; ++item)
+                {
+                    function(*item);
+                }
+                return;
+            }
+        }
+
+        for (size_t index = 0; index < extent; ++index, item += stride)
+        {
+            if constexpr (Dimension + 1 == Rank)
+            {
+                function(*item);
+            }
+            else
+            {
+                ForEach<Dimension + 1>(item, function);
+            }
+        }
+    }
+};
+
+//================================================================ Транспонирование ========================================================================
+
+// Записывает в to транспонированную матрицу from. Матрица обходится квадратными блоками kTransposeTile,
+// поэтому и чтение, и запись с большим шагом остаются в пределах строк кэша, загруженных для блока O(N)
+template <typename Type>
+void transpose_into(NdView<Type, 2> from, MutableNdView<Type, 2> to)
+{
+    const size_t rows = from.get_extent(0);
+    const size_t columns = from.get_extent(1);
+    if (to.get_extent(0) != columns || to.get_extent(1) != rows)
+    {
+        throw std::invalid_argument("Transposed extents do not match");
+    }
+
+    const Type* source = from.data();
+    Type* target = to.data();
+    const size_t source_row = from.get_stride(0);
+    const size_t source_column = from.get_stride(1);
+    const size_t target_row = to.get_stride(0);
+    const size_t target_column = to.get_stride(1);
+
+    for (size_t row_first = 0; row_first < rows; row_first += kTransposeTile)
+    {
+        const size_t row_last = std::min(row_first + kTransposeTile, rows);
+        for (size_t column_first = 0; column_first < columns; column_first += kTransposeTile)
+        {
+            const size_t column_last = std::min(column_first + kTransposeTile, columns);
+            for (size_t row = row_first; row < row_last; ++row)
+            {
+                for (size_t column = column_first; column < column_last; ++column)
+                {
+                    target[column * target_row + row * target_column] = source[row * source_row + column * source_column];
+                }
+            }
+        }
+    }
+}
+
+//================================================================ Владеющий массив ========================================================================
+
+// Rank-мерный массив элементов Type в одном буфере SimpleVector
+template <typename Type, size_t Rank>
+class NdVector
+{
+public:
+
+    static_assert(Rank > 0, "NdVector requires at least one dimension");
+
+    using Extents = std::array<size_t, Rank>;
+
+//===================================================================== Конструкторы ========================================================================
+
+    NdVector() noexcept = default;
+
+    // Создает массив размеров extents с элементами по умолчанию
+    explicit NdVector(const Extents& extents, Layout layout = Layout::kRowMajor) : NdVector(extents, Type(), layout) {}
+
+    // Создает массив размеров extents, заполненный value
+    NdVector(const Extents& extents, const Type& value, Layout layout = Layout::kRowMajor)
+        : items(GetSize(extents), value), extents(extents), layout(layout) {}
+
+//================================================================ Операторы ===============================================================================
+
+    // Элемент по индексам O(Rank)
+    template <typename... Indices> requires (sizeof...(Indices) == Rank && (std::convertible_to<Indices, size_t> && ...))
+    Type& operator()(Indices... indices) noexcept
+    {
+        return view()(indices...);
+    }
+
+    template <typename... Indices> requires (sizeof...(Indices) == Rank && (std::convertible_to<Indices, size_t> && ...))
+    const Type& operator()(Indices... indices) const noexcept
+    {
+        return view()(indices...);
+    }
+
+//===================================================================== Методы =============================================================================
+
+    // Элемент по индексам с проверкой O(Rank)
+    template <typename... Indices> requires (sizeof...(Indices) == Rank && (std::convertible_to<Indices, size_t> && ...))
+    Type& at(Indices... indices)
+    {
+        return view().at(indices...);
+    }
+
+    template <typename... Indices> requires (sizeof...(Indices) == Rank && (std::convertible_to<Indices, size_t> && ...))
+    const Type& at(Indices... indices) const
+    {
+        return view().at(indices...);
+    }
+
+    // Представление всего массива O(Rank)
+    MutableNdView<Type, Rank> view() noexcept
+    {
+        return MutableNdView<Type, Rank>(items.data(), extents, GetStrides());
+    }
+
+    NdView<Type, Rank> view() const noexcept
+    {
+        return NdView<Type, Rank>(items.data(), extents, GetStrides());
+    }
+
+    // Строка матрицы O(1)
+    MutableVectorView<Type> row(size_t index) requires (Rank == 2)
+    {
+        return view().row(index);
+    }
+
+    VectorView<Type> row(size_t index) const requires (Rank == 2)
+    {
+        return view().row(index);
+    }
+
+    // Столбец матрицы O(1)
+    MutableVectorView<Type> column(size_t index) requires (Rank == 2)
+    {
+        return view().column(index);
+    }
+
+    VectorView<Type> column(size_t index) const requires (Rank == 2)
+    {
+        return view().column(index);
+    }
+
+    // Прямоугольный блок с началом offset и размерами sub_extents O(Rank)
+    MutableNdView<Type, Rank> subview(const Extents& offset, const Extents& sub_extents)
+    {
+        return view().subview(offset, sub_extents);
+    }
+
+    NdView<Type, Rank> subview(const Extents& offset, const Extents& sub_extents) const
+    {
+        return view().subview(offset, sub_extents);
+    }
+
+    // Транспонированная копия матрицы в том же порядке хранения O(N)
+    NdVector transposed() const requires (Rank == 2)
+    {
+        NdVector result(Extents{ extents[1], extents[0] }, layout);
+        transpose_into<Type>(view(), result.view());
+        return result;
+    }
+
+    // Размер измерения dimension O(1)
+    size_t get_extent(size_t dimension) const noexcept
+    {
+        assert(dimension < Rank);
+        return extents[dimension];
+    }
+
+    const Extents& get_extents() const noexcept
+    {
+        return extents;
+    }
+
+    Layout get_layout() const noexcept
+    {
+        return layout;
+    }
+
+    // Количество элементов O(1)
+    size_t get_size() const noexcept
+    {
+        return items.get_size();
+    }
+
+    // Проверка на пустоту O(1)
+    bool is_empty() const noexcept
+    {
+        return items.is_empty();
+    }
+
+    Type* data() noexcept
+    {
+        return items.data();
+    }
+
+    const Type* data() const noexcept
+    {
+        return items.data();
+    }
+
+//------------------------------------------------------------------- Работа с размером --------------------------------------------------------------------
+
+    // Номер внешнего измерения, элементы которого лежат в памяти подряд целыми блоками:
+    // первое при построчном хранении, последнее при хранении по столбцам O(1)
+    size_t get_outer_dimension() const noexcept
+    {
+        return layout == Layout::kRowMajor ? 0 : Rank - 1;
+    }
+
+    // Изменяет размер внешнего измерения. Добавляемые или удаляемые блоки лежат в конце буфера,
+    // поэтому остальные элементы остаются на местах, а память растет по правилам SimpleVector, амортизированно O(добавленных)
+    void resize_outer(size_t new_extent)
+    {
+        Extents new_extents = extents;
+        new_extents[get_outer_dimension()] = new_extent;
+        items.resize(GetSize(new_extents));
+        extents = new_extents;
+    }
+
+    // Резервирует память под new_extent блоков внешнего измерения O(N)
+    void reserve_outer(size_t new_extent)
+    {
+        Extents new_extents = extents;
+        new_extents[get_outer_dimension()] = new_extent;
+        items.reserve(GetSize(new_extents));
+    }
+
+    // Обмен значений O(1)
+    void swap(NdVector& other) noexcept
+    {
+        items.swap(other.items);
+        std::swap(extents, other.extents);
+        std::swap(layout, other.layout);
+    }
+
+private:
+
+    SimpleVector<Type> items;
+    Extents extents{};
+    Layout layout = Layout::kRowMajor;
+
+    static size_t GetSize(const Extents& extents) noexcept
+    {
+        size_t size = 1;
+        for (const size_t extent : extents)
+        {
+            size *= extent;
+        }
+        return size;
+    }
+
+    // Шаги измерений для порядка хранения O(Rank)
+    Extents GetStrides() const noexcept
+    {
+        Extents strides{};
+        size_t stride = 1;
+        if (layout == Layout::kRowMajor)
+        {
+            for (size_t dimension = Rank; dimension-- > 0;)
+            {
+                strides[dimension] = stride;
+                stride *= extents[dimension];
+            }
+        }
+        else
+        {
+            for (size_t dimension = 0; dimension < Rank; ++dimension)
+            {
+                strides[dimension] = stride;
+                stride *= extents[dimension];
+            }
+        }
+        return strides;
+    }
+};
@@ -0,0 +1,644 @@
+#pragma once
+
+#include "simple_vector.h"
+
+#include <array>
+#include <bit>
+#include <cassert>
+#include <cstdint>
+#include <iterator>
+#include <stdexcept>
+#include <utility>
+
+// Вспомогательный класс для упаковки целых фиксированной разрядности в поток 64-битных слов
+class PackedBits
+{
+public:
+
+    // Количество значений, которое декодируется за один проход итератора
+    static constexpr size_t kBlockSize = 128;
+
+    // Маска из width младших единичных битов O(1)
+    static constexpr uint64_t Mask(unsigned width) noexcept
+    {
+        return width >= 64 ? ~uint64_t(0) : (uint64_t(1) << width) - 1;
+    }
+
+    // Минимальная разрядность, в которую помещается value O(1)
+    static constexpr unsigned Width(uint64_t value) noexcept
+    {
+        return static_cast<unsigned>(std::bit_width(value));
+    }
+
+    // Количество слов, необходимое для count значений разрядности width O(1)
+    static constexpr size_t WordCount(size_t count, unsigned width) noexcept
+    {
+        return (count * width + 63) / 64;
+    }
+
+    // Чтение значения по битовому смещению O(1)
+    static uint64_t Read(const uint64_t* words, size_t bit_offset, unsigned width) noexcept
+    {
+        if (width == 0)
+        {
+            return 0;
+        }
+
+        const size_t word = bit_offset >> 6;
+        const unsigned shift = static_cast<unsigned>(bit_offset & 63);
+
+        uint64_t value = words[word] >> shift;
+        if (shift + width > 64)
+        {
+            value |= words[word + 1] << (64 - shift);
+        }
+        return value & Mask(width);
+    }
+
+    // Запись значения по битовому смещению, соседние биты сохраняются O(1)
+    static void Write(uint64_t* words, size_t bit_offset, uint64_t value, unsigned width) noexcept
+    {
+        if (width == 0)
+        {
+            return;
+        }
+
+        const uint64_t mask = Mask(width);
+        const size_t word = bit_offset >> 6;
+        const unsigned shift = static_cast<unsigned>(bit_offset & 63);
+
+        value &= mask;
+        words[word] = (words[word] & ~(mask << shift)) | (value << shift);
+        if (shift + width > 64)
+        {
+            words[word + 1] = (words[word + 1] & ~(mask >> (64 - shift))) | (value >> (64 - shift));
+        }
+    }
+
+    // Пакетное чтение count значений подряд. Слово читается один раз на все попавшие в него значения,
+    // а ветвление остаётся только на границах слов O(N)
+    static void Unpack(const uint64_t* words, size_t bit_offset, unsigned width, size_t count, uint64_t* out) noexcept
+    {
+        if (width == 0)
+        {
+            std::fill(out, out + count, uint64_t(0));
+            return;
+        }
+        if (width == 64 && (bit_offset & 63) == 0)
+        {
+            std::copy(words + (bit_offset >> 6), words + (bit_offset >> 6) + count, out);
+            return;
+        }
+
+        const uint64_t mask = Mask(width);
+        size_t word = bit_offset >> 6;
+        unsigned shift = static_cast<unsigned>(bit_offset & 63);
+        uint64_t current = words[word];
+
+        for (size_t i = 0; i < count; ++i)
+        {
+            uint64_t value = current >> shift;
+            shift += width;
+            if (shift >= 64)
+            {
+                shift -= 64;
+                // Следующее слово читается только если в нём есть биты текущего или последующих значений
+                if (shift != 0 || i + 1 < count)
+                {
+                    current = words[++word];
+                }
+                if (shift != 0)
+                {
+                    value |= current << (width - shift);
+                }
+            }
+            out[i] = value & mask;
+        }
+    }
+
+    // Распаковка полного блока из kBlockSize значений, начинающегося с границы слова. Для каждой разрядности
+    // есть своя развернутая функция: смещения всех значений известны на этапе компиляции, поэтому вместо цикла
+    // с переносом слова и сдвига между итерациями остаются независимые сдвиги без ветвлений O(kBlockSize)
+    static void UnpackBlock(const uint64_t* words, unsigned width, uint64_t* out) noexcept
+    {
+        assert(width <= 64);
+        if (width == 64)
+        {
+            std::copy(words, words + kBlockSize, out);
+            return;
+        }
+        kBlockUnpackers[width](words, out);
+    }
+
+private:
+
+    using BlockUnpacker = void (*)(const uint64_t*, uint64_t*) noexcept;
+
+    // Функции распаковки блока для разрядностей от 0 до 63
+    static const std::array<BlockUnpacker, 64> kBlockUnpackers;
+
+    // 64 значения разрядности Width занимают ровно Width слов, поэтому блок распаковывается группами по 64
+    static_assert(kBlockSize % 64 == 0);
+
+    template <size_t... Width>
+    static constexpr std::array<BlockUnpacker, sizeof...(Width)> MakeBlockUnpackers(std::index_sequence<Width...>) noexcept
+    {
+        return { &UnpackFixed<static_cast<unsigned>(Width)>... };
+    }
+
+    template <unsigned Width>
+    static void UnpackFixed(const uint64_t* words, uint64_t* out) noexcept
+    {
+        for (size_t group = 0; group < kBlockSize / 64; ++group)
+        {
+            UnpackGroup<Width>(words + group * Width, out + group * 64, std::make_index_sequence<64>());
+        }
+    }
+
+    template <unsigned Width, size_t... Index>
+    static void UnpackGroup(const uint64_t* words, uint64_t* out, std::index_sequence<Index...>) noexcept
+    {
+        (UnpackValue<Width, Index>(words, out), ...);
+    }
+
+    // Значение Index группы: слово и сдвиг - константы, второе слово читается, только если значение на него заходит
+    template <unsigned Width, size_t Index>
+    static void UnpackValue(const uint64_t* words, uint64_t* out) noexcept
+    {
+        if constexpr (Width == 0)
+        {
+            out[Index] = 0;
+        }
+        else
+        {
+            constexpr size_t bit = Index * Width;
+            constexpr unsigned shift = static_cast<unsigned>(bit & 63);
+
+            uint64_t value = words[bit >> 6] >> shift;
+            if constexpr (shift + Width > 64)
+            {
+                value |= words[(bit >> 6) + 1] << (64 - shift);
+            }
+            out[Index] = value & Mask(Width);
+        }
+    }
+};
+
+inline const std::array<PackedBits::BlockUnpacker, 64> PackedBits::kBlockUnpackers = PackedBits::MakeBlockUnpackers(std::make_index_sequence<64>());
+
+// Итератор последовательного чтения: декодирует значения блоками по PackedBits::kBlockSize
+template <typename Container>
+class PackedIterator
+{
+public:
+
+    using iterator_category = std::input_iterator_tag;
+    using value_type = uint64_t;
+    using difference_type = std::ptrdiff_t;
+    using pointer = const uint64_t*;
+    using reference = const uint64_t&;
+
+    PackedIterator(const Container* container, size_t index) : container(container), index(index)
+    {
+        Load();
+    }
+
+    reference operator*() const noexcept
+    {
+        return buffer[index - buffer_first];
+    }
+
+    pointer operator->() const noexcept
+    {
+        return &buffer[index - buffer_first];
+    }
+
+    PackedIterator& operator++()
+    {
+        ++index;
+        if (index - buffer_first == buffer_size)
+        {
+            Load();
+        }
+        return *this;
+    }
+
+    PackedIterator operator++(int)
+    {
+        PackedIterator temp(*this);
+        ++(*this);
+        return temp;
+    }
+
+    bool operator==(const PackedIterator& other) const noexcept
+    {
+        return index == other.index;
+    }
+
+    bool operator!=(const PackedIterator& other) const noexcept
+    {
+        return !(*this == other);
+    }
+
+private:
+
+    const Container* container = nullptr;
+    size_t index = 0;
+    size_t buffer_first = 0;
+    size_t buffer_size = 0;
+    std::array<uint64_t, PackedBits::kBlockSize> buffer{};
+
+    void Load()
+    {
+        buffer_first = index;
+        buffer_size = index < container->get_size() ? container->decode(index, buffer.data()) : 0;
+    }
+};
+
+//================================================================ Вектор фиксированной разрядности ===================================================================
+
+// Вектор беззнаковых целых, каждое из которых занимает ровно width битов
+class BitPackedVector
+{
+public:
+
+    using ConstIterator = PackedIterator<BitPackedVector>;
+
+//===================================================================== Конструкторы и деструктор ==========================================================
+
+    // Создает пустой вектор разрядности width
+    explicit BitPackedVector(unsigned width = 64) : width(width)
+    {
+        if (width > 64)
+        {
+            throw std::invalid_argument("Bit width must not exceed 64");
+        }
+    }
+
+    // Упаковывает значения с минимальной разрядностью, вмещающей максимум O(N)
+    explicit BitPackedVector(const SimpleVector<uint64_t>& values) : width(0)
+    {
+        for (uint64_t value : values)
+        {
+            width = std::max(width, PackedBits::Width(value));
+        }
+        reserve(values.get_size());
+        for (uint64_t value : values)
+        {
+            push_back(value);
+        }
+    }
+
+//===================================================================== Методы =============================================================================
+
+    // Добавление в конец O(1) амортизированно
+    void push_back(uint64_t value)
+    {
+        if (value > PackedBits::Mask(width))
+        {
+            throw std::invalid_argument("Value does not fit into bit width");
+        }
+        while (words.get_size() < PackedBits::WordCount(size + 1, width))
+        {
+            words.push_back(0);
+        }
+        PackedBits::Write(words.data(), size * width, value, width);
+        ++size;
+    }
+
+    // Значение по индексу O(1)
+    uint64_t get(size_t index) const noexcept
+    {
+        assert(index < size);
+        return PackedBits::Read(words.data(), index * width, width);
+    }
+
+    // Изменение значения по индексу O(1)
+    void set(size_t index, uint64_t value)
+    {
+        assert(index < size);
+        if (value > PackedBits::Mask(width))
+        {
+            throw std::invalid_argument("Value does not fit into bit width");
+        }
+        PackedBits::Write(words.data(), index * width, value, width);
+    }
+
+    // Декодирует до kBlockSize значений, начиная с first, возвращает их количество O(kBlockSize)
+    size_t decode(size_t first, uint64_t* out) const noexcept
+    {
+        assert(first < size);
+        const size_t count = std::min(PackedBits::kBlockSize, size - first);
+        if (count == PackedBits::kBlockSize && first * width % 64 == 0)
+        {
+            PackedBits::UnpackBlock(words.data() + first * width / 64, width, out);
+        }
+        else
+        {
+            PackedBits::Unpack(words.data(), first * width, width, count, out);
+        }
+        return count;
+    }
+
+    // Резервирование места под capacity значений O(N)
+    void reserve(size_t capacity)
+    {
+        words.reserve(PackedBits::WordCount(capacity, width));
+    }
+
+    // Распаковка в обычный вектор O(N)
+    SimpleVector<uint64_t> to_vector() const
+    {
+        SimpleVector<uint64_t> result(size);
+        for (size_t first = 0; first < size; first += PackedBits::kBlockSize)
+        {
+            decode(first, result.data() + first);
+        }
+        return result;
+    }
+
+    // Количество значений O(1)
+    size_t get_size() const noexcept
+    {
+        return size;
+    }
+
+    // Проверка на пустоту O(1)
+    bool is_empty() const noexcept
+    {
+        return size == 0;
+    }
+
+    // Разрядность значений O(1)
+    unsigned get_width() const noexcept
+    {
+        return width;
+    }
+
+    // Объем занятых упакованными данными байтов O(1)
+    size_t memory_bytes() const noexcept
+    {
+        return words.get_size() * sizeof(uint64_t);
+    }
+
+    ConstIterator begin() const
+    {
+        return ConstIterator(this, 0);
+    }
+
+    ConstIterator end() const
+    {
+        return ConstIterator(this, size);
+    }
+
+private:
+
+    SimpleVector<uint64_t> words;
+    size_t size = 0;
+    unsigned width = 64;
+};
+
+//================================================================ Блочные кодировки ================================================================================
+
+// Кодирование смещением от минимума блока: подходит для значений, сгруппированных около общей базы
+struct FrameOfReferenceEncoding
+{
+    static constexpr bool kSorted = false;
+
+    // Переводит значения блока в неотрицательные остатки, возвращает базу блока O(N)
+    static uint64_t Encode(const uint64_t* values, size_t count, uint64_t* residuals) noexcept
+    {
+        const uint64_t reference = *std::min_element(values, values + count);
+        for (size_t i = 0; i < count; ++i)
+        {
+            residuals[i] = values[i] - reference;
+        }
+        return reference;
+    }
+
+    // Восстанавливает значения блока из остатков на месте O(N)
+    static void Decode(uint64_t reference, size_t count, uint64_t* values) noexcept
+    {
+        for (size_t i = 0; i < count; ++i)
+        {
+            values[i] += reference;
+        }
+    }
+
+    // Значение по индексу внутри блока O(1)
+    static uint64_t Access(const uint64_t* words, size_t bit_offset, unsigned width, uint64_t reference, size_t index) noexcept
+    {
+        return reference + PackedBits::Read(words, bit_offset + index * width, width);
+    }
+};
+
+// Дельта-кодирование отсортированной последовательности: хранятся разности соседних значений
+struct DeltaEncoding
+{
+    static constexpr bool kSorted = true;
+
+    // Переводит значения блока в разности, базой служит первое значение O(N)
+    static uint64_t Encode(const uint64_t* values, size_t count, uint64_t* residuals) noexcept
+    {
+        residuals[0] = 0;
+        for (size_t i = 1; i < count; ++i)
+        {
+            residuals[i] = values[i] - values[i - 1];
+        }
+        return values[0];
+    }
+
+    // Восстанавливает значения блока префиксной суммой на месте O(N)
+    static void Decode(uint64_t reference, size_t count, uint64_t* values) noexcept
+    {
+        uint64_t current = reference;
+        for (size_t i = 0; i < count; ++i)
+        {
+            current += values[i];
+            values[i] = current;
+        }
+    }
+
+    // Значение по индексу внутри блока требует суммирования разностей до index O(kBlockSize)
+    static uint64_t Access(const uint64_t* words, size_t bit_offset, unsigned width, uint64_t reference, size_t index) noexcept
+    {
+        uint64_t value = reference;
+        for (size_t i = 1; i <= index; ++i)
+        {
+            value += PackedBits::Read(words, bit_offset + i * width, width);
+        }
+        return value;
+    }
+};
+
+//================================================================ Блочно-упакованный вектор ========================================================================
+
+// Вектор, сжимающий каждые kBlockSize значений выбранной кодировкой с собственной разрядностью.
+// Незаполненный последний блок хранится в несжатом виде до заполнения
+template <typename Encoding>
+class BlockPackedVector
+{
+public:
+
+    using ConstIterator = PackedIterator<BlockPackedVector>;
+
+    static constexpr size_t kBlockSize = PackedBits::kBlockSize;
+
+//===================================================================== Конструкторы и деструктор ==========================================================
+
+    BlockPackedVector() = default;
+
+    // Сжатие обычного вектора O(N)
+    explicit BlockPackedVector(const SimpleVector<uint64_t>& values)
+    {
+        for (uint64_t value : values)
+        {
+            push_back(value);
+        }
+    }
+
+//===================================================================== Методы =============================================================================
+
+    // Добавление в конец, заполненный блок сжимается O(1) амортизированно
+    void push_back(uint64_t value)
+    {
+        if constexpr (Encoding::kSorted)
+        {
+            if (size > 0 && value < last_value)
+            {
+                throw std::invalid_argument("Values must be pushed in sorted order");
+            }
+        }
+
+        tail.push_back(value);
+        last_value = value;
+        ++size;
+
+        if (tail.get_size() == kBlockSize)
+        {
+            FlushTail();
+        }
+    }
+
+    // Значение по индексу O(1) для кодирования смещением, O(kBlockSize) для дельта-кодирования
+    uint64_t get(size_t index) const noexcept
+    {
+        assert(index < size);
+
+        const size_t block = index / kBlockSize;
+        if (block == headers.get_size())
+        {
+            return tail[index % kBlockSize];
+        }
+
+        const BlockHeader& header = headers[block];
+        return Encoding::Access(words.data(), header.word_offset * 64, header.width, header.reference, index % kBlockSize);
+    }
+
+    // Декодирует блок, начинающийся с first (кратного kBlockSize), возвращает количество значений O(kBlockSize)
+    size_t decode(size_t first, uint64_t* out) const noexcept
+    {
+        assert(first < size && first % kBlockSize == 0);
+
+        const size_t block = first / kBlockSize;
+        if (block == headers.get_size())
+        {
+            std::copy(tail.begin(), tail.end(), out);
+            return tail.get_size();
+        }
+
+        const BlockHeader& header = headers[block];
+        PackedBits::UnpackBlock(words.data() + header.word_offset, header.width, out);
+        Encoding::Decode(header.reference, kBlockSize, out);
+        return kBlockSize;
+    }
+
+    // Распаковка в обычный вектор O(N)
+    SimpleVector<uint64_t> to_vector() const
+    {
+        SimpleVector<uint64_t> result(size);
+        for (size_t first = 0; first < size; first += kBlockSize)
+        {
+            decode(first, result.data() + first);
+        }
+        return result;
+    }
+
+    // Количество значений O(1)
+    size_t get_size() const noexcept
+    {
+        return size;
+    }
+
+    // Проверка на пустоту O(1)
+    bool is_empty() const noexcept
+    {
+        return size == 0;
+    }
+
+    // Объем сжатых данных, заголовков блоков и несжатого хвоста в байтах O(1)
+    size_t memory_bytes() const noexcept
+    {
+        return words.get_size() * sizeof(uint64_t) + headers.get_size() * sizeof(BlockHeader) + tail.get_size() * sizeof(uint64_t);
+    }
+
+    ConstIterator begin() const
+    {
+        return ConstIterator(this, 0);
+    }
+
+    ConstIterator end() const
+    {
+        return ConstIterator(this, size);
+    }
+
+private:
+
+    struct BlockHeader
+    {
+        uint64_t reference = 0;
+        size_t word_offset = 0;
+        unsigned width = 0;
+    };
+
+    SimpleVector<uint64_t> words;
+    SimpleVector<BlockHeader> headers;
+    SimpleVector<uint64_t> tail;
+    size_t size = 0;
+    uint64_t last_value = 0;
+
+    // Сжимает заполненный хвост в новый блок O(kBlockSize)
+    void FlushTail()
+    {
+        std::array<uint64_t, kBlockSize> residuals;
+
+        BlockHeader header;
+        header.reference = Encoding::Encode(tail.data(), kBlockSize, residuals.data());
+        header.word_offset = words.get_size();
+
+        uint64_t max_residual = 0;
+        for (uint64_t residual : residuals)
+        {
+            max_residual = std::max(max_residual, residual);
+        }
+        header.width = PackedBits::Width(max_residual);
+
+        for (size_t i = 0; i < PackedBits::WordCount(kBlockSize, header.width); ++i)
+        {
+            words.push_back(0);
+        }
+        for (size_t i = 0; i < kBlockSize; ++i)
+        {
+            PackedBits::Write(words.data(), header.word_offset * 64 + i * header.width, residuals[i], header.width);
+        }
+
+        headers.push_back(header);
+        tail.clear();
+    }
+};
+
+// Блоки, закодированные смещением от минимума блока
+using FrameOfReferenceVector = BlockPackedVector<FrameOfReferenceEncoding>;
+
+// Блоки отсортированных значений, закодированные разностями соседей
+using DeltaVector = BlockPackedVector<DeltaEncoding>;
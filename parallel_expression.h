@@ -0,0 +1,87 @@
+#pragma once
+
+#include "thread_pool.h"
+#include "vector_expression.h"
+
+#include <algorithm>
+#include <cstddef>
+#include <type_traits>
+#include <utility>
+
+// Параллельное вычисление выражений из vector_expression.h: parallel(a * k + b) при присваивании в SimpleVector
+// делится между потоками пула по умолчанию. Отдельный заголовок, чтобы SimpleVector не тянул за собой пул потоков
+
+// Минимальный размер, начиная с которого параллельное выражение делится между потоками
+inline constexpr size_t kParallelExpressionThreshold = size_t(1) << 18;
+
+// Выражение, которое при достаточном размере вычисляется несколькими потоками
+template <typename Expression>
+class ParallelExpression
+{
+public:
+
+    using value_type = typename Expression::value_type;
+
+    constexpr explicit ParallelExpression(Expression expression) noexcept : expression(std::move(expression)) {}
+
+    constexpr value_type operator[](size_t index) const
+    {
+        return expression[index];
+    }
+
+    constexpr size_t get_size() const noexcept
+    {
+        return expression.get_size();
+    }
+
+private:
+
+    Expression expression;
+};
+
+template <typename Expression>
+inline constexpr bool kIsVectorExpression<ParallelExpression<Expression>> = true;
+
+template <typename Expression>
+inline constexpr bool kIsParallelExpression<ParallelExpression<Expression>> = true;
+
+// Делит вычисление на thread_count равных непрерывных частей и выполняет их в пуле потоков
+template <typename Type, typename Expression>
+void EvaluateExpressionParallel(Type* out, const Expression& expression, size_t thread_count, ThreadPool& pool = DefaultThreadPool())
+{
+    const size_t size = expression.get_size();
+    const size_t chunk = (size + thread_count - 1) / std::max<size_t>(1, thread_count);
+
+    parallel_for(0, size, [out, &expression](size_t first, size_t last)
+        {
+            EvaluateExpressionRange(out, expression, first, last);
+        }, std::max<size_t>(1, chunk), pool);
+}
+
+// Делит выражение между потоками пула по умолчанию, если оно достаточно велико; иначе возвращает false
+template <typename Type, typename Expression>
+bool TryEvaluateExpressionParallel(Type* out, const Expression& expression)
+{
+    const size_t size = expression.get_size();
+    if (size < kParallelExpressionThreshold)
+    {
+        return false;
+    }
+
+    ThreadPool& pool = DefaultThreadPool();
+    const size_t thread_count = std::min(pool.get_thread_count(), size / (kParallelExpressionThreshold / 4));
+    if (thread_count <= 1)
+    {
+        return false;
+    }
+    EvaluateExpressionParallel(out, expression, thread_count, pool);
+    return true;
+}
+
+// Помечает выражение для вычисления несколькими потоками, если его размер достаточно велик
+template <typename Operand> requires ExpressionOperands<Operand>
+constexpr auto parallel(const Operand& operand)
+{
+    using Expression = decltype(MakeExpressionOperand(operand));
+    return ParallelExpression<Expression>(MakeExpressionOperand(operand));
+}
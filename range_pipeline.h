@@ -0,0 +1,477 @@
+#pragma once
+
+#include "simple_vector.h"
+#include "vector_view.h"
+
+#include <algorithm>
+#include <cstddef>
+#include <functional>
+#include <iterator>
+#include <memory>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+
+// Ленивые конвейеры над контейнерами: source | filter(...) | transform(...) | collect<SimpleVector>().
+// Адаптеры ничего не вычисляют при построении; терминальная операция проталкивает каждый элемент
+// через все стадии сразу, поэтому конвейер из N стадий проходит источник один раз и выделяет память один раз.
+// Стадия хранит ссылку на источник и не должна его переживать.
+//
+// Каждая стадия умеет:
+//   for_each(sink) - передает элементы в sink по одному, пока тот возвращает true; возвращает false при досрочной остановке
+//   size_hint()    - точное количество элементов или его верхняя граница, если стадия отбрасывает элементы
+
+template <typename Type>
+inline constexpr bool kIsPipelineStage = false;
+
+template <typename Type>
+inline constexpr bool kIsPipelineAdaptor = false;
+
+template <typename Type>
+concept PipelineStage = kIsPipelineStage<std::remove_cvref_t<Type>>;
+
+template <typename Type>
+concept PipelineAdaptor = kIsPipelineAdaptor<std::remove_cvref_t<Type>>;
+
+// Источник конвейера: любой контейнер с begin() и end()
+template <typename Container>
+concept PipelineSource = !PipelineStage<Container> && requires(const Container& container) { container.begin(); container.end(); };
+
+//================================================================ Стадии ==================================================================================
+
+// Начало конвейера: элементы контейнера по константной ссылке
+template <typename Container>
+class SourceStage
+{
+public:
+
+    using Iterator = decltype(std::declval<const Container&>().begin());
+    using value_type = std::remove_cvref_t<decltype(*std::declval<Iterator>())>;
+
+    // Элементы лежат подряд, и части источника можно отдавать представлениями
+    static constexpr bool kContiguous = std::contiguous_iterator<Iterator>;
+
+    constexpr explicit SourceStage(const Container& container) noexcept : container(&container) {}
+
+    template <typename Sink>
+    constexpr bool for_each(Sink&& sink) const
+    {
+        for (const auto& value : *container)
+        {
+            if (!sink(value))
+            {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    constexpr size_t size_hint() const
+    {
+        return static_cast<size_t>(std::distance(container->begin(), container->end()));
+    }
+
+    constexpr const Container& get_container() const noexcept
+    {
+        return *container;
+    }
+
+private:
+
+    const Container* container;
+};
+
+template <typename Container>
+inline constexpr bool kIsPipelineStage<SourceStage<Container>> = true;
+
+// Элементы, для которых predicate возвращает true
+template <typename Upstream, typename Predicate>
+class FilterStage
+{
+public:
+
+    using value_type = typename Upstream::value_type;
+
+    constexpr FilterStage(Upstream upstream, Predicate predicate) : upstream(std::move(upstream)), predicate(std::move(predicate)) {}
+
+    template <typename Sink>
+    constexpr bool for_each(Sink&& sink) const
+    {
+        return upstream.for_each([this, &sink](auto&& value)
+            {
+                return !std::invoke(predicate, std::as_const(value)) || sink(std::forward<decltype(value)>(value));
+            });
+    }
+
+    // Верхняя граница: фильтр может пропустить все элементы
+    constexpr size_t size_hint() const
+    {
+        return upstream.size_hint();
+    }
+
+private:
+
+    Upstream upstream;
+    Predicate predicate;
+};
+
+template <typename Upstream, typename Predicate>
+inline constexpr bool kIsPipelineStage<FilterStage<Upstream, Predicate>> = true;
+
+// Результаты function от каждого элемента
+template <typename Upstream, typename Function>
+class TransformStage
+{
+public:
+
+    using value_type = std::remove_cvref_t<std::invoke_result_t<const Function&, const typename Upstream::value_type&>>;
+
+    constexpr TransformStage(Upstream upstream, Function function) : upstream(std::move(upstream)), function(std::move(function)) {}
+
+    template <typename Sink>
+    constexpr bool for_each(Sink&& sink) const
+    {
+        return upstream.for_each([this, &sink](auto&& value)
+            {
+                return sink(std::invoke(function, std::forward<decltype(value)>(value)));
+            });
+    }
+
+    constexpr size_t size_hint() const
+    {
+        return upstream.size_hint();
+    }
+
+private:
+
+    Upstream upstream;
+    Function function;
+};
+
+template <typename Upstream, typename Function>
+inline constexpr bool kIsPipelineStage<TransformStage<Upstream, Function>> = true;
+
+// Первые count элементов; остальные стадии до конца источника не доходят
+template <typename Upstream>
+class TakeStage
+{
+public:
+
+    using value_type = typename Upstream::value_type;
+
+    constexpr TakeStage(Upstream upstream, size_t count) : upstream(std::move(upstream)), count(count) {}
+
+    template <typename Sink>
+    constexpr bool for_each(Sink&& sink) const
+    {
+        if (count == 0)
+        {
+            return true;
+        }
+
+        size_t taken = 0;
+        bool sink_stopped = false;
+        upstream.for_each([this, &sink, &taken, &sink_stopped](auto&& value)
+            {
+                if (!sink(std::forward<decltype(value)>(value)))
+                {
+                    sink_stopped = true;
+                    return false;
+                }
+                return ++taken < count;
+            });
+        return !sink_stopped;
+    }
+
+    constexpr size_t size_hint() const
+    {
+        return std::min(count, upstream.size_hint());
+    }
+
+private:
+
+    Upstream upstream;
+    size_t count;
+};
+
+template <typename Upstream>
+inline constexpr bool kIsPipelineStage<TakeStage<Upstream>> = true;
+
+// Пары (номер, элемент)
+template <typename Upstream>
+class EnumerateStage
+{
+public:
+
+    using value_type = std::pair<size_t, typename Upstream::value_type>;
+
+    constexpr explicit EnumerateStage(Upstream upstream) : upstream(std::move(upstream)) {}
+
+    template <typename Sink>
+    constexpr bool for_each(Sink&& sink) const
+    {
+        size_t index = 0;
+        return upstream.for_each([&sink, &index](auto&& value)
+            {
+                return sink(value_type(index++, std::forward<decltype(value)>(value)));
+            });
+    }
+
+    constexpr size_t size_hint() const
+    {
+        return upstream.size_hint();
+    }
+
+private:
+
+    Upstream upstream;
+};
+
+template <typename Upstream>
+inline constexpr bool kIsPipelineStage<EnumerateStage<Upstream>> = true;
+
+// Пары из элемента конвейера и элемента контейнера с тем же номером; заканчивается на более коротком
+template <typename Upstream, typename Other>
+class ZipStage
+{
+public:
+
+    using OtherIterator = decltype(std::declval<const Other&>().begin());
+    using value_type = std::pair<typename Upstream::value_type, std::remove_cvref_t<decltype(*std::declval<OtherIterator>())>>;
+
+    constexpr ZipStage(Upstream upstream, const Other& other) : upstream(std::move(upstream)), other(&other) {}
+
+    template <typename Sink>
+    constexpr bool for_each(Sink&& sink) const
+    {
+        OtherIterator current = other->begin();
+        const OtherIterator last = other->end();
+        bool sink_stopped = false;
+
+        upstream.for_each([&sink, &current, &last, &sink_stopped](auto&& value)
+            {
+                if (current == last)
+                {
+                    return false;
+                }
+                if (!sink(value_type(std::forward<decltype(value)>(value), *current++)))
+                {
+                    sink_stopped = true;
+                    return false;
+                }
+                return true;
+            });
+        return !sink_stopped;
+    }
+
+    constexpr size_t size_hint() const
+    {
+        return std::min(upstream.size_hint(), static_cast<size_t>(std::distance(other->begin(), other->end())));
+    }
+
+private:
+
+    Upstream upstream;
+    const Other* other;
+};
+
+template <typename Upstream, typename Other>
+inline constexpr bool kIsPipelineStage<ZipStage<Upstream, Other>> = true;
+
+// Части по count элементов, последняя может быть короче. Части непрерывного источника отдаются
+// представлениями VectorView без копирования, в остальных случаях собираются в SimpleVector
+template <typename Upstream>
+class ChunkStage
+{
+public:
+
+    using element_type = typename Upstream::value_type;
+
+    static constexpr bool kViews = requires { requires Upstream::kContiguous; };
+
+    using value_type = std::conditional_t<kViews, VectorView<element_type>, SimpleVector<element_type>>;
+
+    constexpr ChunkStage(Upstream upstream, size_t count) : upstream(std::move(upstream)), count(count)
+    {
+        if (count == 0)
+        {
+            throw std::invalid_argument("Chunk size must be positive");
+        }
+    }
+
+    template <typename Sink>
+    constexpr bool for_each(Sink&& sink) const
+    {
+        if constexpr (kViews)
+        {
+            const element_type* first = std::to_address(upstream.get_container().begin());
+            const size_t size = upstream.size_hint();
+            for (size_t offset = 0; offset < size; offset += count)
+            {
+                if (!sink(value_type(first + offset, std::min(count, size - offset))))
+                {
+                    return false;
+                }
+            }
+            return true;
+        }
+        else
+        {
+            value_type chunk;
+            chunk.reserve(count);
+            bool sink_stopped = false;
+
+            upstream.for_each([this, &sink, &chunk, &sink_stopped](auto&& value)
+                {
+                    chunk.push_back(std::forward<decltype(value)>(value));
+                    if (chunk.get_size() < count)
+                    {
+                        return true;
+                    }
+
+                    value_type full = std::move(chunk);
+                    chunk.reserve(count);
+                    sink_stopped = !sink(std::move(full));
+                    return !sink_stopped;
+                });
+
+            if (!sink_stopped && !chunk.is_empty())
+            {
+                return sink(std::move(chunk));
+            }
+            return !sink_stopped;
+        }
+    }
+
+    constexpr size_t size_hint() const
+    {
+        return (upstream.size_hint() + count - 1) / count;
+    }
+
+private:
+
+    Upstream upstream;
+    size_t count;
+};
+
+template <typename Upstream>
+inline constexpr bool kIsPipelineStage<ChunkStage<Upstream>> = true;
+
+//================================================================ Адаптеры ================================================================================
+
+// Адаптер хранит параметры стадии и присоединяет её к конвейеру слева от оператора |
+template <typename Make>
+class PipelineAdaptorClosure
+{
+public:
+
+    constexpr explicit PipelineAdaptorClosure(Make make) : make(std::move(make)) {}
+
+    template <typename Stage>
+    constexpr auto operator()(Stage stage) const
+    {
+        return make(std::move(stage));
+    }
+
+private:
+
+    Make make;
+};
+
+template <typename Make>
+inline constexpr bool kIsPipelineAdaptor<PipelineAdaptorClosure<Make>> = true;
+
+template <typename Predicate>
+constexpr auto filter(Predicate predicate)
+{
+    return PipelineAdaptorClosure([predicate = std::move(predicate)]<typename Stage>(Stage stage)
+        {
+            return FilterStage<Stage, Predicate>(std::move(stage), predicate);
+        });
+}
+
+template <typename Function>
+constexpr auto transform(Function function)
+{
+    return PipelineAdaptorClosure([function = std::move(function)]<typename Stage>(Stage stage)
+        {
+            return TransformStage<Stage, Function>(std::move(stage), function);
+        });
+}
+
+constexpr auto take(size_t count)
+{
+    return PipelineAdaptorClosure([count]<typename Stage>(Stage stage)
+        {
+            return TakeStage<Stage>(std::move(stage), count);
+        });
+}
+
+constexpr auto chunk(size_t count)
+{
+    return PipelineAdaptorClosure([count]<typename Stage>(Stage stage)
+        {
+            return ChunkStage<Stage>(std::move(stage), count);
+        });
+}
+
+constexpr auto enumerate()
+{
+    return PipelineAdaptorClosure([]<typename Stage>(Stage stage)
+        {
+            return EnumerateStage<Stage>(std::move(stage));
+        });
+}
+
+template <typename Other> requires PipelineSource<Other>
+constexpr auto zip(const Other& other)
+{
+    return PipelineAdaptorClosure([&other]<typename Stage>(Stage stage)
+        {
+            return ZipStage<Stage, Other>(std::move(stage), other);
+        });
+}
+
+// Терминальная операция: собирает элементы в Container<value_type>, один раз резервируя size_hint()
+template <template <typename...> class Container>
+class CollectAdaptor
+{
+public:
+
+    template <typename Stage>
+    constexpr auto operator()(const Stage& stage) const
+    {
+        Container<typename Stage::value_type> result;
+        result.reserve(stage.size_hint());
+
+        stage.for_each([&result](auto&& value)
+            {
+                result.push_back(std::forward<decltype(value)>(value));
+                return true;
+            });
+        return result;
+    }
+};
+
+template <template <typename...> class Container>
+inline constexpr bool kIsPipelineAdaptor<CollectAdaptor<Container>> = true;
+
+template <template <typename...> class Container = SimpleVector>
+constexpr CollectAdaptor<Container> collect()
+{
+    return {};
+}
+
+//================================================= Блок перегруженных операторов =========================================================
+
+template <typename Stage, typename Adaptor> requires PipelineStage<Stage> && PipelineAdaptor<Adaptor>
+constexpr auto operator|(Stage stage, const Adaptor& adaptor)
+{
+    return adaptor(std::move(stage));
+}
+
+template <typename Container, typename Adaptor> requires PipelineSource<Container> && PipelineAdaptor<Adaptor>
+constexpr auto operator|(const Container& container, const Adaptor& adaptor)
+{
+    return adaptor(SourceStage<Container>(container));
+}
@@ -0,0 +1,176 @@
+#pragma once
+
+#include "buffer_recycler.h"
+
+#include <cstddef>
+#include <cstring>
+#include <memory>
+#include <type_traits>
+#include <utility>
+
+// Неинициализированная память под capacity элементов. В отличие от ArrayPtr не создает объекты:
+// владелец сам создает их через std::construct_at и уничтожает через std::destroy_at,
+// поэтому в памяти живут ровно те элементы, которые в ней хранятся.
+// Память берется у std::allocator, что позволяет пользоваться классом при вычислении на этапе компиляции.
+// При сборке с SIMPLE_VECTOR_BUFFER_RECYCLER во время выполнения буферы до BufferRecycler::kMaxBytes байт с обычным
+// выравниванием проходят через кэш потока BufferRecycler: освобожденный буфер достается следующему выделению того же класса
+template <typename Type>
+class RawMemory
+{
+public:
+
+    constexpr RawMemory() noexcept = default;
+
+    // Выделяет память под capacity элементов
+    constexpr explicit RawMemory(size_t capacity) : buffer(Allocate(capacity)), capacity(capacity) {}
+
+    RawMemory(const RawMemory&) = delete;
+    RawMemory& operator=(const RawMemory&) = delete;
+
+    constexpr RawMemory(RawMemory&& other) noexcept
+    {
+        swap(other);
+    }
+
+    constexpr RawMemory& operator=(RawMemory&& rhs) noexcept
+    {
+        if (this != &rhs)
+        {
+            RawMemory temp(std::move(rhs));
+            swap(temp);
+        }
+        return *this;
+    }
+
+    // Освобождает память; элементы к этому моменту должны быть уничтожены владельцем
+    constexpr ~RawMemory()
+    {
+        Deallocate(buffer, capacity);
+    }
+
+    // Адрес элемента по индексу, в том числе ещё не созданного O(1)
+    constexpr Type* operator+(size_t offset) noexcept
+    {
+        return buffer + offset;
+    }
+
+    constexpr const Type* operator+(size_t offset) const noexcept
+    {
+        return buffer + offset;
+    }
+
+    // Ссылка на созданный элемент по индексу O(1)
+    constexpr Type& operator[](size_t index) noexcept
+    {
+        return buffer[index];
+    }
+
+    constexpr const Type& operator[](size_t index) const noexcept
+    {
+        return buffer[index];
+    }
+
+    // Адрес начала памяти O(1)
+    constexpr Type* get() const noexcept
+    {
+        return buffer;
+    }
+
+    // Количество элементов, под которые выделена память O(1)
+    constexpr size_t get_capacity() const noexcept
+    {
+        return capacity;
+    }
+
+    // Обмен значений O(1)
+    constexpr void swap(RawMemory& other) noexcept
+    {
+        std::swap(buffer, other.buffer);
+        std::swap(capacity, other.capacity);
+    }
+
+private:
+
+    Type* buffer = nullptr;
+    size_t capacity = 0;
+
+    // Подходит ли буфер под count элементов для BufferRecycler: решение зависит только от count,
+    // поэтому выделение и освобождение одного буфера всегда идут одним путем O(1)
+    static constexpr bool IsRecyclable(size_t count) noexcept
+    {
+#if SIMPLE_VECTOR_BUFFER_RECYCLER
+        return alignof(Type) <= __STDCPP_DEFAULT_NEW_ALIGNMENT__ && count <= BufferRecycler::kMaxBytes / sizeof(Type);
+#else
+        (void)count;
+        return false;
+#endif
+    }
+
+    static constexpr Type* Allocate(size_t count)
+    {
+        if (count == 0)
+        {
+            return nullptr;
+        }
+        if (!std::is_constant_evaluated() && IsRecyclable(count))
+        {
+            return static_cast<Type*>(BufferRecycler::allocate_buffer(count * sizeof(Type)));
+        }
+        return std::allocator<Type>().allocate(count);
+    }
+
+    static constexpr void Deallocate(Type* memory, size_t count) noexcept
+    {
+        if (memory == nullptr)
+        {
+            return;
+        }
+        if (!std::is_constant_evaluated() && IsRecyclable(count))
+        {
+            BufferRecycler::deallocate_buffer(memory, count * sizeof(Type));
+            return;
+        }
+        std::allocator<Type>().deallocate(memory, count);
+    }
+};
+
+// Создает начиная с out элементы из [first, last) при переносе в новую память O(N).
+// Тривиально копируемые типы копируются memcpy. Остальные перемещаются, если перемещение не бросает исключений
+// или копирования нет, иначе копируются, как в std::move_if_noexcept: при исключении исходные элементы не тронуты,
+// а уже созданные в out уничтожаются
+template <typename Type>
+constexpr void UninitializedRelocate(Type* first, Type* last, Type* out)
+{
+    if constexpr (std::is_trivially_copyable_v<Type>)
+    {
+        if (!std::is_constant_evaluated())
+        {
+            if (first != last)
+            {
+                std::memcpy(static_cast<void*>(out), static_cast<const void*>(first), static_cast<size_t>(last - first) * sizeof(Type));
+            }
+            return;
+        }
+    }
+
+    Type* current = out;
+    try
+    {
+        for (; first != last; ++first, ++current)
+        {
+            if constexpr (std::is_nothrow_move_constructible_v<Type> || !std::is_copy_constructible_v<Type>)
+            {
+                std::construct_at(current, std::move(*first));
+            }
+            else
+            {
+                std::construct_at(current, std::as_const(*first));
+            }
+        }
+    }
+    catch (...)
+    {
+        std::destroy(out, current);
+        throw;
+    }
+}
@@ -0,0 +1,562 @@
+#pragma once
+
+#include "raw_memory.h"
+
+#include <algorithm>
+#include <bit>
+#include <cassert>
+#include <initializer_list>
+#include <iterator>
+#include <memory>
+#include <span>
+#include <stdexcept>
+#include <utility>
+
+// Кольцевой буфер с ростом по образцу SimpleVector: добавление и удаление с обоих концов за O(1).
+// Вместимость всегда степень двойки, поэтому перенос индекса через край выполняется маской.
+// Память - RawMemory, как у SimpleVector: созданы только элементы [head, head + size) по модулю вместимости,
+// а при росте элементы переносятся через UninitializedRelocate со строгой гарантией
+template <typename Type>
+class RingBuffer
+{
+public:
+
+    // Итератор произвольного доступа с переносом через край буфера
+    template <bool IsConst>
+    class BasicIterator
+    {
+    public:
+
+        using BufferPointer = std::conditional_t<IsConst, const RingBuffer*, RingBuffer*>;
+
+        using iterator_category = std::random_access_iterator_tag;
+        using value_type = Type;
+        using difference_type = std::ptrdiff_t;
+        using pointer = std::conditional_t<IsConst, const Type*, Type*>;
+        using reference = std::conditional_t<IsConst, const Type&, Type&>;
+
+        BasicIterator() = default;
+
+        BasicIterator(BufferPointer buffer, size_t index) noexcept : buffer(buffer), index(index) {}
+
+        // Неконстантный итератор приводится к константному
+        operator BasicIterator<true>() const noexcept requires (!IsConst)
+        {
+            return BasicIterator<true>(buffer, index);
+        }
+
+        reference operator*() const noexcept
+        {
+            return (*buffer)[index];
+        }
+
+        pointer operator->() const noexcept
+        {
+            return &(*buffer)[index];
+        }
+
+        reference operator[](difference_type offset) const noexcept
+        {
+            return (*buffer)[index + offset];
+        }
+
+        BasicIterator& operator++() noexcept
+        {
+            ++index;
+            return *this;
+        }
+
+        BasicIterator operator++(int) noexcept
+        {
+            BasicIterator temp(*this);
+            ++index;
+            return temp;
+        }
+
+        BasicIterator& operator--() noexcept
+        {
+            --index;
+            return *this;
+        }
+
+        BasicIterator operator--(int) noexcept
+        {
+            BasicIterator temp(*this);
+            --index;
+            return temp;
+        }
+
+        BasicIterator& operator+=(difference_type offset) noexcept
+        {
+            index += offset;
+            return *this;
+        }
+
+        BasicIterator& operator-=(difference_type offset) noexcept
+        {
+            index -= offset;
+            return *this;
+        }
+
+        BasicIterator operator+(difference_type offset) const noexcept
+        {
+            return BasicIterator(buffer, index + offset);
+        }
+
+        BasicIterator operator-(difference_type offset) const noexcept
+        {
+            return BasicIterator(buffer, index - offset);
+        }
+
+        difference_type operator-(const BasicIterator& other) const noexcept
+        {
+            return static_cast<difference_type>(index) - static_cast<difference_type>(other.index);
+        }
+
+        bool operator==(const BasicIterator& other) const noexcept
+        {
+            return index == other.index;
+        }
+
+        bool operator!=(const BasicIterator& other) const noexcept
+        {
+            return index != other.index;
+        }
+
+        bool operator<(const BasicIterator& other) const noexcept
+        {
+            return index < other.index;
+        }
+
+        bool operator>(const BasicIterator& other) const noexcept
+        {
+            return index > other.index;
+        }
+
+        bool operator<=(const BasicIterator& other) const noexcept
+        {
+            return index <= other.index;
+        }
+
+        bool operator>=(const BasicIterator& other) const noexcept
+        {
+            return index >= other.index;
+        }
+
+    private:
+
+        BufferPointer buffer = nullptr;
+        size_t index = 0;
+    };
+
+    using Iterator = BasicIterator<false>;
+    using ConstIterator = BasicIterator<true>;
+
+//===================================================================== Конструкторы и деструктор ==========================================================
+
+    RingBuffer() noexcept = default;
+
+    // Создает буфер с помощью {}
+    RingBuffer(std::initializer_list<Type> init)
+    {
+        reserve(init.size());
+        for (const Type& value : init)
+        {
+            push_back(value);
+        }
+    }
+
+    // Конструктор копирования O(N)
+    RingBuffer(const RingBuffer& other)
+    {
+        reserve(other.size);
+        for (const Type& value : other)
+        {
+            push_back(value);
+        }
+    }
+
+    // Конструктор перемещения
+    RingBuffer(RingBuffer&& other) noexcept
+    {
+        swap(other);
+    }
+
+    ~RingBuffer()
+    {
+        clear();
+    }
+
+//================================================================ Операторы ===============================================================================
+
+    // Элемент по логическому индексу O(1)
+    Type& operator[](size_t index) noexcept
+    {
+        assert(index < size);
+        return items[(head + index) & (get_capacity() - 1)];
+    }
+
+    // Константный элемент по логическому индексу O(1)
+    const Type& operator[](size_t index) const noexcept
+    {
+        assert(index < size);
+        return items[(head + index) & (get_capacity() - 1)];
+    }
+
+    // Оператор присваивания O(N)
+    RingBuffer& operator=(const RingBuffer& rhs)
+    {
+        if (this != &rhs)
+        {
+            RingBuffer temp(rhs);
+            swap(temp);
+        }
+        return *this;
+    }
+
+    // Оператор присваивания перемещением O(1)
+    RingBuffer& operator=(RingBuffer&& rhs) noexcept
+    {
+        if (this != &rhs)
+        {
+            RingBuffer temp(std::move(rhs));
+            swap(temp);
+        }
+        return *this;
+    }
+
+//===================================================================== Итераторы ==========================================================================
+
+    Iterator begin() noexcept
+    {
+        return Iterator(this, 0);
+    }
+
+    Iterator end() noexcept
+    {
+        return Iterator(this, size);
+    }
+
+    ConstIterator begin() const noexcept
+    {
+        return ConstIterator(this, 0);
+    }
+
+    ConstIterator end() const noexcept
+    {
+        return ConstIterator(this, size);
+    }
+
+//===================================================================== Методы =============================================================================
+
+//------------------------------------------------------------- Заполнение и добавление --------------------------------------------------------------------
+
+    // Добавление в конец с копированием O(1) амортизированно
+    void push_back(const Type& item)
+    {
+        emplace_back(item);
+    }
+
+    // Добавление в конец с перемещением O(1) амортизированно
+    void push_back(Type&& item)
+    {
+        emplace_back(std::move(item));
+    }
+
+    // Добавление в начало с копированием O(1) амортизированно
+    void push_front(const Type& item)
+    {
+        emplace_front(item);
+    }
+
+    // Добавление в начало с перемещением O(1) амортизированно
+    void push_front(Type&& item)
+    {
+        emplace_front(std::move(item));
+    }
+
+    // Создание элемента в конце O(1) амортизированно.
+    // При росте новый элемент создается до переноса старых: аргументы могут ссылаться на элементы самого буфера
+    template <typename... Args>
+    Type& emplace_back(Args&&... args)
+    {
+        if (size == get_capacity())
+        {
+            RawMemory<Type> temp(std::max<size_t>(1, get_capacity() * 2));
+            std::construct_at(temp + size, std::forward<Args>(args)...);
+            Relocate(temp, size, 1);
+        }
+        else
+        {
+            std::construct_at(items + ((head + size) & (get_capacity() - 1)), std::forward<Args>(args)...);
+        }
+        ++size;
+        return (*this)[size - 1];
+    }
+
+    // Создание элемента в начале O(1) амортизированно; при росте дает строгую гарантию, как emplace_back
+    template <typename... Args>
+    Type& emplace_front(Args&&... args)
+    {
+        if (size == get_capacity())
+        {
+            const size_t new_capacity = std::max<size_t>(1, get_capacity() * 2);
+            RawMemory<Type> temp(new_capacity);
+            std::construct_at(temp + (new_capacity - 1), std::forward<Args>(args)...);
+            Relocate(temp, new_capacity - 1, 1);
+            head = new_capacity - 1;
+        }
+        else
+        {
+            const size_t new_head = (head - 1) & (get_capacity() - 1);
+            std::construct_at(items + new_head, std::forward<Args>(args)...);
+            head = new_head;
+        }
+        ++size;
+        return items[head];
+    }
+
+//-------------------------------------------------------------- Получение значений ------------------------------------------------------------------------
+
+    // Текущий размер O(1)
+    size_t get_size() const noexcept
+    {
+        return size;
+    }
+
+    // Вместимость O(1)
+    size_t get_capacity() const noexcept
+    {
+        return items.get_capacity();
+    }
+
+    // Проверка на пустоту O(1)
+    bool is_empty() const noexcept
+    {
+        return size == 0;
+    }
+
+    // Ссылка на первый элемент O(1)
+    Type& front()
+    {
+        if (size == 0)
+        {
+            throw std::out_of_range("Buffer is empty!");
+        }
+        return items[head];
+    }
+
+    // Константная ссылка на первый элемент O(1)
+    const Type& front() const
+    {
+        if (size == 0)
+        {
+            throw std::out_of_range("Buffer is empty!");
+        }
+        return items[head];
+    }
+
+    // Ссылка на последний элемент O(1)
+    Type& back()
+    {
+        if (size == 0)
+        {
+            throw std::out_of_range("Buffer is empty!");
+        }
+        return (*this)[size - 1];
+    }
+
+    // Константная ссылка на последний элемент O(1)
+    const Type& back() const
+    {
+        if (size == 0)
+        {
+            throw std::out_of_range("Buffer is empty!");
+        }
+        return (*this)[size - 1];
+    }
+
+    // Ссылка на элемент по индексу с проверкой O(1)
+    Type& at(size_t index)
+    {
+        if (index >= size)
+        {
+            throw std::out_of_range("Out of range");
+        }
+        return (*this)[index];
+    }
+
+    // Константная ссылка на элемент по индексу с проверкой O(1)
+    const Type& at(size_t index) const
+    {
+        if (index >= size)
+        {
+            throw std::out_of_range("Out of range");
+        }
+        return (*this)[index];
+    }
+
+    // Содержимое в виде двух непрерывных участков: от головы до края буфера и от начала буфера O(1)
+    std::pair<std::span<Type>, std::span<Type>> as_spans() noexcept
+    {
+        const size_t first_size = std::min(size, get_capacity() - head);
+        return { std::span<Type>(items.get() + head, first_size), std::span<Type>(items.get(), size - first_size) };
+    }
+
+    // Константные непрерывные участки содержимого O(1)
+    std::pair<std::span<const Type>, std::span<const Type>> as_spans() const noexcept
+    {
+        const size_t first_size = std::min(size, get_capacity() - head);
+        return { std::span<const Type>(items.get() + head, first_size), std::span<const Type>(items.get(), size - first_size) };
+    }
+
+    // Переставляет элементы в начало буфера без выделения памяти и возвращает указатель на них.
+    // O(1), если содержимое уже непрерывно, иначе O(capacity). Если перемещение бросает исключение, гарантия базовая
+    Type* linearize()
+    {
+        const size_t capacity = get_capacity();
+        if (head + size > capacity)
+        {
+            // Хвост [0, tail) остается на месте, а участок [head, capacity) сдвигается влево вплотную к нему,
+            // занимая свободные ячейки: первые gap перемещений создают элементы, остальные присваивают
+            const size_t tail = head + size - capacity;
+            const size_t gap = capacity - size;
+            for (size_t from = head; from < capacity; ++from)
+            {
+                if (from - head < gap)
+                {
+                    std::construct_at(items + (from - gap), std::move(items[from]));
+                }
+                else
+                {
+                    items[from - gap] = std::move(items[from]);
+                }
+            }
+            std::destroy(items + std::max(head, capacity - gap), items + capacity);
+
+            std::rotate(items.get(), items + tail, items + size);
+            head = 0;
+        }
+        return items + head;
+    }
+
+//------------------------------------------------------------------- Работа с размером --------------------------------------------------------------------
+
+    // Резервирование места, вместимость округляется до степени двойки O(N)
+    void reserve(size_t new_capacity)
+    {
+        if (new_capacity > get_capacity())
+        {
+            Reallocate(std::bit_ceil(new_capacity));
+        }
+    }
+
+    // Приравнять вместимость к ближайшей степени двойки, не меньшей размера O(N)
+    void shrink_to_fit()
+    {
+        const size_t new_capacity = size == 0 ? 0 : std::bit_ceil(size);
+        if (new_capacity < get_capacity())
+        {
+            Reallocate(new_capacity);
+        }
+    }
+
+//------------------------------------------------------------------------ Очистка и удаление --------------------------------------------------------------
+
+    // Очистить буфер O(N)
+    void clear() noexcept
+    {
+        const auto [first, second] = as_spans();
+        std::destroy(first.begin(), first.end());
+        std::destroy(second.begin(), second.end());
+        head = 0;
+        size = 0;
+    }
+
+    // Удаление первого элемента O(1)
+    void pop_front() noexcept
+    {
+        assert(size > 0);
+
+        std::destroy_at(items + head);
+        head = (head + 1) & (get_capacity() - 1);
+        --size;
+    }
+
+    // Удаление последнего элемента O(1)
+    void pop_back() noexcept
+    {
+        assert(size > 0);
+
+        std::destroy_at(&(*this)[size - 1]);
+        --size;
+    }
+
+//--------------------------------------------------------------------- Прочие методы ----------------------------------------------------------------------
+
+    // Обмен значений O(1)
+    void swap(RingBuffer& other) noexcept
+    {
+        items.swap(other.items);
+        std::swap(head, other.head);
+        std::swap(size, other.size);
+    }
+
+private:
+
+    // Память под элементы: созданы ровно size элементов, начиная с head, с переносом через край
+    RawMemory<Type> items;
+    size_t head = 0;
+    size_t size = 0;
+
+    // Переносит элементы в new_items, раскладывая их с нулевого индекса, уничтожает старые и забирает new_items себе O(N).
+    // В new_items уже могут быть созданы новые элементы [added_first, added_first + added_count): если перенос
+    // выбросит исключение, они уничтожаются, а буфер остается прежним (строгая гарантия)
+    void Relocate(RawMemory<Type>& new_items, size_t added_first = 0, size_t added_count = 0)
+    {
+        const auto [first, second] = as_spans();
+        try
+        {
+            UninitializedRelocate(first.data(), first.data() + first.size(), new_items.get());
+            try
+            {
+                UninitializedRelocate(second.data(), second.data() + second.size(), new_items + first.size());
+            }
+            catch (...)
+            {
+                std::destroy_n(new_items.get(), first.size());
+                throw;
+            }
+        }
+        catch (...)
+        {
+            std::destroy_n(new_items + added_first, added_count);
+            throw;
+        }
+        std::destroy(first.begin(), first.end());
+        std::destroy(second.begin(), second.end());
+        items.swap(new_items);
+        head = 0;
+    }
+
+    // Переносит элементы в новый буфер вместимостью new_capacity O(N)
+    void Reallocate(size_t new_capacity)
+    {
+        RawMemory<Type> temp(new_capacity);
+        Relocate(temp);
+    }
+};
+
+//================================================= Блок перегруженных операторов =========================================================
+
+template <typename Type>
+inline bool operator==(const RingBuffer<Type>& lhs, const RingBuffer<Type>& rhs)
+{
+    return std::equal(lhs.begin(), lhs.end(), rhs.begin(), rhs.end());
+}
+
+template <typename Type>
+inline bool operator!=(const RingBuffer<Type>& lhs, const RingBuffer<Type>& rhs)
+{
+    return !(lhs == rhs);
+}
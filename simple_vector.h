@@ -1,20 +1,60 @@
 #pragma once
 
-#include "array_ptr.h"
+#include "memory_pages.h"
+#include "raw_memory.h"
+#include "vector_view.h"
+#include "vector_expression.h"
 
 #include <iostream>
+#include <algorithm>
 #include <cassert>
+#include <compare>
+#include <cstdlib>
+#include <cstring>
 #include <initializer_list>
+#include <iterator>
+#include <limits>
+#include <memory>
 #include <stdexcept>
+#include <type_traits>
+
+// Проверяемые итераторы: итератор хранит вектор и номер его поколения, которое меняется при каждой операции,
+// способной сделать итераторы недействительными (перевыделение, вставка, удаление, обмен). Обращение через
+// устаревший итератор, разыменование вне [begin, end) и сравнение итераторов разных векторов останавливают программу.
+// По умолчанию включены в отладочной сборке; в остальных итератор - обычный указатель без накладных расходов
+#if !defined(SIMPLE_VECTOR_CHECKED_ITERATORS)
+#if defined(_DEBUG)
+#define SIMPLE_VECTOR_CHECKED_ITERATORS 1
+#else
+#define SIMPLE_VECTOR_CHECKED_ITERATORS 0
+#endif
+#endif
+
+// Редко выполняемый путь, который не встраивается в место вызова: код перевыделения не раздувает
+// горячие циклы с push_back, а компилятор выносит его из основной последовательности команд
+#if defined(_MSC_VER) && !defined(__clang__)
+#define SIMPLE_VECTOR_COLD __declspec(noinline)
+#elif defined(__GNUC__) || defined(__clang__)
+#define SIMPLE_VECTOR_COLD [[gnu::noinline, gnu::cold]]
+#else
+#define SIMPLE_VECTOR_COLD
+#endif
+
+// Останавливает программу при ошибке проверяемого итератора
+[[noreturn]] inline void SimpleVectorIteratorFailure(const char* message)
+{
+    std::cerr << "SimpleVector iterator check failed: " << message << std::endl;
+    std::abort();
+}
 
-//       reserve
+// Вспомагательный класс для работы с методом reserve
 class ReserveProxyObj 
 {
 public:
 
-    ReserveProxyObj(size_t capacity) : capacity(capacity){}
+    constexpr ReserveProxyObj(size_t capacity) : capacity(capacity){}
 
-    size_t get_capacity() 
+    constexpr size_t get_capacity() 
     {
         return capacity;
     }
@@ -24,69 +64,295 @@ private:
     size_t capacity;
 };
 
+// Политика возврата памяти после уменьшения вектора. Если заполненность остается ниже min_utilization
+// patience операций удаления подряд, память за последним элементом возвращается: при свободном хвосте
+// от page_release_bytes его страницы отдаются системе без перемещения элементов,
+// иначе буфер перевыделяется с вместимостью вдвое больше размера, но не меньше min_capacity.
+// Запас вдвое не дает вектору, колеблющемуся около порога, перевыделять память на каждой операции
+struct ShrinkPolicy
+{
+    // 0 - политика отключена, память возвращается только явным вызовом
+    size_t patience = 0;
+    double min_utilization = 0.25;
+    size_t min_capacity = 16;
+    bool release_pages = true;
+    size_t page_release_bytes = size_t(1) << 20;
+    // Страницы помечаются свободными и забираются системой только при нехватке памяти
+    bool lazy_release = false;
+};
+
 template <typename Type>
 class SimpleVector 
 {
 public:
 
+#if SIMPLE_VECTOR_CHECKED_ITERATORS
+
+    // Итератор с проверкой действительности и границ
+    template <bool IsConst>
+    class BasicIterator
+    {
+    public:
+
+        using iterator_category = std::random_access_iterator_tag;
+        using iterator_concept = std::contiguous_iterator_tag;
+        using value_type = Type;
+        using difference_type = std::ptrdiff_t;
+        using pointer = std::conditional_t<IsConst, const Type*, Type*>;
+        using reference = std::conditional_t<IsConst, const Type&, Type&>;
+
+        constexpr BasicIterator() noexcept = default;
+
+        constexpr BasicIterator(const SimpleVector* owner, pointer item) noexcept : owner(owner), item(item), generation(owner->generation) {}
+
+        template <bool OtherConst> requires (IsConst && !OtherConst)
+        constexpr BasicIterator(const BasicIterator<OtherConst>& other) noexcept : owner(other.owner), item(other.item), generation(other.generation) {}
+
+        // Не стал ли итератор недействительным после изменения вектора O(1)
+        constexpr bool is_valid() const noexcept
+        {
+            return owner != nullptr && generation == owner->generation;
+        }
+
+        constexpr reference operator*() const
+        {
+            CheckDereferenceable(item);
+            return *item;
+        }
+
+        // Адрес элемента; допустим и для конца вектора, чтобы работал std::to_address O(1)
+        constexpr pointer operator->() const
+        {
+            CheckPosition(item);
+            return item;
+        }
+
+        constexpr reference operator[](difference_type offset) const
+        {
+            CheckDereferenceable(item + offset);
+            return item[offset];
+        }
+
+        constexpr BasicIterator& operator++()
+        {
+            return *this += 1;
+        }
+
+        constexpr BasicIterator operator++(int)
+        {
+            BasicIterator temp(*this);
+            *this += 1;
+            return temp;
+        }
+
+        constexpr BasicIterator& operator--()
+        {
+            return *this -= 1;
+        }
+
+        constexpr BasicIterator operator--(int)
+        {
+            BasicIterator temp(*this);
+            *this -= 1;
+            return temp;
+        }
+
+        constexpr BasicIterator& operator+=(difference_type offset)
+        {
+            CheckPosition(item + offset);
+            item += offset;
+            return *this;
+        }
+
+        constexpr BasicIterator& operator-=(difference_type offset)
+        {
+            return *this += -offset;
+        }
+
+        constexpr BasicIterator operator+(difference_type offset) const
+        {
+            BasicIterator temp(*this);
+            return temp += offset;
+        }
+
+        friend constexpr BasicIterator operator+(difference_type offset, const BasicIterator& it)
+        {
+            return it + offset;
+        }
+
+        constexpr BasicIterator operator-(difference_type offset) const
+        {
+            BasicIterator temp(*this);
+            return temp -= offset;
+        }
+
+        friend constexpr difference_type operator-(const BasicIterator& lhs, const BasicIterator& rhs)
+        {
+            CheckComparable(lhs, rhs);
+            return lhs.item - rhs.item;
+        }
+
+        friend constexpr bool operator==(const BasicIterator& lhs, const BasicIterator& rhs)
+        {
+            CheckComparable(lhs, rhs);
+            return lhs.item == rhs.item;
+        }
+
+        // Проверка на нулевой указатель и сравнение с nullptr, как у указателя: у вектора без памяти итераторы нулевые
+        constexpr explicit operator bool() const noexcept
+        {
+            return item != nullptr;
+        }
+
+        friend constexpr bool operator==(const BasicIterator& it, std::nullptr_t) noexcept
+        {
+            return it.item == nullptr;
+        }
+
+        friend constexpr std::strong_ordering operator<=>(const BasicIterator& lhs, const BasicIterator& rhs)
+        {
+            CheckComparable(lhs, rhs);
+            return lhs.item <=> rhs.item;
+        }
+
+    private:
+
+        friend class SimpleVector;
+        friend class BasicIterator<true>;
+
+        const SimpleVector* owner = nullptr;
+        pointer item = nullptr;
+        size_t generation = 0;
+
+        constexpr void CheckValid() const
+        {
+            if (owner == nullptr)
+            {
+                SimpleVectorIteratorFailure("iterator is not bound to a vector");
+            }
+            if (generation != owner->generation)
+            {
+                SimpleVectorIteratorFailure("iterator was invalidated by a modification of the vector");
+            }
+        }
+
+        // Позиция внутри [begin, end]
+        constexpr void CheckPosition(pointer position) const
+        {
+            CheckValid();
+            if (position < owner->items.get() || position > owner->items.get() + owner->size)
+            {
+                SimpleVectorIteratorFailure("iterator is out of range");
+            }
+        }
+
+        // Позиция внутри [begin, end)
+        constexpr void CheckDereferenceable(pointer position) const
+        {
+            CheckValid();
+            if (position < owner->items.get() || position >= owner->items.get() + owner->size)
+            {
+                SimpleVectorIteratorFailure("dereferencing an iterator outside of [begin, end)");
+            }
+        }
+
+        static constexpr void CheckComparable(const BasicIterator& lhs, const BasicIterator& rhs)
+        {
+            if (lhs.owner != rhs.owner)
+            {
+                SimpleVectorIteratorFailure("comparing iterators of different vectors");
+            }
+            if (lhs.owner != nullptr)
+            {
+                lhs.CheckValid();
+                rhs.CheckValid();
+            }
+        }
+    };
+
+    using Iterator = BasicIterator<false>;
+    using ConstIterator = BasicIterator<true>;
+
+#else
+
     using Iterator = Type*;
     using ConstIterator = const Type*;
 
-//=====================================================================    ==========================================================
+#endif
+
+//===================================================================== Конструкторы и деструктор ==========================================================
 
     SimpleVector() noexcept = default;
 
-    //      
-    explicit SimpleVector(size_t size) : SimpleVector(size, Type()){}
+    // Создает вектор с элементами по умолчанию
+    constexpr explicit SimpleVector(size_t size) : SimpleVector(size, Type()){}
 
-    //     
-    SimpleVector(size_t size, const Type& value) : items(size), size(size), capacity(size)
+    // Создает вектор с заданными элементами
+    constexpr SimpleVector(size_t size, const Type& value) : items(size)
     {
-        std::fill(items.get(), items.get() + size, value);
+        UninitializedFill(items.get(), size, value);
+        this->size = size;
     }
 
-    //     {}
-    SimpleVector(std::initializer_list<Type> init) : items(init.size()), size(init.size()), capacity(init.size())
+    // Создает вектор с помощью {}
+    constexpr SimpleVector(std::initializer_list<Type> init) : items(init.size())
     {
-        std::copy(init.begin(), init.end(), items.get());
+        UninitializedCopy(init.begin(), init.end(), items.get());
+        size = init.size();
     }
 
-    //    
-    explicit SimpleVector(ReserveProxyObj obj)
+    // Конструктор с резервированием места
+    constexpr explicit SimpleVector(ReserveProxyObj obj)
     {
         reserve(obj.get_capacity());
     }
 
-    //   O(N)
-    SimpleVector(const SimpleVector& other) : items(new Type[other.size]), size(other.size)
+    // Конструктор копирования O(N)
+    constexpr SimpleVector(const SimpleVector& other) : items(other.size), shrink_policy(other.shrink_policy)
     {
-        std::copy(other.begin(), other.end(), items.get());
+        UninitializedCopy(other.items.get(), other.items.get() + other.size, items.get());
+        size = other.size;
     }
 
-    //  
-    SimpleVector(SimpleVector&& other) noexcept
+    // Конструктор перемещения
+    constexpr SimpleVector(SimpleVector&& other) noexcept
     {
         swap(other);
     }
 
-//================================================================  ===============================================================================
+    // Создает вектор из поэлементного выражения, вычисляя его за один проход O(N)
+    template <typename Expression> requires VectorExpression<Expression>
+    constexpr SimpleVector(const Expression& expression) : items(expression.get_size())
+    {
+        ConstructForOverwrite(0, expression.get_size());
+        size = expression.get_size();
+        EvaluateExpression(items.get(), expression);
+    }
+
+    // Уничтожает элементы и освобождает память O(N)
+    constexpr ~SimpleVector()
+    {
+        std::destroy_n(items.get(), size);
+    }
+
+//================================================================ Операторы ===============================================================================
  
-    //     O(1)
-    Type& operator[](size_t index) noexcept 
+    // Получение ссылки по индексу O(1)
+    constexpr Type& operator[](size_t index) noexcept 
     {
         assert(index < size);
         return items[index];
     }
 
-    //      O(1)
-    const Type& operator[](size_t index) const noexcept 
+    // Получение константной ссылки по индексу O(1)
+    constexpr const Type& operator[](size_t index) const noexcept 
     {
         assert(index < size);
         return items[index];
     }
 
-    //    O(N)
-    SimpleVector& operator=(const SimpleVector& rhs)
+    // Перегруженный оператор присваивания O(N)
+    constexpr SimpleVector& operator=(const SimpleVector& rhs)
     {
         if (this != &rhs)
         {
@@ -96,203 +362,207 @@ public:
         return *this;
     }
 
-//=====================================================================  ==========================================================================
-    //    O(1)
-    Iterator begin() noexcept
+    // Присваивание поэлементного выражения за один проход; память выделяется, только если не хватает вместимости O(N)
+    template <typename Expression> requires VectorExpression<Expression>
+    constexpr SimpleVector& operator=(const Expression& expression)
     {
-        return items.get();
+        const size_t new_size = expression.get_size();
+        if (new_size > get_capacity())
+        {
+            SimpleVector temp(expression);
+            temp.shrink_policy = shrink_policy;
+            swap(temp);
+        }
+        else
+        {
+            if (new_size < size)
+            {
+                std::destroy(items + new_size, items + size);
+            }
+            else
+            {
+                ConstructForOverwrite(size, new_size);
+            }
+            size = new_size;
+            Invalidate();
+            EvaluateExpression(items.get(), expression);
+        }
+        return *this;
+    }
+
+    // Оператор присваивания перемещением O(1)
+    constexpr SimpleVector& operator=(SimpleVector&& rhs) noexcept
+    {
+        if (this != &rhs)
+        {
+            SimpleVector temp(std::move(rhs));
+            swap(temp);
+        }
+        return *this;
     }
 
-    //    O(1)
-    Iterator end() noexcept
+//===================================================================== Итераторы ==========================================================================
+    // Итератор на начало O(1)
+    constexpr Iterator begin() noexcept
     {
-        return items.get() + size;
+        return MakeIterator(items.get());
     }
 
-    //     O(1)
-    ConstIterator begin() const noexcept
+    // Итератор на конец O(1)
+    constexpr Iterator end() noexcept
     {
-        return items.get();
+        return MakeIterator(items.get() + size);
+    }
+
+    // Константный итератор на начало O(1)
+    constexpr ConstIterator begin() const noexcept
+    {
+        return MakeIterator(items.get());
     }
 
-    //     O(1)
-    ConstIterator end() const noexcept
+    // Константный итератор на конец O(1)
+    constexpr ConstIterator end() const noexcept
     {
-        return items.get() + size;
+        return MakeIterator(items.get() + size);
     }
 
     // O(1)
-    ConstIterator cbegin() const noexcept
+    constexpr ConstIterator cbegin() const noexcept
     {
         return begin();
     }
 
     // O(1)
-    ConstIterator cend() const noexcept
+    constexpr ConstIterator cend() const noexcept
     {
         return end();
     }
 
-//=====================================================================  =============================================================================
+//===================================================================== Методы =============================================================================
     
-//-------------------------------------------------------------    --------------------------------------------------------------------
+//------------------------------------------------------------- Заполнение и добавление --------------------------------------------------------------------
 
-    //      O(N)
-    void push_back(const Type& item)
+    // Создание элемента в конце из аргументов конструктора, амортизированно O(1).
+    // При свободном месте это сравнение, создание элемента и увеличение размера; перевыделение вынесено в EmplaceBackSlow
+    template <typename... Args>
+    constexpr Type& emplace_back(Args&&... args)
     {
-        if (size + 1 > capacity)
+        if (size < get_capacity()) [[likely]]
         {
-            size_t new_capacity = std::max(size + 1, capacity * 2);
-            ArrayPtr<Type> temp(new_capacity);
-
-            std::copy(items.get(), items.get() + size, temp.get());
-
-            items.swap(temp);
-            capacity = new_capacity;
+            Type* item = std::construct_at(items + size, std::forward<Args>(args)...);
+            ++size;
+            return *item;
+        }
+        if constexpr (kPassByValue<Args...>)
+        {
+            // Адрес значения не уходит в медленный путь, и в горячем цикле значение остается в регистре
+            return EmplaceBackSlow(static_cast<Type>(args)...);
         }
+        else
+        {
+            return EmplaceBackSlow(std::forward<Args>(args)...);
+        }
+    }
 
-        items[size] = item;
-        ++size;
+    // Добавление в конец с копированием, амортизированно O(1)
+    constexpr void push_back(const Type& item)
+    {
+        emplace_back(item);
     }
 
-    //      O(N)
-    void push_back(Type&& item)
+    // Добавление в конец с перемещением, амортизированно O(1)
+    constexpr void push_back(Type&& item)
     {
-        if (size + 1 > capacity)
-        {
-            size_t new_capacity = std::max(size + 1, capacity * 2);
-            ArrayPtr<Type> temp(new_capacity);
+        emplace_back(std::move(item));
+    }
 
-            std::move(items.get(), items.get() + size, temp.get());
-            items.swap(temp);
+    // Добавление в конец с копированием без проверки вместимости, для циклов после reserve: место должно быть свободно O(1)
+    constexpr void push_back_unchecked(const Type& item)
+    {
+        assert(size < get_capacity());
 
-            capacity = new_capacity;
-        }
-        items[size] = std::move(item);
+        std::construct_at(items + size, item);
         ++size;
     }
 
-    //     O(N)
-    template <typename InputIterator>
-    void append_range(InputIterator first, InputIterator last)
+    // Добавление в конец с перемещением без проверки вместимости O(1)
+    constexpr void push_back_unchecked(Type&& item)
     {
-        size_t range_size = std::distance(first, last);
-        if (size + range_size > capacity)
-        {
-            size_t new_capacity = std::max(size + range_size, capacity * 2);
-            ArrayPtr<Type> temp(new_capacity);
-
-            std::fill(temp.get(), temp.get() + new_capacity, Type());
-            std::copy(items.get(), items.get() + size, temp.get());
+        assert(size < get_capacity());
 
-            items.swap(temp);
-            capacity = new_capacity;
-        }
-        std::copy(first, last, items.get() + size);
-        size += range_size;
+        std::construct_at(items + size, std::move(item));
+        ++size;
     }
 
-    //     c  O(N)
-    Iterator insert(ConstIterator pos, const Type& value)
+    // Добавление диапазона в конец O(N)
+    template <typename InputIterator>
+    constexpr void append_range(InputIterator first, InputIterator last)
     {
-        assert(pos >= begin() && pos <= end());
-
-        size_t count = pos - items.get();
-
-        if (capacity == 0)
-        {
-            ArrayPtr<Type> temp(1);
-            temp[count] = value;
-            items.swap(temp);
-            ++capacity;
-        }
-        else if (size < capacity)
+        size_t range_size = std::distance(first, last);
+        if (size + range_size > get_capacity())
         {
-            std::copy_backward(items.get() + count, items.get() + size, items.get() + size + 1);
-            items[count] = value;
+            RawMemory<Type> temp(std::max(size + range_size, get_capacity() * 2));
+            UninitializedCopy(first, last, temp + size);
+            Relocate(temp, size, range_size);
         }
         else
         {
-            size_t new_capacity = std::max(size + 1, capacity * 2);
-            ArrayPtr<Type> temp(new_capacity);
-
-            std::copy(items.get(), items.get() + size, temp.get());
-            std::copy_backward(items.get() + count, items.get() + size, temp.get() + size + 1);
-
-            temp[count] = value;
-            items.swap(temp);
-            capacity = new_capacity;
+            UninitializedCopy(first, last, items + size);
         }
-        ++size;
-        return &items[count];
+        size += range_size;
     }
 
-    //       O(N)
-    Iterator insert(Iterator pos, Type&& value)
+    // Вставка в указанное место c копированием O(N)
+    constexpr Iterator insert(ConstIterator pos, const Type& value)
     {
         assert(pos >= begin() && pos <= end());
 
-        size_t count = pos - items.get();
-
-        if (capacity == 0)
-        {
-            ArrayPtr<Type> temp(1);
-
-            temp[count] = std::move(value);
-            items.swap(temp);
-            ++capacity;
-        }
-        else if (size < capacity)
+        if (size < get_capacity() && pos != end())
         {
-            std::move_backward(items.get() + count, items.get() + size, items.get() + size + 1);
-            items[count] = std::move(value);
+            // Копия нужна до сдвига: value может ссылаться на сдвигаемый элемент
+            Type copy(value);
+            return insert(begin() + (pos - begin()), std::move(copy));
         }
-        else
-        {
-            size_t new_capacity = std::max(size + 1, capacity * 2);
-            ArrayPtr<Type> temp(new_capacity);
-
-            std::move(items.get(), items.get() + size, temp.get());
-            std::move_backward(items.get() + count, items.get() + size, temp.get() + size + 1);
+        return Emplace(pos - begin(), value);
+    }
 
-            temp[count] = std::move(value);
-            items.swap(temp);
-            capacity = new_capacity;
-        }
-        ++size;
+    // Вставка в указанное место с перемещением O(N)
+    constexpr Iterator insert(Iterator pos, Type&& value)
+    {
+        assert(pos >= begin() && pos <= end());
 
-        return &items[count];
+        return Emplace(pos - begin(), std::move(value));
     }
 
-//--------------------------------------------------------------   ------------------------------------------------------------------------
+//-------------------------------------------------------------- Получение значений ------------------------------------------------------------------------
  
-     //   O(1)
-    size_t get_size() const noexcept
+     // Текущий размер O(1)
+    constexpr size_t get_size() const noexcept
     {
         return size;
     }
 
-    //   O(1)
-    size_t max_size() const
+    // Максимальный размер O(1)
+    constexpr size_t max_size() const
     {
-        size_t max_size_vec = std::numeric_limits<size_t>::max / sizeof(Type);
+        size_t max_size_vec = std::numeric_limits<size_t>::max() / sizeof(Type);
         return max_size_vec;
     }
 
-    //  O(1)
-    size_t get_capacity() const noexcept
+    // Вместимость O(1)
+    constexpr size_t get_capacity() const noexcept
     {
-        return capacity;
+        return items.get_capacity();
     }
 
-    //    O(1)
-    bool is_empty() const noexcept
+    // Проверка на пустоту O(1)
+    constexpr bool is_empty() const noexcept
     {
         return size == 0;
     }
 
-    //     O(1)
-    Type& front()
+    // Ссылка на первый элемент O(1)
+    constexpr Type& front()
     {
         if (size == 0)
         {
@@ -301,8 +571,8 @@ public:
         return items[0];
     }
 
-    //      O(1)
-    const Type& front() const
+    // Константная ссылка на первый элемент O(1)
+    constexpr const Type& front() const
     {
         if (size == 0)
         {
@@ -311,8 +581,8 @@ public:
         return items[0];
     }
 
-    //     O(1)
-    Type& back()
+    // Ссылка на последний элемент O(1)
+    constexpr Type& back()
     {
         if (size == 0)
         {
@@ -321,8 +591,8 @@ public:
         return items[size - 1];
     }
 
-    //     O(1)
-    const Type& back() const
+    // Константная ссылка последний элемент O(1)
+    constexpr const Type& back() const
     {
         if (size == 0)
         {
@@ -331,20 +601,20 @@ public:
         return items[size - 1];
     }
 
-    //     O(1)
-    Type* data()
+    // Указатель на начало массива O(1)
+    constexpr Type* data()
     {
         return items.get();
     }
 
-    //      O(1)
-    const Type* data() const
+    // Константный указатель на начало массива O(1)
+    constexpr const Type* data() const
     {
         return items.get();
     }
 
-    //      O(1)
-    Type& at(size_t index) 
+    // Ссылка на элемент по индексу O(1)
+    constexpr Type& at(size_t index) 
     {
         if (index >= size)
         {
@@ -353,8 +623,8 @@ public:
         return items[index];
     }
 
-    //       O(1)
-    const Type& at(size_t index) const 
+    // Константная ссылка на элемент по индексу O(1)
+    constexpr const Type& at(size_t index) const 
     {
         if (index >= size)
         {
@@ -363,123 +633,197 @@ public:
         return items[index];
     }
 
-//-------------------------------------------------------------------    --------------------------------------------------------------------
+    // Представление count элементов начиная с индекса first без копирования O(1)
+    constexpr MutableVectorView<Type> slice(size_t first, size_t count)
+    {
+        CheckRange(first, count);
+        return MutableVectorView<Type>(items.get() + first, count);
+    }
 
-    //   O(N)
-    void resize(size_t new_size) 
+    // Константное представление count элементов начиная с индекса first без копирования O(1)
+    constexpr VectorView<Type> slice(size_t first, size_t count) const
+    {
+        CheckRange(first, count);
+        return VectorView<Type>(items.get() + first, count);
+    }
+
+    // Новый вектор из копий count элементов начиная с индекса first O(count)
+    constexpr SimpleVector subvector(size_t first, size_t count) const&
+    {
+        CheckRange(first, count);
+
+        SimpleVector result;
+        result.reserve(count);
+        result.append_range(items.get() + first, items.get() + first + count);
+        return result;
+    }
+
+    // Новый вектор из count элементов начиная с индекса first, забирающий память временного вектора O(count)
+    constexpr SimpleVector subvector(size_t first, size_t count) &&
+    {
+        CheckRange(first, count);
+
+        // При first == 0 элементы уже на месте, а перемещение объекта в самого себя оставляет его в неопределенном состоянии
+        if (first != 0)
+        {
+            std::move(items.get() + first, items.get() + first + count, items.get());
+        }
+        std::destroy(items + count, items + size);
+        size = count;
+        Invalidate();
+        return std::move(*this);
+    }
+
+//------------------------------------------------------------------- Работа с размером --------------------------------------------------------------------
+
+    // Изменить размер O(N)
+    constexpr void resize(size_t new_size) 
     {
         if (new_size <= size) 
         {
+            const size_t old_size = size;
+            std::destroy(items + new_size, items + size);
             size = new_size;
+            Invalidate();
+            NoteShrink(old_size);
         }
-        if (new_size <= capacity) 
+        else if (new_size <= get_capacity()) 
         {
-            fill(items.get() + size, items.get() + new_size);
+            UninitializedValueConstruct(items + size, new_size - size);
+            size = new_size;
         }
-        if (new_size > capacity) 
+        else
         {
-            size_t new_capacity = std::max(new_size, capacity * 2);
-            ArrayPtr<Type> temp(new_capacity);
-
-            fill(temp.get(), temp.get() + new_capacity);
-            std::move(items.get(), items.get() + capacity, temp.get());
-
-            items.swap(temp);
-
+            RawMemory<Type> temp(std::max(new_size, get_capacity() * 2));
+            UninitializedValueConstruct(temp + size, new_size - size);
+            Relocate(temp, size, new_size - size);
             size = new_size;
-            capacity = new_capacity;
         }
     }
 
-    //     O(N)
-    void shrink_to_fit() 
+    // Приравнять вместимость к размеру O(N)
+    constexpr void shrink_to_fit() 
     {
-        if (size < capacity)
+        if (size < get_capacity())
         {
-            ArrayPtr<Type> new_items(size);
-
-            std::copy(items.get(), items.get() + size, new_items.get());
-            items.swap(new_items);
-
-            capacity = size;
+            Reallocate(size);
         }
     }
 
-    //   O(N)
-    void reserve(size_t new_capacity)
+    // Вернуть память за последним элементом по правилам политики, даже если она отключена O(N)
+    constexpr void release_unused_memory()
     {
-        if (new_capacity > capacity)
-        {
-            ArrayPtr<Type> temp(new_capacity);
+        touched_size = get_capacity();
+        ReleaseUnused();
+    }
 
-            std::copy(items.get(), items.get() + size, temp.get());
+    // Установить политику возврата памяти. Политика передается вместе с содержимым при копировании, перемещении и обмене O(1)
+    constexpr void set_shrink_policy(const ShrinkPolicy& policy) noexcept
+    {
+        shrink_policy = policy;
+        low_utilization_streak = 0;
+    }
 
-            items.swap(temp);
-            capacity = new_capacity;
+    // Текущая политика возврата памяти O(1)
+    constexpr const ShrinkPolicy& get_shrink_policy() const noexcept
+    {
+        return shrink_policy;
+    }
+
+    // Резервирование места O(N)
+    constexpr void reserve(size_t new_capacity)
+    {
+        if (new_capacity > get_capacity())
+        {
+            Reallocate(new_capacity);
         }
     }
 
-//------------------------------------------------------------------------    --------------------------------------------------------------
+//------------------------------------------------------------------------ Очистка и удаление --------------------------------------------------------------
     
-    //   O(1)
-    void clear() noexcept
+    // Очистить массив, уничтожив элементы O(N)
+    constexpr void clear() noexcept
     {
+        const size_t old_size = size;
+        std::destroy_n(items.get(), size);
         size = 0;
+        Invalidate();
+        NoteShrink(old_size);
     }
 
-    //    O(1)
-    void pop_back() noexcept
+    // Удаление последнего элемента O(1)
+    constexpr void pop_back() noexcept
     {
         assert(size > 0);
 
+        // Итераторы на остальные элементы остаются действительными, а обращение к удаленному ловит проверка границ
         --size;
-
+        std::destroy_at(items + size);
+        NoteShrink(size + 1);
     }
 
-    //      O(N)
-    Iterator erase(ConstIterator pos)
+    // Удаление элемента в заданной позиции O(N)
+    constexpr Iterator erase(ConstIterator pos)
     {
         assert(pos >= begin() && pos < end());
 
-        size_t count = pos - items.get();
+        size_t count = pos - begin();
 
         if (count > size)
         {
             throw std::out_of_range("Position is out of range");
         }
 
-        std::move(items.get() + count + 1, items.get() + size, items.get() + count);
+        std::move(items + count + 1, items + size, items + count);
         --size;
+        std::destroy_at(items + size);
+        Invalidate();
+        NoteShrink(size + 1);
 
-        return &items[count];
+        return MakeIterator(items + count);
     }
 
-//---------------------------------------------------------------------   ----------------------------------------------------------------------
+//--------------------------------------------------------------------- Прочие методы ----------------------------------------------------------------------
 
-    //     O(N)
-    void assign(size_t new_size, const Type& value) 
+    // Изменяет размер и содержимое O(N)
+    constexpr void assign(size_t new_size, const Type& value) 
     {
-        if (new_size > capacity)
+        if (new_size > get_capacity())
         {
-            ArrayPtr<Type> newData(new_size);
-            items.swap(newData);
-            capacity = new_size;
+            SimpleVector temp(new_size, value);
+            temp.shrink_policy = shrink_policy;
+            swap(temp);
+            return;
         }
 
-        std::fill_n(items.get(), new_size, value);
+        const size_t common = std::min(size, new_size);
+        std::fill_n(items.get(), common, value);
+        if (new_size < size)
+        {
+            std::destroy(items + new_size, items + size);
+        }
+        else
+        {
+            UninitializedFill(items + size, new_size - size, value);
+        }
         size = new_size;
+        Invalidate();
     }
 
-    //   O(N)
-    void swap(SimpleVector& other) noexcept 
+    // Обмен значений O(N)
+    constexpr void swap(SimpleVector& other) noexcept 
     {
-        std::swap(capacity, other.capacity);
         std::swap(size, other.size);
+        std::swap(shrink_policy, other.shrink_policy);
+        std::swap(low_utilization_streak, other.low_utilization_streak);
+        std::swap(touched_size, other.touched_size);
 
         items.swap(other.items);
+        Invalidate();
+        other.Invalidate();
     }
 
-    //   O(N)
+    // Печать массива O(N)
     void print() const
     {
         for (size_t i = 0; i < size; ++i)
@@ -493,62 +837,328 @@ public:
 
 private:
 
-    ArrayPtr<Type> items;
+    // Память под элементы: созданы ровно первые size из них
+    RawMemory<Type> items;
     size_t size = 0;
-    size_t capacity = 0;
+    ShrinkPolicy shrink_policy;
+    size_t low_utilization_streak = 0;
+    // Граница, до которой хвост буфера мог использоваться после последнего возврата страниц
+    size_t touched_size = 0;
+#if SIMPLE_VECTOR_CHECKED_ITERATORS
+    // Поколение итераторов: итераторы с другим номером недействительны
+    size_t generation = 0;
+#endif
+
+    constexpr Iterator MakeIterator(Type* item) noexcept
+    {
+#if SIMPLE_VECTOR_CHECKED_ITERATORS
+        return Iterator(this, item);
+#else
+        return item;
+#endif
+    }
+
+    constexpr ConstIterator MakeIterator(const Type* item) const noexcept
+    {
+#if SIMPLE_VECTOR_CHECKED_ITERATORS
+        return ConstIterator(this, item);
+#else
+        return item;
+#endif
+    }
+
+    // Делает недействительными все выданные итераторы O(1)
+    constexpr void Invalidate() noexcept
+    {
+#if SIMPLE_VECTOR_CHECKED_ITERATORS
+        ++generation;
+#endif
+    }
+
+    // Создает в памяти new_items элементы на местах [0, size), перенося их из текущей памяти,
+    // уничтожает старые элементы и забирает new_items себе O(N).
+    // В new_items уже могут быть созданы новые элементы [added_first, added_first + added_count): если перенос
+    // выбросит исключение, они уничтожаются, а вектор остается прежним (строгая гарантия)
+    constexpr void Relocate(RawMemory<Type>& new_items, size_t added_first = 0, size_t added_count = 0)
+    {
+        try
+        {
+            UninitializedRelocate(items.get(), items + size, new_items.get());
+        }
+        catch (...)
+        {
+            std::destroy_n(new_items + added_first, added_count);
+            throw;
+        }
+        std::destroy_n(items.get(), size);
+        items.swap(new_items);
+        touched_size = size;
+        Invalidate();
+    }
+
+    // Переносит элементы в новый буфер вместимостью new_capacity O(N)
+    constexpr void Reallocate(size_t new_capacity)
+    {
+        RawMemory<Type> temp(new_capacity);
+        Relocate(temp);
+    }
+
+    // Небольшие тривиально копируемые значения передаются в медленный путь копией, а не ссылкой
+    template <typename... Args>
+    static constexpr bool kPassByValue = sizeof...(Args) == 1 && (std::is_same_v<std::remove_cvref_t<Args>, Type> && ...)
+        && std::is_trivially_copyable_v<Type> && sizeof(Type) <= 2 * sizeof(void*);
+
+    // Медленный путь emplace_back: перевыделяет память вдвое и создает элемент в конце O(N).
+    // Новый элемент создается до переноса старых: аргументы могут ссылаться на элементы самого вектора
+    template <typename... Args>
+    SIMPLE_VECTOR_COLD constexpr Type& EmplaceBackSlow(Args&&... args)
+    {
+        RawMemory<Type> temp(std::max(size + 1, get_capacity() * 2));
+        std::construct_at(temp + size, std::forward<Args>(args)...);
+        Relocate(temp, size, 1);
+        ++size;
+        return items[size - 1];
+    }
 
-    //   O(N)
-    static void fill(Iterator first, Iterator last)
+    // Вставляет элемент из value на место count, сдвигая хвост вправо O(N).
+    // При перевыделении дает строгую гарантию. Без него элементы сдвигаются перемещением,
+    // и строгая гарантия сохраняется, если перемещение не бросает исключений, иначе остается базовая
+    template <typename Value>
+    constexpr Iterator Emplace(size_t count, Value&& value)
     {
-        assert(first <= last);
+        if (size == get_capacity())
+        {
+            RawMemory<Type> temp(std::max(size + 1, get_capacity() * 2));
+            std::construct_at(temp + count, std::forward<Value>(value));
+
+            try
+            {
+                UninitializedRelocate(items.get(), items + count, temp.get());
+                try
+                {
+                    UninitializedRelocate(items + count, items + size, temp + count + 1);
+                }
+                catch (...)
+                {
+                    std::destroy_n(temp.get(), count);
+                    throw;
+                }
+            }
+            catch (...)
+            {
+                std::destroy_at(temp + count);
+                throw;
+            }
+
+            std::destroy_n(items.get(), size);
+            items.swap(temp);
+            touched_size = size + 1;
+        }
+        else if (count == size)
+        {
+            std::construct_at(items + size, std::forward<Value>(value));
+        }
+        else
+        {
+            std::construct_at(items + size, std::move(items[size - 1]));
+            try
+            {
+                std::move_backward(items + count, items + size - 1, items + size);
+                items[count] = std::forward<Value>(value);
+            }
+            catch (...)
+            {
+                // Базовая гарантия: созданный за последним элемент уничтожается, размер не меняется
+                std::destroy_at(items + size);
+                throw;
+            }
+        }
+        ++size;
+        Invalidate();
+
+        return MakeIterator(items + count);
+    }
+
+    // Создает элементы [first, last) под перезапись выражением: значения типов с тривиальным созданием
+    // записываются прямо в память, остальные, как и любые при вычислении на этапе компиляции, сначала создаются O(N)
+    constexpr void ConstructForOverwrite(size_t first, size_t last)
+    {
+        if (std::is_constant_evaluated() || !(std::is_trivially_default_constructible_v<Type> && std::is_trivially_destructible_v<Type>))
+        {
+            UninitializedValueConstruct(items + first, last - first);
+        }
+    }
+
+    // Возвращает память за последним элементом. Страницы отдаются только на участке [size, touched_size),
+    // освободившемся после прошлого возврата, и только если он не меньше page_release_bytes,
+    // поэтому постепенное уменьшение вектора не вызывает системный вызов на каждой операции O(N)
+    constexpr void ReleaseUnused()
+    {
+        low_utilization_streak = 0;
+
+        if (!std::is_constant_evaluated() && shrink_policy.release_pages && (get_capacity() - size) * sizeof(Type) >= shrink_policy.page_release_bytes)
+        {
+            const size_t vacated_bytes = (touched_size - size) * sizeof(Type);
+            if (vacated_bytes >= shrink_policy.page_release_bytes)
+            {
+                ReleaseMemoryPages(items + size, vacated_bytes, shrink_policy.lazy_release);
+                touched_size = size;
+            }
+            return;
+        }
+
+        const size_t new_capacity = std::max(size * 2, shrink_policy.min_capacity);
+        if (new_capacity < get_capacity())
+        {
+            Reallocate(new_capacity);
+        }
+    }
+
+    // Учитывает операцию удаления в политике возврата памяти. Возврат здесь не должен бросать исключений:
+    // перевыделение выполняется только для типов с небросающим перемещением, а нехватка памяти оставляет буфер как есть
+    constexpr void NoteShrink(size_t old_size) noexcept
+    {
+        if (shrink_policy.patience == 0)
+        {
+            return;
+        }
+        touched_size = std::max(touched_size, old_size);
 
-        for (; first != last; ++first)
+        if (static_cast<double>(size) >= static_cast<double>(get_capacity()) * shrink_policy.min_utilization)
+        {
+            low_utilization_streak = 0;
+            return;
+        }
+        if (++low_utilization_streak < shrink_policy.patience)
+        {
+            return;
+        }
+
+        if constexpr (std::is_nothrow_move_constructible_v<Type>)
+        {
+            try
+            {
+                ReleaseUnused();
+            }
+            catch (...)
+            {
+                low_utilization_streak = 0;
+            }
+        }
+        else
+        {
+            low_utilization_streak = 0;
+        }
+    }
+
+    // Проверяет, что диапазон [first, first + count) лежит внутри вектора
+    constexpr void CheckRange(size_t first, size_t count) const
+    {
+        if (first > size || count > size - first)
+        {
+            throw std::out_of_range("Range is out of range");
+        }
+    }
+
+//-------------------------------------------------- Создание элементов в неинициализированной памяти ------------------------------------------------------
+// При исключении уже созданные элементы уничтожаются, и память остается пустой
+
+    // Создает count элементов Type() начиная с out O(N)
+    static constexpr void UninitializedValueConstruct(Type* out, size_t count)
+    {
+        size_t constructed = 0;
+        try
+        {
+            for (; constructed < count; ++constructed)
+            {
+                std::construct_at(out + constructed);
+            }
+        }
+        catch (...)
+        {
+            std::destroy_n(out, constructed);
+            throw;
+        }
+    }
+
+    // Создает count копий value начиная с out O(N)
+    static constexpr void UninitializedFill(Type* out, size_t count, const Type& value)
+    {
+        size_t constructed = 0;
+        try
+        {
+            for (; constructed < count; ++constructed)
+            {
+                std::construct_at(out + constructed, value);
+            }
+        }
+        catch (...)
+        {
+            std::destroy_n(out, constructed);
+            throw;
+        }
+    }
+
+    // Создает копии элементов [first, last) начиная с out O(N)
+    template <typename InputIterator>
+    static constexpr void UninitializedCopy(InputIterator first, InputIterator last, Type* out)
+    {
+        Type* current = out;
+        try
+        {
+            for (; first != last; ++first, ++current)
+            {
+                std::construct_at(current, *first);
+            }
+        }
+        catch (...)
         {
-            *first = Type(); // move
+            std::destroy(out, current);
+            throw;
         }
     }
 };
 
-//         
-ReserveProxyObj reserve(size_t capacity_to_reserve) 
+// Фабрика для создания объекта класса с зарезервированным количеством памяти
+constexpr ReserveProxyObj reserve(size_t capacity_to_reserve) 
 {
     return ReserveProxyObj(capacity_to_reserve);
 }
 
-//=================================================    =========================================================
+//================================================= Блок перегруженных операторов =========================================================
 
 template <typename Type>
-inline bool operator==(const SimpleVector<Type>& lhs, const SimpleVector<Type>& rhs)
+constexpr bool operator==(const SimpleVector<Type>& lhs, const SimpleVector<Type>& rhs)
 {
     return std::equal(lhs.begin(), lhs.end(), rhs.begin(), rhs.end());
 }
 
 template <typename Type>
-inline bool operator!=(const SimpleVector<Type>& lhs, const SimpleVector<Type>& rhs)
+constexpr bool operator!=(const SimpleVector<Type>& lhs, const SimpleVector<Type>& rhs)
 {
     return !(lhs == rhs);
 }
 
 template <typename Type>
-inline bool operator<(const SimpleVector<Type>& lhs, const SimpleVector<Type>& rhs) 
+constexpr bool operator<(const SimpleVector<Type>& lhs, const SimpleVector<Type>& rhs) 
 {
     return std::lexicographical_compare(lhs.begin(), lhs.end(), rhs.begin(), rhs.end());
 }
 
 template <typename Type>
-inline bool operator<=(const SimpleVector<Type>& lhs, const SimpleVector<Type>& rhs) 
+constexpr bool operator<=(const SimpleVector<Type>& lhs, const SimpleVector<Type>& rhs) 
 {
     return !(rhs < lhs);
 }
 
 template <typename Type>
-inline bool operator>(const SimpleVector<Type>& lhs, const SimpleVector<Type>& rhs) 
+constexpr bool operator>(const SimpleVector<Type>& lhs, const SimpleVector<Type>& rhs) 
 {
     return !(lhs <= rhs);
 }
 
 template <typename Type>
-inline bool operator>=(const SimpleVector<Type>& lhs, const SimpleVector<Type>& rhs) 
+constexpr bool operator>=(const SimpleVector<Type>& lhs, const SimpleVector<Type>& rhs) 
 {
     return !(lhs < rhs);
 }
\ No newline at end of file
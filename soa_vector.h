@@ -0,0 +1,391 @@
+#pragma once
+
+#include "raw_memory.h"
+
+#include <algorithm>
+#include <cassert>
+#include <memory>
+#include <span>
+#include <stdexcept>
+#include <tuple>
+#include <utility>
+
+// Вектор в виде структуры массивов: каждое поле строки хранится в своём непрерывном столбце.
+// Горячие циклы, читающие 2 поля из 12, загружают в кэш только нужные столбцы.
+// Поля создаются в столбцах при добавлении строки и уничтожаются при её удалении
+template <typename... Fields>
+class SoAVector
+{
+public:
+
+    static_assert(sizeof...(Fields) > 0, "SoAVector requires at least one field");
+
+    using Row = std::tuple<Fields...>;
+    using Reference = std::tuple<Fields&...>;
+    using ConstReference = std::tuple<const Fields&...>;
+
+    template <size_t Index>
+    using Field = std::tuple_element_t<Index, Row>;
+
+//===================================================================== Конструкторы и деструктор ==========================================================
+
+    SoAVector() noexcept = default;
+
+    // Создает вектор из size строк со значениями по умолчанию
+    explicit SoAVector(size_t size)
+    {
+        resize(size);
+    }
+
+    // Конструктор копирования O(N)
+    SoAVector(const SoAVector& other)
+    {
+        reserve(other.size);
+        CopyColumns(other);
+        size = other.size;
+    }
+
+    // Конструктор перемещения
+    SoAVector(SoAVector&& other) noexcept
+    {
+        swap(other);
+    }
+
+    ~SoAVector()
+    {
+        clear();
+    }
+
+//================================================================ Операторы ===============================================================================
+
+    // Прокси-ссылка на строку по индексу O(1)
+    Reference operator[](size_t index) noexcept
+    {
+        assert(index < size);
+        return MakeReference(index, std::index_sequence_for<Fields...>{});
+    }
+
+    // Константная прокси-ссылка на строку по индексу O(1)
+    ConstReference operator[](size_t index) const noexcept
+    {
+        assert(index < size);
+        return MakeReference(index, std::index_sequence_for<Fields...>{});
+    }
+
+    // Оператор присваивания O(N)
+    SoAVector& operator=(const SoAVector& rhs)
+    {
+        if (this != &rhs)
+        {
+            SoAVector temp(rhs);
+            swap(temp);
+        }
+        return *this;
+    }
+
+    // Оператор присваивания перемещением O(1)
+    SoAVector& operator=(SoAVector&& rhs) noexcept
+    {
+        if (this != &rhs)
+        {
+            SoAVector temp(std::move(rhs));
+            swap(temp);
+        }
+        return *this;
+    }
+
+//===================================================================== Методы =============================================================================
+
+//------------------------------------------------------------- Заполнение и добавление --------------------------------------------------------------------
+
+    // Добавление строки в конец, значения полей перемещаются в столбцы O(1) амортизированно
+    void push_back(Fields... values)
+    {
+        if (size == get_capacity())
+        {
+            Reallocate(std::max(size + 1, get_capacity() * 2));
+        }
+
+        std::tuple<Fields&...> row(values...);
+        ConstructRow(size, [&row](auto column) -> auto&& { return std::move(std::get<column>(row)); });
+        ++size;
+    }
+
+    // Добавление строки из кортежа O(1) амортизированно
+    void push_back(const Row& row)
+    {
+        std::apply([this](const Fields&... values) { push_back(values...); }, row);
+    }
+
+//-------------------------------------------------------------- Получение значений ------------------------------------------------------------------------
+
+    // Текущее количество строк O(1)
+    size_t get_size() const noexcept
+    {
+        return size;
+    }
+
+    // Вместимость O(1)
+    size_t get_capacity() const noexcept
+    {
+        return std::get<0>(columns).get_capacity();
+    }
+
+    // Проверка на пустоту O(1)
+    bool is_empty() const noexcept
+    {
+        return size == 0;
+    }
+
+    // Прокси-ссылка на строку с проверкой индекса O(1)
+    Reference at(size_t index)
+    {
+        if (index >= size)
+        {
+            throw std::out_of_range("Out of range");
+        }
+        return (*this)[index];
+    }
+
+    // Константная прокси-ссылка на строку с проверкой индекса O(1)
+    ConstReference at(size_t index) const
+    {
+        if (index >= size)
+        {
+            throw std::out_of_range("Out of range");
+        }
+        return (*this)[index];
+    }
+
+    // Ссылка на поле Index строки index O(1)
+    template <size_t Index>
+    Field<Index>& get(size_t index) noexcept
+    {
+        assert(index < size);
+        return std::get<Index>(columns)[index];
+    }
+
+    // Константная ссылка на поле Index строки index O(1)
+    template <size_t Index>
+    const Field<Index>& get(size_t index) const noexcept
+    {
+        assert(index < size);
+        return std::get<Index>(columns)[index];
+    }
+
+    // Непрерывный столбец поля Index для векторизованной обработки O(1)
+    template <size_t Index>
+    std::span<Field<Index>> column() noexcept
+    {
+        return std::span<Field<Index>>(std::get<Index>(columns).get(), size);
+    }
+
+    // Константный непрерывный столбец поля Index O(1)
+    template <size_t Index>
+    std::span<const Field<Index>> column() const noexcept
+    {
+        return std::span<const Field<Index>>(std::get<Index>(columns).get(), size);
+    }
+
+    // Копия строки по индексу O(1)
+    Row get_row(size_t index) const
+    {
+        assert(index < size);
+        return Row((*this)[index]);
+    }
+
+//------------------------------------------------------------------- Работа с размером --------------------------------------------------------------------
+
+    // Изменить количество строк, новые строки заполняются значениями по умолчанию, лишние уничтожаются O(N)
+    void resize(size_t new_size)
+    {
+        if (new_size < size)
+        {
+            DestroyRows(new_size, size);
+            size = new_size;
+            return;
+        }
+        if (new_size > get_capacity())
+        {
+            Reallocate(std::max(new_size, get_capacity() * 2));
+        }
+        for (; size < new_size; ++size)
+        {
+            ConstructRow(size, [](auto column) { return Field<column>(); });
+        }
+    }
+
+    // Резервирование места во всех столбцах одним перераспределением O(N)
+    void reserve(size_t new_capacity)
+    {
+        if (new_capacity > get_capacity())
+        {
+            Reallocate(new_capacity);
+        }
+    }
+
+    // Приравнять вместимость к размеру O(N)
+    void shrink_to_fit()
+    {
+        if (size < get_capacity())
+        {
+            Reallocate(size);
+        }
+    }
+
+//------------------------------------------------------------------------ Очистка и удаление --------------------------------------------------------------
+
+    // Очистить вектор, сохранив память O(N) для нетривиальных полей
+    void clear() noexcept
+    {
+        DestroyRows(0, size);
+        size = 0;
+    }
+
+    // Удаление последней строки O(1)
+    void pop_back() noexcept
+    {
+        assert(size > 0);
+
+        --size;
+        DestroyRows(size, size + 1);
+    }
+
+//--------------------------------------------------------------------- Прочие методы ----------------------------------------------------------------------
+
+    // Обмен значений O(1)
+    void swap(SoAVector& other) noexcept
+    {
+        SwapColumns(other, std::index_sequence_for<Fields...>{});
+
+        std::swap(size, other.size);
+    }
+
+//----------------------------------------------------------------------------------------------------------------------------------------------------------
+
+private:
+
+    // Столбцы одинаковой вместимости; в каждом созданы ровно size первых полей
+    std::tuple<RawMemory<Fields>...> columns;
+    size_t size = 0;
+
+    // Перераспределяет все столбцы разом: сначала выделяются все новые буферы, затем переносятся данные.
+    // Нехватка памяти или исключение при переносе не рассинхронизирует столбцы и оставляет вектор прежним O(N)
+    void Reallocate(size_t new_capacity)
+    {
+        std::tuple<RawMemory<Fields>...> temp{ RawMemory<Fields>(new_capacity)... };
+
+        RelocateColumns(temp);
+        DestroyRows(0, size);
+
+        columns.swap(temp);
+    }
+
+    // Переносит столбцы начиная с Index в target; при исключении уже перенесенные копии уничтожаются O(N)
+    template <size_t Index = 0>
+    void RelocateColumns(std::tuple<RawMemory<Fields>...>& target)
+    {
+        if constexpr (Index < sizeof...(Fields))
+        {
+            auto& column = std::get<Index>(columns);
+            UninitializedRelocate(column.get(), column + size, std::get<Index>(target).get());
+            try
+            {
+                RelocateColumns<Index + 1>(target);
+            }
+            catch (...)
+            {
+                std::destroy_n(std::get<Index>(target).get(), size);
+                throw;
+            }
+        }
+    }
+
+    // Копирует столбцы other начиная с Index в пустые столбцы; при исключении созданные копии уничтожаются O(N)
+    template <size_t Index = 0>
+    void CopyColumns(const SoAVector& other)
+    {
+        if constexpr (Index < sizeof...(Fields))
+        {
+            std::uninitialized_copy_n(std::get<Index>(other.columns).get(), other.size, std::get<Index>(columns).get());
+            try
+            {
+                CopyColumns<Index + 1>(other);
+            }
+            catch (...)
+            {
+                std::destroy_n(std::get<Index>(columns).get(), other.size);
+                throw;
+            }
+        }
+    }
+
+    // Создает поля строки index начиная со столбца Index значениями make(столбец).
+    // При исключении уже созданные поля этой строки уничтожаются O(1)
+    template <size_t Index = 0, typename Make>
+    void ConstructRow(size_t index, const Make& make)
+    {
+        if constexpr (Index < sizeof...(Fields))
+        {
+            std::construct_at(std::get<Index>(columns) + index, make(std::integral_constant<size_t, Index>{}));
+            try
+            {
+                ConstructRow<Index + 1>(index, make);
+            }
+            catch (...)
+            {
+                std::destroy_at(std::get<Index>(columns) + index);
+                throw;
+            }
+        }
+    }
+
+    // Уничтожает поля строк [first, last) во всех столбцах O(N) для нетривиальных полей
+    void DestroyRows(size_t first, size_t last) noexcept
+    {
+        std::apply([first, last](auto&... column) { (std::destroy(column + first, column + last), ...); }, columns);
+    }
+
+    template <size_t... Indexes>
+    void SwapColumns(SoAVector& other, std::index_sequence<Indexes...>) noexcept
+    {
+        (std::get<Indexes>(columns).swap(std::get<Indexes>(other.columns)), ...);
+    }
+
+    template <size_t... Indexes>
+    Reference MakeReference(size_t index, std::index_sequence<Indexes...>) noexcept
+    {
+        return Reference(std::get<Indexes>(columns)[index]...);
+    }
+
+    template <size_t... Indexes>
+    ConstReference MakeReference(size_t index, std::index_sequence<Indexes...>) const noexcept
+    {
+        return ConstReference(std::get<Indexes>(columns)[index]...);
+    }
+};
+
+//================================================= Блок перегруженных операторов =========================================================
+
+template <typename... Fields>
+inline bool operator==(const SoAVector<Fields...>& lhs, const SoAVector<Fields...>& rhs)
+{
+    if (lhs.get_size() != rhs.get_size())
+    {
+        return false;
+    }
+    for (size_t i = 0; i < lhs.get_size(); ++i)
+    {
+        if (lhs[i] != rhs[i])
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+template <typename... Fields>
+inline bool operator!=(const SoAVector<Fields...>& lhs, const SoAVector<Fields...>& rhs)
+{
+    return !(lhs == rhs);
+}
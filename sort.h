@@ -0,0 +1,231 @@
+#pragma once
+
+#include "simple_vector.h"
+#include "thread_pool.h"
+
+#include <algorithm>
+#include <bit>
+#include <concepts>
+#include <cstdint>
+#include <functional>
+#include <type_traits>
+#include <utility>
+
+// Сортировки SimpleVector: поразрядная LSD для целых и вещественных ключей и параллельная сортировка слиянием.
+// Поразрядная сортировка устойчива по построению; у параллельной есть обычный и устойчивый вариант
+
+// Ключ, пригодный для поразрядной сортировки
+template <typename Key>
+concept RadixSortKey = (std::integral<Key> && !std::same_as<Key, bool>) || std::same_as<Key, float> || std::same_as<Key, double>;
+
+// Минимальный размер, начиная с которого сортировка делится между потоками
+inline constexpr size_t kParallelSortThreshold = size_t(1) << 16;
+
+//================================================================ Поразрядная сортировка ===================================================================
+
+// Беззнаковое представление ключа, порядок которого совпадает с порядком самих ключей
+template <typename Key> requires RadixSortKey<Key>
+constexpr auto ToRadixKey(Key key) noexcept
+{
+    if constexpr (std::is_floating_point_v<Key>)
+    {
+        using Unsigned = std::conditional_t<sizeof(Key) == 4, uint32_t, uint64_t>;
+        constexpr Unsigned kSignBit = Unsigned(1) << (sizeof(Key) * 8 - 1);
+
+        // У отрицательных чисел инвертируются все биты, у положительных только знаковый
+        const Unsigned bits = std::bit_cast<Unsigned>(key);
+        return (bits & kSignBit) ? Unsigned(~bits) : Unsigned(bits | kSignBit);
+    }
+    else
+    {
+        using Unsigned = std::make_unsigned_t<Key>;
+        constexpr Unsigned kSignBit = std::is_signed_v<Key> ? Unsigned(Unsigned(1) << (sizeof(Key) * 8 - 1)) : Unsigned(0);
+
+        return Unsigned(static_cast<Unsigned>(key) ^ kSignBit);
+    }
+}
+
+// Ключ по умолчанию - сам элемент
+struct RadixIdentity
+{
+    template <typename Type>
+    constexpr Type operator()(const Type& value) const noexcept
+    {
+        return value;
+    }
+};
+
+// Устойчивая поразрядная сортировка по ключу key(element) байт за байтом, от младшего к старшему.
+// Гистограммы всех байтов считаются за один проход, проходы с единственным значением байта пропускаются.
+// Вспомогательным буфером для тривиально копируемых типов служит свободная вместимость вектора, если её хватает,
+// иначе временный SimpleVector.
+// O(N * sizeof(key))
+template <typename Type, typename KeyExtractor = RadixIdentity>
+    requires RadixSortKey<std::remove_cvref_t<std::invoke_result_t<const KeyExtractor&, const Type&>>>
+void radix_sort(SimpleVector<Type>& vector, KeyExtractor key = {})
+{
+    constexpr size_t kBuckets = 256;
+
+    const size_t size = vector.get_size();
+    if (size < 2)
+    {
+        return;
+    }
+
+    using Unsigned = decltype(ToRadixKey(std::invoke(key, vector[0])));
+    constexpr size_t kPasses = sizeof(Unsigned);
+
+    SimpleVector<size_t> counts(kPasses * kBuckets, 0);
+    for (size_t i = 0; i < size; ++i)
+    {
+        const Unsigned radix_key = ToRadixKey(std::invoke(key, vector[i]));
+        for (size_t pass = 0; pass < kPasses; ++pass)
+        {
+            ++counts[pass * kBuckets + ((radix_key >> (pass * 8)) & 0xFF)];
+        }
+    }
+
+    SimpleVector<Type> scratch;
+    Type* source = vector.data();
+    Type* buffer = nullptr;
+    // Элементы за последним не созданы, поэтому писать туда присваиванием можно только тривиально копируемые типы
+    if (std::is_trivially_copyable_v<Type> && vector.get_capacity() - size >= size)
+    {
+        buffer = vector.data() + size;
+    }
+    else
+    {
+        scratch.resize(size);
+        buffer = scratch.data();
+    }
+
+    size_t offsets[kBuckets];
+    for (size_t pass = 0; pass < kPasses; ++pass)
+    {
+        const size_t* histogram = counts.data() + pass * kBuckets;
+        const size_t shift = pass * 8;
+
+        if (std::find(histogram, histogram + kBuckets, size) != histogram + kBuckets)
+        {
+            continue;
+        }
+
+        size_t offset = 0;
+        for (size_t bucket = 0; bucket < kBuckets; ++bucket)
+        {
+            offsets[bucket] = offset;
+            offset += histogram[bucket];
+        }
+
+        for (size_t i = 0; i < size; ++i)
+        {
+            const size_t bucket = (ToRadixKey(std::invoke(key, source[i])) >> shift) & 0xFF;
+            buffer[offsets[bucket]++] = std::move(source[i]);
+        }
+        std::swap(source, buffer);
+    }
+
+    if (source != vector.data())
+    {
+        std::move(source, source + size, vector.data());
+    }
+}
+
+//================================================================ Параллельная сортировка ==================================================================
+
+// Делит [first, first + size) на thread_count частей, сортирует их одновременно в пуле потоков,
+// затем сливает соседние части попарно, пока не останется одна. Слияние устойчиво,
+// поэтому устойчивость всей сортировки определяется сортировкой частей
+template <bool Stable, typename Type, typename Compare>
+void ParallelMergeSort(Type* first, size_t size, Compare compare, size_t thread_count, ThreadPool& pool = DefaultThreadPool())
+{
+    const auto sort_part = [&compare](Type* part_first, Type* part_last)
+    {
+        if constexpr (Stable)
+        {
+            std::stable_sort(part_first, part_last, compare);
+        }
+        else
+        {
+            std::sort(part_first, part_last, compare);
+        }
+    };
+
+    if (thread_count < 2 || size < kParallelSortThreshold)
+    {
+        sort_part(first, first + size);
+        return;
+    }
+
+    SimpleVector<size_t> bounds;
+    bounds.reserve(thread_count + 1);
+    for (size_t part = 0; part <= thread_count; ++part)
+    {
+        bounds.push_back(size * part / thread_count);
+    }
+
+    TaskGroup group(pool);
+    for (size_t part = 0; part + 1 < bounds.get_size(); ++part)
+    {
+        group.run([&sort_part, part_first = first + bounds[part], part_last = first + bounds[part + 1]]()
+            {
+                sort_part(part_first, part_last);
+            });
+    }
+    group.wait();
+
+    SimpleVector<Type> scratch(size);
+    Type* source = first;
+    Type* buffer = scratch.data();
+
+    while (bounds.get_size() > 2)
+    {
+        SimpleVector<size_t> merged_bounds;
+
+        for (size_t part = 0; part + 1 < bounds.get_size(); part += 2)
+        {
+            merged_bounds.push_back(bounds[part]);
+
+            const size_t left = bounds[part];
+            if (part + 2 < bounds.get_size())
+            {
+                const size_t middle = bounds[part + 1];
+                const size_t right = bounds[part + 2];
+                group.run([source, buffer, left, middle, right, &compare]()
+                    {
+                        std::merge(std::make_move_iterator(source + left), std::make_move_iterator(source + middle),
+                            std::make_move_iterator(source + middle), std::make_move_iterator(source + right), buffer + left, compare);
+                    });
+            }
+            else
+            {
+                // Непарная последняя часть переносится как есть
+                std::move(source + left, source + bounds[part + 1], buffer + left);
+            }
+        }
+        merged_bounds.push_back(size);
+        group.wait();
+
+        std::swap(source, buffer);
+        bounds = std::move(merged_bounds);
+    }
+
+    if (source != first)
+    {
+        std::move(source, source + size, first);
+    }
+}
+
+// Параллельная сортировка слиянием O(N log N / P + N log P)
+template <typename Type, typename Compare = std::less<>>
+void parallel_sort(SimpleVector<Type>& vector, Compare compare = {}, size_t thread_count = DefaultThreadPool().get_thread_count())
+{
+    ParallelMergeSort<false>(vector.data(), vector.get_size(), compare, thread_count);
+}
+
+// Устойчивая параллельная сортировка слиянием: равные элементы сохраняют взаимный порядок O(N log N / P + N log P)
+template <typename Type, typename Compare = std::less<>>
+void parallel_stable_sort(SimpleVector<Type>& vector, Compare compare = {}, size_t thread_count = DefaultThreadPool().get_thread_count())
+{
+    ParallelMergeSort<true>(vector.data(), vector.get_size(), compare, thread_count);
+}
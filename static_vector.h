@@ -0,0 +1,525 @@
+#pragma once
+
+#include <algorithm>
+#include <cassert>
+#include <initializer_list>
+#include <iterator>
+#include <memory>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+
+// Вектор фиксированной вместимости с хранилищем внутри объекта: память в куче не выделяется никогда.
+// Элементы создаются и уничтожаются по месту, поэтому вектор целиком пригоден для constexpr-вычислений
+// и позволяет строить таблицы на этапе компиляции
+template <typename Type, size_t Capacity>
+class StaticVector
+{
+    static_assert(Capacity > 0, "StaticVector capacity must be positive");
+
+public:
+
+    using Iterator = Type*;
+    using ConstIterator = const Type*;
+
+//===================================================================== Конструкторы и деструктор ==========================================================
+
+    constexpr StaticVector() noexcept = default;
+
+    // Создает вектор с элементами по умолчанию
+    constexpr explicit StaticVector(size_t size) : StaticVector(size, Type()) {}
+
+    // Создает вектор с заданными элементами
+    constexpr StaticVector(size_t size, const Type& value)
+    {
+        assign(size, value);
+    }
+
+    // Создает вектор с помощью {}
+    constexpr StaticVector(std::initializer_list<Type> init)
+    {
+        append_range(init.begin(), init.end());
+    }
+
+    // Конструктор копирования O(N)
+    constexpr StaticVector(const StaticVector& other)
+    {
+        append_range(other.begin(), other.end());
+    }
+
+    // Конструктор перемещения O(N): элементы переносятся поштучно, источник остается с прежним размером
+    constexpr StaticVector(StaticVector&& other) noexcept(std::is_nothrow_move_constructible_v<Type>)
+    {
+        MoveFrom(other);
+    }
+
+    constexpr ~StaticVector() requires std::is_trivially_destructible_v<Type> = default;
+
+    constexpr ~StaticVector()
+    {
+        clear();
+    }
+
+//================================================================ Операторы ===============================================================================
+
+    // Получение ссылки по индексу O(1)
+    constexpr Type& operator[](size_t index) noexcept
+    {
+        assert(index < size);
+        return storage.items[index];
+    }
+
+    // Получение константной ссылки по индексу O(1)
+    constexpr const Type& operator[](size_t index) const noexcept
+    {
+        assert(index < size);
+        return storage.items[index];
+    }
+
+    // Оператор присваивания O(N)
+    constexpr StaticVector& operator=(const StaticVector& rhs)
+    {
+        if (this != &rhs)
+        {
+            StaticVector temp(rhs);
+            swap(temp);
+        }
+        return *this;
+    }
+
+    // Оператор присваивания перемещением O(N)
+    constexpr StaticVector& operator=(StaticVector&& rhs) noexcept(std::is_nothrow_move_constructible_v<Type>)
+    {
+        if (this != &rhs)
+        {
+            clear();
+            MoveFrom(rhs);
+        }
+        return *this;
+    }
+
+//===================================================================== Итераторы ==========================================================================
+
+    // Итератор на начало O(1)
+    constexpr Iterator begin() noexcept
+    {
+        return storage.items;
+    }
+
+    // Итератор на конец O(1)
+    constexpr Iterator end() noexcept
+    {
+        return storage.items + size;
+    }
+
+    // Константный итератор на начало O(1)
+    constexpr ConstIterator begin() const noexcept
+    {
+        return storage.items;
+    }
+
+    // Константный итератор на конец O(1)
+    constexpr ConstIterator end() const noexcept
+    {
+        return storage.items + size;
+    }
+
+    // O(1)
+    constexpr ConstIterator cbegin() const noexcept
+    {
+        return begin();
+    }
+
+    // O(1)
+    constexpr ConstIterator cend() const noexcept
+    {
+        return end();
+    }
+
+//===================================================================== Методы =============================================================================
+
+//------------------------------------------------------------- Заполнение и добавление --------------------------------------------------------------------
+
+    // Добавление в конец с копированием O(1)
+    constexpr void push_back(const Type& item)
+    {
+        CheckSpace(1);
+        std::construct_at(storage.items + size, item);
+        ++size;
+    }
+
+    // Добавление в конец с перемещением O(1)
+    constexpr void push_back(Type&& item)
+    {
+        CheckSpace(1);
+        std::construct_at(storage.items + size, std::move(item));
+        ++size;
+    }
+
+    // Добавление диапазона в конец O(N). При исключении созданные элементы уничтожаются, вектор остается прежним
+    template <typename InputIterator>
+    constexpr void append_range(InputIterator first, InputIterator last)
+    {
+        CheckSpace(static_cast<size_t>(std::distance(first, last)));
+
+        const size_t old_size = size;
+        try
+        {
+            for (; first != last; ++first)
+            {
+                std::construct_at(storage.items + size, *first);
+                ++size;
+            }
+        }
+        catch (...)
+        {
+            DestroyFrom(old_size);
+            throw;
+        }
+    }
+
+    // Вставка в указанное место c копированием O(N)
+    constexpr Iterator insert(ConstIterator pos, const Type& value)
+    {
+        Type copy(value);
+        return insert(pos, std::move(copy));
+    }
+
+    // Вставка в указанное место с перемещением O(N)
+    constexpr Iterator insert(ConstIterator pos, Type&& value)
+    {
+        assert(pos >= begin() && pos <= end());
+        CheckSpace(1);
+
+        const size_t index = pos - begin();
+
+        if (index == size)
+        {
+            std::construct_at(storage.items + size, std::move(value));
+        }
+        else
+        {
+            std::construct_at(storage.items + size, std::move(storage.items[size - 1]));
+            try
+            {
+                std::move_backward(begin() + index, end() - 1, end());
+                storage.items[index] = std::move(value);
+            }
+            catch (...)
+            {
+                // Созданный за последним элемент уничтожается, размер не меняется
+                std::destroy_at(storage.items + size);
+                throw;
+            }
+        }
+        ++size;
+
+        return begin() + index;
+    }
+
+//-------------------------------------------------------------- Получение значений ------------------------------------------------------------------------
+
+    // Текущий размер O(1)
+    constexpr size_t get_size() const noexcept
+    {
+        return size;
+    }
+
+    // Максимальный размер совпадает с вместимостью O(1)
+    constexpr size_t max_size() const noexcept
+    {
+        return Capacity;
+    }
+
+    // Вместимость O(1)
+    constexpr size_t get_capacity() const noexcept
+    {
+        return Capacity;
+    }
+
+    // Проверка на пустоту O(1)
+    constexpr bool is_empty() const noexcept
+    {
+        return size == 0;
+    }
+
+    // Проверка на заполненность O(1)
+    constexpr bool is_full() const noexcept
+    {
+        return size == Capacity;
+    }
+
+    // Ссылка на первый элемент O(1)
+    constexpr Type& front()
+    {
+        if (size == 0)
+        {
+            throw std::out_of_range("Vector is empty!");
+        }
+        return storage.items[0];
+    }
+
+    // Константная ссылка на первый элемент O(1)
+    constexpr const Type& front() const
+    {
+        if (size == 0)
+        {
+            throw std::out_of_range("Vector is empty!");
+        }
+        return storage.items[0];
+    }
+
+    // Ссылка на последний элемент O(1)
+    constexpr Type& back()
+    {
+        if (size == 0)
+        {
+            throw std::out_of_range("Vector is empty!");
+        }
+        return storage.items[size - 1];
+    }
+
+    // Константная ссылка на последний элемент O(1)
+    constexpr const Type& back() const
+    {
+        if (size == 0)
+        {
+            throw std::out_of_range("Vector is empty!");
+        }
+        return storage.items[size - 1];
+    }
+
+    // Указатель на начало массива O(1)
+    constexpr Type* data() noexcept
+    {
+        return storage.items;
+    }
+
+    // Константный указатель на начало массива O(1)
+    constexpr const Type* data() const noexcept
+    {
+        return storage.items;
+    }
+
+    // Ссылка на элемент по индексу O(1)
+    constexpr Type& at(size_t index)
+    {
+        if (index >= size)
+        {
+            throw std::out_of_range("Out of range");
+        }
+        return storage.items[index];
+    }
+
+    // Константная ссылка на элемент по индексу O(1)
+    constexpr const Type& at(size_t index) const
+    {
+        if (index >= size)
+        {
+            throw std::out_of_range("Out of range");
+        }
+        return storage.items[index];
+    }
+
+//------------------------------------------------------------------- Работа с размером --------------------------------------------------------------------
+
+    // Изменить размер, новые элементы создаются по умолчанию O(N). При исключении размер остается прежним
+    constexpr void resize(size_t new_size)
+    {
+        if (new_size < size)
+        {
+            DestroyFrom(new_size);
+        }
+        CheckSpace(new_size - size);
+
+        const size_t old_size = size;
+        try
+        {
+            for (; size < new_size; ++size)
+            {
+                std::construct_at(storage.items + size);
+            }
+        }
+        catch (...)
+        {
+            DestroyFrom(old_size);
+            throw;
+        }
+    }
+
+//------------------------------------------------------------------------ Очистка и удаление --------------------------------------------------------------
+
+    // Очистить массив O(N) для нетривиальных типов
+    constexpr void clear() noexcept
+    {
+        DestroyFrom(0);
+    }
+
+    // Удаление последнего элемента O(1)
+    constexpr void pop_back() noexcept
+    {
+        assert(size > 0);
+
+        --size;
+        std::destroy_at(storage.items + size);
+    }
+
+    // Удаление элемента в заданной позиции O(N)
+    constexpr Iterator erase(ConstIterator pos)
+    {
+        assert(pos >= begin() && pos < end());
+
+        const size_t index = pos - begin();
+
+        std::move(begin() + index + 1, end(), begin() + index);
+        pop_back();
+
+        return begin() + index;
+    }
+
+//--------------------------------------------------------------------- Прочие методы ----------------------------------------------------------------------
+
+    // Изменяет размер и содержимое O(N). При исключении вектор остается пустым
+    constexpr void assign(size_t new_size, const Type& value)
+    {
+        CheckSpace(new_size > size ? new_size - size : 0);
+
+        // value может ссылаться на элемент вектора, поэтому копия снимается до очистки
+        const Type copy(value);
+        clear();
+        try
+        {
+            for (; size < new_size; ++size)
+            {
+                std::construct_at(storage.items + size, copy);
+            }
+        }
+        catch (...)
+        {
+            clear();
+            throw;
+        }
+    }
+
+    // Обмен значений O(N)
+    constexpr void swap(StaticVector& other)
+    {
+        StaticVector& shorter = size < other.size ? *this : other;
+        StaticVector& longer = size < other.size ? other : *this;
+        const size_t common = shorter.size;
+
+        std::swap_ranges(shorter.begin(), shorter.end(), longer.begin());
+        for (; shorter.size < longer.size; ++shorter.size)
+        {
+            // Созданные элементы сразу учитываются в размере, чтобы при исключении их уничтожил владелец
+            std::construct_at(shorter.storage.items + shorter.size, std::move(longer.storage.items[shorter.size]));
+        }
+        longer.DestroyFrom(common);
+    }
+
+//----------------------------------------------------------------------------------------------------------------------------------------------------------
+
+private:
+
+    // Хранилище без инициализации элементов: время жизни каждого элемента начинается в construct_at.
+    // При вычислении на этапе компиляции тривиальные элементы заполняются заранее, иначе объект
+    // с частично заполненным массивом нельзя было бы сохранить в constexpr-переменной
+    union Storage
+    {
+        constexpr Storage() noexcept
+        {
+            if constexpr (std::is_trivially_default_constructible_v<Type>)
+            {
+                if (std::is_constant_evaluated())
+                {
+                    for (size_t i = 0; i < Capacity; ++i)
+                    {
+                        std::construct_at(items + i);
+                    }
+                }
+            }
+        }
+
+        constexpr ~Storage() requires std::is_trivially_destructible_v<Type> = default;
+
+        constexpr ~Storage() {}
+
+        Type items[Capacity];
+    };
+
+    Storage storage;
+    size_t size = 0;
+
+    // Переносит элементы other в пустой вектор. При исключении перенесенные элементы уничтожаются,
+    // так как деструктор недостроенного вектора не вызывается O(N)
+    constexpr void MoveFrom(StaticVector& other)
+    {
+        try
+        {
+            for (Type& value : other)
+            {
+                std::construct_at(storage.items + size, std::move(value));
+                ++size;
+            }
+        }
+        catch (...)
+        {
+            clear();
+            throw;
+        }
+    }
+
+    // Уничтожает элементы начиная с new_size и уменьшает размер до new_size O(N)
+    constexpr void DestroyFrom(size_t new_size) noexcept
+    {
+        std::destroy(begin() + new_size, end());
+        size = new_size;
+    }
+
+    // Проверяет, что в векторе найдется место еще под count элементов
+    constexpr void CheckSpace(size_t count) const
+    {
+        if (count > Capacity - size)
+        {
+            throw std::length_error("StaticVector capacity exceeded");
+        }
+    }
+};
+
+//================================================= Блок перегруженных операторов =========================================================
+
+template <typename Type, size_t Capacity>
+constexpr bool operator==(const StaticVector<Type, Capacity>& lhs, const StaticVector<Type, Capacity>& rhs)
+{
+    return std::equal(lhs.begin(), lhs.end(), rhs.begin(), rhs.end());
+}
+
+template <typename Type, size_t Capacity>
+constexpr bool operator!=(const StaticVector<Type, Capacity>& lhs, const StaticVector<Type, Capacity>& rhs)
+{
+    return !(lhs == rhs);
+}
+
+template <typename Type, size_t Capacity>
+constexpr bool operator<(const StaticVector<Type, Capacity>& lhs, const StaticVector<Type, Capacity>& rhs)
+{
+    return std::lexicographical_compare(lhs.begin(), lhs.end(), rhs.begin(), rhs.end());
+}
+
+template <typename Type, size_t Capacity>
+constexpr bool operator<=(const StaticVector<Type, Capacity>& lhs, const StaticVector<Type, Capacity>& rhs)
+{
+    return !(rhs < lhs);
+}
+
+template <typename Type, size_t Capacity>
+constexpr bool operator>(const StaticVector<Type, Capacity>& lhs, const StaticVector<Type, Capacity>& rhs)
+{
+    return !(lhs <= rhs);
+}
+
+template <typename Type, size_t Capacity>
+constexpr bool operator>=(const StaticVector<Type, Capacity>& lhs, const StaticVector<Type, Capacity>& rhs)
+{
+    return !(lhs < rhs);
+}
@@ -1,12 +1,37 @@
 #pragma once
 
 #include "simple_vector.h"
+#include "soa_vector.h"
+#include "packed_vector.h"
+#include "bit_vector.h"
+#include "flat_map.h"
+#include "flat_hash_map.h"
+#include "ring_buffer.h"
+#include "concurrent_queue.h"
+#include "gap_buffer.h"
+#include "tiered_vector.h"
+#include "static_vector.h"
+#include "vector_view.h"
+#include "range_pipeline.h"
+#include "sort.h"
+#include "thread_pool.h"
+#include "parallel_expression.h"
+#include "erase.h"
+#include "differential_test.h"
+#include "heterogeneous_vector.h"
+#include "nd_vector.h"
+#include "buffer_recycler.h"
 
 #include <cassert>
 #include <iostream>
+#include <memory>
 #include <utility>
 #include <algorithm>
 #include <numeric>
+#include <thread>
+#include <random>
+#include <string>
+#include <unordered_map>
 
 using namespace std;
 
@@ -509,11 +534,3071 @@ inline void Test3()
     }
 }
 
+inline void TestSoAVector()
+{
+    {
+        SoAVector<int, double, std::string> v;
+
+        assert(v.get_size() == 0);
+        assert(v.is_empty());
+
+        v.push_back(1, 1.5, "one"s);
+        v.push_back(std::make_tuple(2, 2.5, "two"s));
+
+        assert(v.get_size() == 2);
+        assert(v.get_capacity() >= 2);
+        assert(v.get<0>(1) == 2);
+        assert(v.get<2>(0) == "one"s);
+        assert(v.get_row(1) == std::make_tuple(2, 2.5, "two"s));
+    }
+
+    {
+        SoAVector<int, float> v;
+
+        for (int i = 0; i < 100; ++i)
+        {
+            v.push_back(i, static_cast<float>(i) * 2);
+        }
+
+        assert(v.get_size() == 100);
+
+        auto ids = v.column<0>();
+        auto values = v.column<1>();
+
+        assert(ids.size() == 100);
+        assert(values.data() == &v.get<1>(0));
+        assert(std::accumulate(ids.begin(), ids.end(), 0) == 4950);
+
+        std::get<1>(v[10]) = -1.0f;
+        assert(v.get<1>(10) == -1.0f);
+
+        v[20] = std::make_tuple(7, 7.0f);
+        assert(v.get<0>(20) == 7);
+        assert(v.get<1>(20) == 7.0f);
+    }
+
+    {
+        SoAVector<int, int> v;
+        v.reserve(10);
+
+        const size_t old_capacity = v.get_capacity();
+        const int* const old_column = v.column<0>().data();
+
+        for (int i = 0; i < 10; ++i)
+        {
+            v.push_back(i, -i);
+        }
+
+        assert(v.get_capacity() == old_capacity);
+        assert(v.column<0>().data() == old_column);
+
+        v.push_back(10, -10);
+
+        assert(v.get_capacity() > old_capacity);
+
+        for (int i = 0; i <= 10; ++i)
+        {
+            assert(v.get<0>(i) == i);
+            assert(v.get<1>(i) == -i);
+        }
+
+        SoAVector<int, int> copy(v);
+
+        assert(copy == v);
+
+        copy.pop_back();
+
+        assert(copy != v);
+
+        v.resize(3);
+        v.shrink_to_fit();
+
+        assert(v.get_size() == 3);
+        assert(v.get_capacity() == 3);
+
+        v.resize(5);
+
+        assert(v.get<0>(4) == 0);
+        assert(v.get<1>(4) == 0);
+
+        try
+        {
+            v.at(5);
+            assert(false);
+        }
+        catch (const std::out_of_range&)
+        {
+        }
+    }
+
+    {
+        // Удаленные строки уничтожают свои поля, копии полей не остаются в столбцах
+        const auto shared = std::make_shared<int>(1);
+        {
+            SoAVector<int, std::shared_ptr<int>> v;
+            for (int i = 0; i < 10; ++i)
+            {
+                v.push_back(i, shared);
+            }
+            assert(shared.use_count() == 11);
+
+            v.pop_back();
+            assert(shared.use_count() == 10);
+            v.resize(4);
+            assert(shared.use_count() == 5);
+            v.shrink_to_fit();
+            assert(shared.use_count() == 5);
+
+            const SoAVector<int, std::shared_ptr<int>> copy(v);
+            assert(shared.use_count() == 9);
+
+            v.clear();
+            assert(shared.use_count() == 5);
+            v.push_back(0, shared);
+        }
+        assert(shared.use_count() == 1);
+
+        // Исключение при копировании поля строки уничтожает уже созданные поля этой строки
+        SoAVector<std::shared_ptr<int>, ThrowingCopy> rows;
+        rows.reserve(4);
+        rows.push_back(shared, ThrowingCopy(1));
+        const size_t live = ThrowingCopy::live;
+
+        ThrowingCopy::copies_until_failure = 0;
+        try
+        {
+            const SoAVector<std::shared_ptr<int>, ThrowingCopy> copy(rows);
+            assert(false);
+        }
+        catch (const InjectedFailure&)
+        {
+        }
+        ThrowingCopy::copies_until_failure = -1;
+
+        assert(shared.use_count() == 2);
+        assert(ThrowingCopy::live == live);
+        assert(rows.get_size() == 1);
+    }
+}
+
+inline void TestPackedVector()
+{
+    {
+        for (unsigned width : { 0u, 1u, 3u, 7u, 13u, 31u, 33u, 63u, 64u })
+        {
+            BitPackedVector v(width);
+            const uint64_t mask = PackedBits::Mask(width);
+
+            for (uint64_t i = 0; i < 1000; ++i)
+            {
+                v.push_back((i * 0x9E3779B97F4A7C15ull) & mask);
+            }
+
+            assert(v.get_size() == 1000);
+
+            size_t index = 0;
+            for (uint64_t value : v)
+            {
+                assert(value == ((index * 0x9E3779B97F4A7C15ull) & mask));
+                assert(v.get(index) == value);
+                ++index;
+            }
+            assert(index == 1000);
+        }
+    }
+
+    {
+        BitPackedVector v(4);
+
+        try
+        {
+            v.push_back(16);
+            assert(false);
+        }
+        catch (const std::invalid_argument&)
+        {
+        }
+
+        v.push_back(15);
+        v.push_back(1);
+        v.set(0, 3);
+
+        assert(v.get(0) == 3);
+        assert(v.get(1) == 1);
+    }
+
+    {
+        SimpleVector<uint64_t> values;
+        for (uint64_t i = 0; i < 1000; ++i)
+        {
+            values.push_back(i % 200);
+        }
+
+        BitPackedVector v(values);
+
+        assert(v.get_width() == 8);
+        assert(v.to_vector() == values);
+        assert(v.memory_bytes() * 8 <= values.get_size() * sizeof(uint64_t) + sizeof(uint64_t));
+    }
+
+    {
+        std::mt19937_64 generator(42);
+        SimpleVector<uint64_t> values;
+
+        for (size_t i = 0; i < 1024; ++i)
+        {
+            values.push_back(1'000'000'000'000ull + generator() % 1000);
+        }
+
+        FrameOfReferenceVector v(values);
+
+        assert(v.get_size() == values.get_size());
+        assert(v.to_vector() == values);
+
+        for (size_t i = 0; i < values.get_size(); ++i)
+        {
+            assert(v.get(i) == values[i]);
+        }
+        assert(v.memory_bytes() < values.get_size() * sizeof(uint64_t) / 4);
+        assert(std::equal(v.begin(), v.end(), values.begin()));
+    }
+
+    {
+        SimpleVector<uint64_t> values;
+        uint64_t current = 0;
+
+        for (size_t i = 0; i < 1000; ++i)
+        {
+            current += i % 7;
+            values.push_back(current);
+        }
+
+        DeltaVector v(values);
+
+        assert(v.to_vector() == values);
+
+        for (size_t i = 0; i < values.get_size(); ++i)
+        {
+            assert(v.get(i) == values[i]);
+        }
+
+        try
+        {
+            v.push_back(0);
+            assert(false);
+        }
+        catch (const std::invalid_argument&)
+        {
+        }
+
+        assert(v.get_size() == values.get_size());
+    }
+
+    {
+        // Развернутая распаковка блока совпадает с пакетным чтением для всех разрядностей
+        std::mt19937_64 generator(27);
+        SimpleVector<uint64_t> words(PackedBits::WordCount(PackedBits::kBlockSize, 64));
+        std::generate(words.begin(), words.end(), [&generator]() { return generator(); });
+
+        std::array<uint64_t, PackedBits::kBlockSize> expected{};
+        std::array<uint64_t, PackedBits::kBlockSize> actual{};
+        for (unsigned width = 0; width <= 64; ++width)
+        {
+            PackedBits::Unpack(words.data(), 0, width, PackedBits::kBlockSize, expected.data());
+            PackedBits::UnpackBlock(words.data(), width, actual.data());
+            assert(actual == expected);
+        }
+    }
+}
+
+inline void TestBitVector()
+{
+    {
+        BitVector v;
+
+        assert(v.is_empty());
+        assert(v.find_first() == BitVector::npos);
+
+        for (size_t i = 0; i < 200; ++i)
+        {
+            v.push_back(i % 3 == 0);
+        }
+
+        assert(v.get_size() == 200);
+        assert(v.count() == 67);
+        assert(v[0] && !v[1] && v[3]);
+        assert(v.find_first() == 0);
+        assert(v.find_next(0) == 3);
+        assert(v.find_next(198) == BitVector::npos);
+
+        v[1] = true;
+        v[0].flip();
+
+        assert(v[1] && !v[0]);
+
+        v.pop_back();
+        v.pop_back();
+
+        assert(v.get_size() == 198);
+        assert(v.count() == 66);
+    }
+
+    {
+        BitVector v(130, true);
+
+        assert(v.all());
+        assert(v.count() == 130);
+
+        v.resize(70);
+        assert(v.count() == 70);
+
+        v.resize(140, false);
+        assert(v.count() == 70);
+        assert(!v[139]);
+
+        v.resize(200, true);
+        assert(v.count() == 130);
+        assert(v[199] && v[140] && !v[139]);
+
+        const BitVector inverted = ~v;
+        assert(inverted.count() == 70);
+        assert((inverted | v).all());
+        assert((inverted & v).none());
+        assert((inverted ^ v).all());
+    }
+
+    {
+        BitVector a{ true, false, true, true };
+        BitVector b{ false, false, true, false };
+
+        assert((a & b) == (BitVector{ false, false, true, false }));
+        assert((a | b) == a);
+        assert((a ^ b) == (BitVector{ true, false, false, true }));
+
+        try
+        {
+            a &= BitVector(5);
+            assert(false);
+        }
+        catch (const std::invalid_argument&)
+        {
+        }
+    }
+
+    {
+        BitVector v(5000);
+        SimpleVector<size_t> ones;
+
+        for (size_t i = 0; i < v.get_size(); i += 1 + i % 13)
+        {
+            v.set(i);
+            ones.push_back(i);
+        }
+
+        for (int indexed = 0; indexed < 2; ++indexed)
+        {
+            if (indexed)
+            {
+                v.build_rank_index();
+            }
+
+            for (size_t k = 0; k < ones.get_size(); ++k)
+            {
+                assert(v.select(k) == ones[k]);
+                assert(v.rank(ones[k]) == k);
+                assert(v.rank(ones[k] + 1) == k + 1);
+            }
+            assert(v.select(ones.get_size()) == BitVector::npos);
+            assert(v.rank(v.get_size()) == ones.get_size());
+        }
+
+        size_t found = 0;
+        for (size_t pos = v.find_first(); pos != BitVector::npos; pos = v.find_next(pos))
+        {
+            assert(pos == ones[found++]);
+        }
+        assert(found == ones.get_size());
+        assert(static_cast<size_t>(std::count(v.begin(), v.end(), true)) == ones.get_size());
+    }
+
+    // Векторные пословные операции на размерах, не кратных блоку, сверяются с побитовыми
+    {
+        std::mt19937 generator(28);
+        for (const size_t size : { 1, 64, 127, 256, 1000, 1031 })
+        {
+            BitVector a(size);
+            BitVector b(size);
+            for (size_t i = 0; i < size; ++i)
+            {
+                a[i] = generator() % 2 == 0;
+                b[i] = generator() % 3 == 0;
+            }
+            const BitVector conjunction = a & b;
+            const BitVector disjunction = a | b;
+            const BitVector exclusive = a ^ b;
+
+            size_t ones = 0;
+            for (size_t i = 0; i < size; ++i)
+            {
+                assert(conjunction[i] == (a[i] && b[i]));
+                assert(disjunction[i] == (a[i] || b[i]));
+                assert(exclusive[i] == (a[i] != b[i]));
+                ones += a[i] ? 1 : 0;
+            }
+            assert(a.count() == ones);
+        }
+    }
+
+    // Итератор поддерживает все операции произвольного доступа
+    {
+        static_assert(std::random_access_iterator<BitVector::ConstIterator>);
+
+        const BitVector v{ true, false, true, true };
+        const BitVector::ConstIterator first = v.begin();
+        const BitVector::ConstIterator third = 2 + first;
+        assert(*third && third > first && first <= third && third >= first && !(first >= third));
+        assert(third - first == 2 && first[3]);
+    }
+}
+
+inline void TestFlatContainers()
+{
+    {
+        FlatSet<int> set(SimpleVector<int>{ 5, 1, 4, 1, 5, 9, 2, 6 });
+
+        assert(set.get_size() == 6);
+        assert(std::is_sorted(set.begin(), set.end()));
+        assert(set.contains(9));
+        assert(!set.contains(3));
+        assert(*set.lower_bound(3) == 4);
+        assert(*set.upper_bound(5) == 6);
+        assert(set.lower_bound(10) == set.end());
+
+        assert(set.insert(3).second);
+        assert(!set.insert(3).second);
+        assert(set.erase(1) == 1);
+        assert(set.erase(1) == 0);
+        assert((set == FlatSet<int>{ 2, 3, 4, 5, 6, 9 }));
+
+        const int incoming[] = { 10, 0, 4, 7, 10, 3 };
+        set.insert_range(std::begin(incoming), std::end(incoming));
+
+        assert((set == FlatSet<int>{ 0, 2, 3, 4, 5, 6, 7, 9, 10 }));
+    }
+
+    {
+        const SimpleVector<int> source{ 3, 1, 2, 3 };
+        const FlatSet<int> set(source);
+
+        assert(set.get_size() == 3);
+        assert((set.values() == SimpleVector<int>{ 1, 2, 3 }));
+        assert((source == SimpleVector<int>{ 3, 1, 2, 3 }));
+    }
+
+    {
+        FlatSet<int> set;
+
+        for (int i = 0; i < 1000; ++i)
+        {
+            set.insert((i * 37) % 1000);
+        }
+
+        assert(set.get_size() == 1000);
+
+        for (int i = 0; i < 1000; ++i)
+        {
+            assert(*set.find(i) == i);
+            assert(*set.lower_bound(i) == i);
+        }
+        assert(set.find(1000) == set.end());
+    }
+
+    {
+        FlatMap<std::string, int> map({ { "b"s, 2 }, { "a"s, 1 }, { "c"s, 3 }, { "a"s, 100 } });
+
+        assert(map.get_size() == 3);
+        assert(map.at("a"s) == 1);
+        assert(map["b"s] == 2);
+        assert(map.find("d"s) == map.end());
+
+        map["d"s] = 4;
+        assert(map.get_size() == 4);
+        assert(map.find("d"s)->second == 4);
+
+        assert(!map.insert("d"s, 40).second);
+        assert(map.at("d"s) == 4);
+        assert(!map.insert_or_assign("d"s, 40).second);
+        assert(map.at("d"s) == 40);
+
+        assert(map.erase("b"s) == 1);
+        assert(!map.contains("b"s));
+
+        try
+        {
+            map.at("b"s);
+            assert(false);
+        }
+        catch (const std::out_of_range&)
+        {
+        }
+
+        const std::pair<std::string, int> incoming[] = { { "e"s, 5 }, { "a"s, -1 }, { "b"s, 2 } };
+        map.insert_range(std::begin(incoming), std::end(incoming));
+
+        assert((map.key_column() == SimpleVector<std::string>{ "a"s, "b"s, "c"s, "d"s, "e"s }));
+        assert((map.value_column() == SimpleVector<int>{ 1, 2, 3, 40, 5 }));
+
+        int sum = 0;
+        for (const auto& [key, value] : map)
+        {
+            sum += value;
+        }
+        assert(sum == 51);
+
+        for (auto [key, value] : map)
+        {
+            value = 0;
+        }
+        assert(map.at("e"s) == 0);
+    }
+
+    // Исключение при копировании значения не оставляет ключ без значения
+    {
+        struct Fragile
+        {
+            int value = 0;
+            bool fail = false;
+
+            Fragile(int value, bool fail = false) : value(value), fail(fail) {}
+
+            Fragile(const Fragile& other) : value(other.value), fail(false)
+            {
+                if (other.fail)
+                {
+                    throw std::runtime_error("copy failed");
+                }
+            }
+
+            Fragile(Fragile&&) noexcept = default;
+            Fragile& operator=(const Fragile&) = default;
+            Fragile& operator=(Fragile&&) noexcept = default;
+        };
+
+        FlatMap<int, Fragile> map;
+        map.insert(1, Fragile(10));
+        map.insert(3, Fragile(30));
+
+        bool thrown = false;
+        try
+        {
+            map.insert(2, Fragile(20, true));
+        }
+        catch (const std::runtime_error&)
+        {
+            thrown = true;
+        }
+        assert(thrown);
+        assert(map.get_size() == 2 && map.key_column().get_size() == map.value_column().get_size());
+        assert(!map.contains(2) && map.at(3).value == 30);
+    }
+}
+
+inline void TestFlatHashMap()
+{
+    {
+        FlatHashMap<std::string, int> map{ { "one"s, 1 }, { "two"s, 2 } };
+
+        assert(map.get_size() == 2);
+        assert(map.at("one"s) == 1);
+        assert(map.find("three"s) == map.end());
+
+        map["three"s] = 3;
+
+        assert(map.contains("three"s));
+        assert(!map.insert("three"s, 30).second);
+        assert(map.insert_or_assign("three"s, 30).first->second == 30);
+        assert(map.erase("one"s) == 1);
+        assert(map.erase("one"s) == 0);
+        assert(map.get_size() == 2);
+
+        try
+        {
+            map.at("one"s);
+            assert(false);
+        }
+        catch (const std::out_of_range&)
+        {
+        }
+    }
+
+    {
+        // Тождественный хеш собирает ключи в длинные цепочки, что проверяет сдвиг при удалении
+        struct CollidingHash
+        {
+            size_t operator()(uint64_t key) const noexcept
+            {
+                return key % 7;
+            }
+        };
+
+        FlatHashMap<uint64_t, uint64_t, CollidingHash> map;
+        std::unordered_map<uint64_t, uint64_t> expected;
+        std::mt19937_64 generator(7);
+
+        for (size_t step = 0; step < 20000; ++step)
+        {
+            const uint64_t key = generator() % 500;
+
+            if (generator() % 3 == 0)
+            {
+                assert(map.erase(key) == expected.erase(key));
+            }
+            else
+            {
+                map.insert_or_assign(key, step);
+                expected[key] = step;
+            }
+
+            assert(map.get_size() == expected.size());
+        }
+
+        for (const auto& [key, value] : expected)
+        {
+            assert(map.at(key) == value);
+        }
+
+        size_t visited = 0;
+        for (const auto& [key, value] : map)
+        {
+            assert(expected.at(key) == value);
+            ++visited;
+        }
+        assert(visited == expected.size());
+    }
+
+    {
+        FlatHashMap<int, int> map;
+        map.reserve(1000);
+
+        const size_t capacity = map.get_capacity();
+
+        for (int i = 0; i < 1000; ++i)
+        {
+            map[i] = i * i;
+        }
+
+        assert(map.get_capacity() == capacity);
+        assert(map.get_size() == 1000);
+        assert(map.at(31) == 961);
+
+        map.clear();
+
+        assert(map.is_empty());
+        assert(!map.contains(31));
+    }
+
+    {
+        // Вставка значения самой таблицы на границе перехеширования
+        FlatHashMap<int, std::string> map;
+        for (int i = 0; i < 14; ++i)
+        {
+            map.insert(i, std::string(40, static_cast<char>('a' + i)));
+        }
+
+        const size_t capacity = map.get_capacity();
+        map.insert(100, map.at(3));
+
+        assert(map.get_capacity() > capacity);
+        assert(map.at(100) == std::string(40, 'd'));
+        assert(map.at(3) == map.at(100));
+    }
+}
+
+inline void TestRingBuffer()
+{
+    {
+        RingBuffer<int> buffer;
+
+        assert(buffer.is_empty());
+        assert(buffer.get_capacity() == 0);
+
+        buffer.push_back(2);
+        buffer.push_back(3);
+        buffer.push_front(1);
+        buffer.push_front(0);
+
+        assert(buffer.get_size() == 4);
+        assert(buffer.get_capacity() == 4);
+        assert((buffer == RingBuffer<int>{ 0, 1, 2, 3 }));
+        assert(buffer.front() == 0);
+        assert(buffer.back() == 3);
+
+        buffer.pop_front();
+        buffer.pop_back();
+
+        assert((buffer == RingBuffer<int>{ 1, 2 }));
+
+        try
+        {
+            buffer.at(2);
+            assert(false);
+        }
+        catch (const std::out_of_range&)
+        {
+        }
+    }
+
+    {
+        RingBuffer<int> buffer;
+        buffer.reserve(8);
+
+        for (int i = 0; i < 6; ++i)
+        {
+            buffer.push_back(i);
+        }
+        for (int i = 0; i < 4; ++i)
+        {
+            buffer.pop_front();
+            buffer.push_back(6 + i);
+        }
+
+        // Содержимое 4..9 переходит через край буфера
+        assert(buffer.get_capacity() == 8);
+
+        const auto [first, second] = buffer.as_spans();
+
+        assert(first.size() + second.size() == 6);
+        assert(!second.empty());
+        assert(first.front() == 4);
+        assert(second.back() == 9);
+
+        const int* data = buffer.linearize();
+
+        for (int i = 0; i < 6; ++i)
+        {
+            assert(data[i] == 4 + i);
+            assert(buffer[i] == 4 + i);
+        }
+        assert(buffer.as_spans().second.empty());
+        assert(buffer.get_capacity() == 8);
+
+        buffer.push_front(3);
+        assert(std::is_sorted(buffer.begin(), buffer.end()));
+        assert(buffer.end() - buffer.begin() == 7);
+    }
+
+    {
+        RingBuffer<X> buffer;
+
+        for (size_t i = 0; i < 10; ++i)
+        {
+            if (i % 2 == 0)
+            {
+                buffer.push_back(X(i));
+            }
+            else
+            {
+                buffer.push_front(X(i));
+            }
+        }
+
+        assert(buffer.get_size() == 10);
+        assert(buffer.front().get_x() == 9);
+        assert(buffer.back().get_x() == 8);
+
+        RingBuffer<X> moved = std::move(buffer);
+
+        assert(moved.get_size() == 10);
+        assert(buffer.is_empty());
+
+        moved.shrink_to_fit();
+        assert(moved.get_capacity() == 16);
+        assert(moved[5].get_x() == 0);
+    }
+
+    // Добавление собственного элемента при росте: значение создается до переноса старых элементов
+    {
+        RingBuffer<std::string> buffer;
+        buffer.push_back(std::string(40, 'y'));
+        for (int i = 0; i < 20; ++i)
+        {
+            buffer.push_back(buffer.front());
+            buffer.push_front(buffer.back());
+        }
+        assert(buffer.get_size() == 41);
+        assert(std::all_of(buffer.begin(), buffer.end(), [](const std::string& item) { return item == std::string(40, 'y'); }));
+    }
+
+    // Элементы создаются только при добавлении и уничтожаются при удалении
+    {
+        const auto counter = std::make_shared<int>(0);
+        RingBuffer<std::shared_ptr<int>> buffer;
+        buffer.reserve(8);
+        for (int i = 0; i < 6; ++i)
+        {
+            buffer.push_back(counter);
+        }
+        assert(counter.use_count() == 7);
+        buffer.pop_front();
+        buffer.pop_back();
+        assert(counter.use_count() == 5);
+
+        // Перенос через край и выпрямление без лишних копий
+        for (int i = 0; i < 3; ++i)
+        {
+            buffer.push_back(counter);
+        }
+        buffer.pop_back();
+        buffer.push_front(counter);
+        buffer.push_front(counter);
+        assert(!buffer.as_spans().second.empty());
+        buffer.linearize();
+        assert(buffer.as_spans().second.empty() && counter.use_count() == 9);
+
+        buffer.clear();
+        assert(counter.use_count() == 1);
+
+        RingBuffer<X> items;
+        items.emplace_back(1);
+        items.emplace_front(0);
+        assert(items.front().get_x() == 0 && items.back().get_x() == 1);
+    }
+
+    // Выпрямление строк, переходящих через край
+    {
+        RingBuffer<std::string> buffer;
+        buffer.reserve(8);
+        for (int i = 0; i < 7; ++i)
+        {
+            buffer.push_back(std::to_string(i));
+        }
+        for (int i = 0; i < 5; ++i)
+        {
+            buffer.pop_front();
+            buffer.push_back(std::to_string(7 + i));
+        }
+        const std::string* data = buffer.linearize();
+        for (int i = 0; i < 7; ++i)
+        {
+            assert(data[i] == std::to_string(5 + i));
+        }
+    }
+}
+
+inline void TestConcurrentQueues()
+{
+    {
+        SpscQueue<int> queue(3);
+
+        assert(queue.get_capacity() == 4);
+
+        for (int i = 0; i < 4; ++i)
+        {
+            assert(queue.try_push(i));
+        }
+        assert(!queue.try_push(4));
+
+        int value = -1;
+
+        assert(queue.try_pop(value) && value == 0);
+        assert(queue.get_size() == 3);
+
+        int batch[] = { 10, 11, 12 };
+        assert(queue.try_push_n(batch, 3) == 1);
+
+        SimpleVector<int> out;
+        assert(queue.try_pop_n(out, 10) == 4);
+        assert((out == SimpleVector<int>{ 1, 2, 3, 10 }));
+        assert(!queue.try_pop(value));
+    }
+
+    {
+        // Извлеченный элемент уничтожается в ячейке, оставшиеся уничтожаются вместе с очередью
+        const auto shared = std::make_shared<int>(1);
+        {
+            SpscQueue<std::shared_ptr<int>> queue(4);
+            for (int i = 0; i < 4; ++i)
+            {
+                assert(queue.try_push(shared));
+            }
+
+            std::shared_ptr<int> value;
+            assert(queue.try_pop(value));
+            value.reset();
+            assert(shared.use_count() == 4);
+
+            SimpleVector<std::shared_ptr<int>> out;
+            assert(queue.try_pop_n(out, 2) == 2);
+            out.clear();
+            assert(shared.use_count() == 2);
+        }
+        assert(shared.use_count() == 1);
+
+        // Элементы без конструктора по умолчанию
+        struct NoDefault
+        {
+            explicit NoDefault(int value) : value(value) {}
+
+            int value;
+        };
+
+        SpscQueue<NoDefault> queue(2);
+        assert(queue.try_push(NoDefault(7)));
+        NoDefault item(0);
+        assert(queue.try_pop(item) && item.value == 7);
+    }
+
+    {
+        MpmcQueue<std::string> queue(4);
+
+        assert(queue.try_push("a"s));
+        assert(queue.try_push("b"s));
+
+        std::string batch[] = { "c"s, "d"s, "e"s };
+        assert(queue.try_push_n(batch, 3) == 2);
+        assert(queue.get_size() == 4);
+
+        std::string value;
+        assert(queue.try_pop(value) && value == "a"s);
+
+        SimpleVector<std::string> out;
+        assert(queue.try_pop_n(out, 2) == 2);
+        assert((out == SimpleVector<std::string>{ "b"s, "c"s }));
+        assert(queue.try_pop(value) && value == "d"s);
+        assert(!queue.try_pop(value));
+        assert(queue.try_pop_n(out, 2) == 0);
+    }
+
+    {
+        const size_t count = 100000;
+        SpscQueue<size_t> queue(64);
+
+        std::thread producer([&]
+            {
+                for (size_t i = 0; i < count; ++i)
+                {
+                    while (!queue.try_push(i))
+                    {
+                        std::this_thread::yield();
+                    }
+                }
+            });
+
+        size_t expected = 0;
+        SimpleVector<size_t> batch;
+
+        while (expected < count)
+        {
+            batch.clear();
+            if (queue.try_pop_n(batch, 16) == 0)
+            {
+                std::this_thread::yield();
+            }
+            for (size_t value : batch)
+            {
+                assert(value == expected);
+                ++expected;
+            }
+        }
+        producer.join();
+    }
+
+    {
+        const size_t threads = 3;
+        const size_t per_thread = 30000;
+        MpmcQueue<size_t> queue(128);
+
+        std::atomic<size_t> consumed{ 0 };
+        std::atomic<size_t> sum{ 0 };
+        SimpleVector<std::thread> workers;
+
+        for (size_t t = 0; t < threads; ++t)
+        {
+            workers.push_back(std::thread([&, t]
+                {
+                    size_t batch[8];
+                    for (size_t i = 0; i < per_thread;)
+                    {
+                        if (t % 2 == 0)
+                        {
+                            if (queue.try_push(t * per_thread + i + 1))
+                            {
+                                ++i;
+                            }
+                        }
+                        else
+                        {
+                            const size_t n = std::min<size_t>(8, per_thread - i);
+                            for (size_t j = 0; j < n; ++j)
+                            {
+                                batch[j] = t * per_thread + i + j + 1;
+                            }
+                            i += queue.try_push_n(batch, n);
+                        }
+                        std::this_thread::yield();
+                    }
+                }));
+
+            workers.push_back(std::thread([&, t]
+                {
+                    SimpleVector<size_t> out;
+                    size_t value = 0;
+
+                    while (consumed.load() < threads * per_thread)
+                    {
+                        out.clear();
+                        if (t % 2 == 0 ? queue.try_pop_n(out, 8) > 0 : queue.try_pop(value) && (out.push_back(value), true))
+                        {
+                            size_t local = 0;
+                            for (size_t item : out)
+                            {
+                                local += item;
+                            }
+                            sum += local;
+                            consumed += out.get_size();
+                        }
+                        else
+                        {
+                            std::this_thread::yield();
+                        }
+                    }
+                }));
+        }
+
+        for (std::thread& worker : workers)
+        {
+            worker.join();
+        }
+
+        const size_t total = threads * per_thread;
+        assert(consumed.load() == total);
+        assert(sum.load() == total * (total + 1) / 2);
+    }
+}
+
+inline void TestMiddleInsertContainers()
+{
+    {
+        GapBuffer<int> buffer{ 1, 2, 3 };
+
+        assert(buffer.get_gap_position() == 3);
+
+        buffer.insert(1, 10);
+        buffer.insert(2, 11);
+
+        // Вторая вставка пришлась ровно на разрыв
+        assert(buffer.get_gap_position() == 3);
+        assert((buffer == GapBuffer<int>{ 1, 10, 11, 2, 3 }));
+
+        buffer.erase(0);
+        buffer.insert(4, 12);
+        buffer.pop_back();
+
+        assert((buffer == GapBuffer<int>{ 10, 11, 2, 3 }));
+        assert(buffer.at(3) == 3);
+
+        try
+        {
+            buffer.at(4);
+            assert(false);
+        }
+        catch (const std::out_of_range&)
+        {
+        }
+
+        GapBuffer<int> copy(buffer);
+        buffer.clear();
+
+        assert(buffer.is_empty());
+        assert((copy == GapBuffer<int>{ 10, 11, 2, 3 }));
+    }
+
+    {
+        TieredVector<int> vector;
+
+        for (int i = 0; i < 100; ++i)
+        {
+            vector.push_back(i);
+        }
+        vector.insert(0, -1);
+        vector.insert(50, 1000);
+        vector.erase(vector.get_size() - 1);
+
+        assert(vector.get_size() == 101);
+        assert(vector[0] == -1);
+        assert(vector[50] == 1000);
+        assert(vector[51] == 49);
+        assert(vector.at(100) == 98);
+    }
+
+    {
+        // Сверка с SimpleVector на случайных правках, в том числе с перестройкой блоков
+        std::mt19937 generator(33);
+        SimpleVector<int> expected;
+        GapBuffer<int> buffer;
+        TieredVector<int> tiered;
+
+        for (int i = 0; i < 20000; ++i)
+        {
+            if (expected.is_empty() || generator() % 4 != 0)
+            {
+                const size_t index = generator() % (expected.get_size() + 1);
+                expected.insert(expected.begin() + index, i);
+                buffer.insert(index, i);
+                tiered.insert(index, i);
+            }
+            else
+            {
+                const size_t index = generator() % expected.get_size();
+                expected.erase(expected.begin() + index);
+                buffer.erase(index);
+                tiered.erase(index);
+            }
+        }
+
+        assert(std::equal(expected.begin(), expected.end(), buffer.begin(), buffer.end()));
+        assert(std::equal(expected.begin(), expected.end(), tiered.begin(), tiered.end()));
+        assert(tiered.get_block_size() > 16);
+    }
+
+    {
+        // Нетривиальные элементы: перенос разрыва поштучно, удаленные элементы уничтожаются сразу
+        std::mt19937 generator(34);
+        SimpleVector<std::string> expected;
+        GapBuffer<std::string> buffer;
+
+        for (int i = 0; i < 3000; ++i)
+        {
+            if (expected.is_empty() || generator() % 3 != 0)
+            {
+                const size_t index = generator() % (expected.get_size() + 1);
+                const std::string value(20 + i % 7, static_cast<char>('a' + i % 26));
+                expected.insert(expected.begin() + index, value);
+                buffer.insert(index, value);
+            }
+            else
+            {
+                const size_t index = generator() % expected.get_size();
+                expected.erase(expected.begin() + index);
+                buffer.erase(index);
+            }
+        }
+        assert(std::equal(expected.begin(), expected.end(), buffer.begin(), buffer.end()));
+
+        const auto shared = std::make_shared<int>(1);
+        GapBuffer<std::shared_ptr<int>> pointers;
+        for (int i = 0; i < 8; ++i)
+        {
+            pointers.push_back(shared);
+        }
+        pointers.erase(2);
+        pointers.pop_back();
+        assert(shared.use_count() == 7);
+        pointers.insert(0, pointers[3]);
+        assert(shared.use_count() == 8);
+        pointers.clear();
+        assert(shared.use_count() == 1);
+    }
+
+    {
+        GapBuffer<X> buffer;
+        TieredVector<X> tiered;
+
+        for (size_t i = 0; i < 50; ++i)
+        {
+            buffer.insert(buffer.get_size() / 2, X(i));
+            tiered.insert(tiered.get_size() / 2, X(i));
+        }
+
+        for (size_t i = 0; i < 50; ++i)
+        {
+            assert(buffer[i].get_x() == tiered[i].get_x());
+        }
+
+        GapBuffer<X> moved = std::move(buffer);
+
+        assert(moved.get_size() == 50);
+        assert(buffer.is_empty());
+    }
+}
+
+// Таблица квадратов, построенная на этапе компиляции
+constexpr StaticVector<int, 16> MakeSquaresTable()
+{
+    StaticVector<int, 16> table;
+    for (int i = 0; i < 10; ++i)
+    {
+        table.push_back(i * i);
+    }
+    table.insert(table.begin(), -1);
+    table.erase(table.begin() + 1);
+    return table;
+}
+
+constexpr StaticVector<int, 16> kSquares = MakeSquaresTable();
+
+static_assert(kSquares.get_size() == 10);
+static_assert(kSquares[0] == -1 && kSquares[1] == 1 && kSquares[9] == 81);
+static_assert(kSquares == StaticVector<int, 16>{ -1, 1, 4, 9, 16, 25, 36, 49, 64, 81 });
+
+// Строки с нетривиальным временем жизни тоже пригодны для constexpr-вычислений
+static_assert([]()
+    {
+        StaticVector<std::string, 4> words{ "static"s, "vector"s };
+        words.insert(words.begin() + 1, "constexpr"s);
+        words.resize(4);
+        StaticVector<std::string, 4> copy = words;
+        copy.pop_back();
+        return copy.get_size() == 3 && copy[1] == "constexpr"s && words.back().empty();
+    }());
+
+// Последовательности правок SimpleVector, вычисляемые на этапе компиляции
+static_assert([]()
+    {
+        SimpleVector<int> vector;
+        for (int i = 0; i < 10; ++i)
+        {
+            vector.push_back(i);
+        }
+        vector.insert(vector.begin(), 100);
+        vector.erase(vector.begin() + 5);
+        vector.pop_back();
+        return vector == SimpleVector<int>{ 100, 0, 1, 2, 3, 5, 6, 7, 8 };
+    }());
+
+static_assert([]()
+    {
+        SimpleVector<int> vector(3, 7);
+        vector.resize(6);
+        vector.reserve(20);
+        SimpleVector<int> copy = vector;
+        copy.shrink_to_fit();
+        copy.assign(2, 1);
+        return vector.get_size() == 6 && vector[5] == 0 && vector.get_capacity() == 20
+            && copy.get_capacity() == 6 && copy < vector;
+    }());
+
+static_assert([]()
+    {
+        SimpleVector<std::string> words;
+        words.push_back("compile"s);
+        words.push_back("time"s);
+        words.insert(words.begin() + 1, "-"s);
+        SimpleVector<std::string> moved;
+        moved = std::move(words);
+        return moved.get_size() == 3 && moved[0] + moved[1] + moved[2] == "compile-time"s && words.is_empty();
+    }());
+
+// Таблица простых чисел: решето строится в SimpleVector, результат переносится в StaticVector,
+// который можно хранить в constexpr-переменной
+constexpr StaticVector<int, 32> kPrimes = []()
+{
+    SimpleVector<bool> composite(100, false);
+    SimpleVector<int> primes;
+    for (int i = 2; i < 100; ++i)
+    {
+        if (!composite[i])
+        {
+            primes.push_back(i);
+            for (int j = i * i; j < 100; j += i)
+            {
+                composite[j] = true;
+            }
+        }
+    }
+
+    StaticVector<int, 32> table;
+    table.append_range(primes.begin(), primes.end());
+    return table;
+}();
+
+static_assert(kPrimes.get_size() == 25);
+static_assert(kPrimes.front() == 2 && kPrimes.back() == 97);
+
+inline void TestStaticVector()
+{
+    {
+        StaticVector<int, 8> vector(3, 7);
+
+        assert(vector.get_size() == 3);
+        assert(vector.get_capacity() == 8);
+        assert((vector == StaticVector<int, 8>{ 7, 7, 7 }));
+
+        vector.insert(vector.begin() + 1, 1);
+        vector.erase(vector.begin());
+        vector.resize(5);
+
+        assert((vector == StaticVector<int, 8>{ 1, 7, 7, 0, 0 }));
+        assert((vector < StaticVector<int, 8>{ 1, 8 }));
+
+        vector.assign(8, 2);
+        assert(vector.is_full());
+
+        try
+        {
+            vector.push_back(3);
+            assert(false);
+        }
+        catch (const std::length_error&)
+        {
+        }
+
+        try
+        {
+            vector.at(8);
+            assert(false);
+        }
+        catch (const std::out_of_range&)
+        {
+        }
+    }
+
+    {
+        StaticVector<X, 10> vector;
+
+        for (size_t i = 0; i < 5; ++i)
+        {
+            vector.push_back(X(i));
+        }
+        vector.insert(vector.begin(), X(10));
+
+        StaticVector<X, 10> moved(std::move(vector));
+        StaticVector<X, 10> other;
+        other.push_back(X(20));
+        other.swap(moved);
+
+        assert(moved.get_size() == 1);
+        assert(moved[0].get_x() == 20);
+        assert(other.get_size() == 6);
+        assert(other[0].get_x() == 10);
+        assert(other[5].get_x() == 4);
+    }
+
+    {
+        SimpleVector<int> runtime;
+        for (int value : kSquares)
+        {
+            runtime.push_back(value);
+        }
+
+        assert(runtime.get_size() == kSquares.get_size());
+        assert(std::equal(runtime.begin(), runtime.end(), kSquares.begin()));
+    }
+    {
+        // Исключение при копировании: созданные к этому моменту элементы уничтожаются
+        using Vector = StaticVector<ThrowingCopy, 8>;
+        const Vector source{ ThrowingCopy(1), ThrowingCopy(2), ThrowingCopy(3), ThrowingCopy(4) };
+        const size_t live = ThrowingCopy::live;
+
+        const auto expect_failure = [](auto operation)
+        {
+            const size_t live = ThrowingCopy::live;
+            ThrowingCopy::copies_until_failure = 2;
+            try
+            {
+                operation();
+                assert(false);
+            }
+            catch (const InjectedFailure&)
+            {
+            }
+            ThrowingCopy::copies_until_failure = -1;
+            assert(ThrowingCopy::live == live);
+        };
+
+        expect_failure([&source]() { Vector copy(source); });
+        expect_failure([&source]() { Vector filled(5, source[0]); });
+        expect_failure([]() { Vector list{ ThrowingCopy(1), ThrowingCopy(2), ThrowingCopy(3) }; });
+
+        Vector vector;
+        vector.push_back(ThrowingCopy(7));
+        expect_failure([&vector, &source]() { vector.append_range(source.begin(), source.end()); });
+        assert(vector.get_size() == 1 && vector[0].get_value() == 7);
+
+        // Бросающее присваивание при вставке в середину
+        struct ThrowingAssign : ThrowingCopy
+        {
+            using ThrowingCopy::ThrowingCopy;
+
+            ThrowingAssign(const ThrowingAssign&) = default;
+            ThrowingAssign(ThrowingAssign&&) noexcept = default;
+
+            ThrowingAssign& operator=(const ThrowingAssign&)
+            {
+                throw InjectedFailure();
+            }
+
+            ThrowingAssign& operator=(ThrowingAssign&&)
+            {
+                throw InjectedFailure();
+            }
+        };
+
+        StaticVector<ThrowingAssign, 8> assigned;
+        for (int i = 0; i < 4; ++i)
+        {
+            assigned.push_back(ThrowingAssign(i));
+        }
+        try
+        {
+            assigned.insert(assigned.begin() + 1, ThrowingAssign(9));
+            assert(false);
+        }
+        catch (const InjectedFailure&)
+        {
+        }
+        assert(assigned.get_size() == 4);
+        assert(ThrowingCopy::live == live + 5);
+    }
+}
+
+inline void TestVectorView()
+{
+    {
+        SimpleVector<int> vector{ 0, 1, 2, 3, 4, 5, 6, 7, 8, 9 };
+
+        MutableVectorView<int> middle = vector.slice(2, 5);
+
+        assert(middle.get_size() == 5);
+        assert(middle.data() == vector.data() + 2);
+        assert((middle == SimpleVector<int>{ 2, 3, 4, 5, 6 }));
+
+        for (int& value : middle)
+        {
+            value *= 10;
+        }
+        std::reverse(middle.begin(), middle.end());
+
+        assert((vector == SimpleVector<int>{ 0, 1, 60, 50, 40, 30, 20, 7, 8, 9 }));
+
+        VectorView<int> view = middle;
+        VectorView<int> tail = view.slice(3, 2);
+
+        assert(tail[0] == 30 && tail.back() == 20);
+        assert(view.slice(5, 0).is_empty());
+        assert((SimpleVector<int>{ 60, 50 } == view.slice(0, 2)));
+        assert(view < vector.slice(2, 6));
+
+        try
+        {
+            vector.slice(8, 3);
+            assert(false);
+        }
+        catch (const std::out_of_range&)
+        {
+        }
+
+        try
+        {
+            view.at(5);
+            assert(false);
+        }
+        catch (const std::out_of_range&)
+        {
+        }
+    }
+
+    {
+        // Столбец матрицы 3x4, хранящейся по строкам
+        const SimpleVector<int> matrix{ 1, 2, 3, 4,
+                                        5, 6, 7, 8,
+                                        9, 10, 11, 12 };
+
+        VectorView<int> column(matrix.data() + 2, 3, 4);
+
+        assert((column == SimpleVector<int>{ 3, 7, 11 }));
+        assert(!column.is_contiguous());
+        assert(column.end() - column.begin() == 3);
+        assert(std::accumulate(column.begin(), column.end(), 0) == 21);
+
+        VectorView<int> evens = VectorView<int>(matrix).every(2);
+
+        assert((evens == SimpleVector<int>{ 1, 3, 5, 7, 9, 11 }));
+        assert(evens.every(3).get_size() == 2);
+        assert(*std::lower_bound(evens.begin(), evens.end(), 6) == 7);
+
+        FlatSet<int> set;
+        set.insert_range(column.begin(), column.end());
+
+        assert(set.get_size() == 3);
+        assert(set.contains(7));
+    }
+
+    {
+        SimpleVector<X> vector;
+        for (size_t i = 0; i < 6; ++i)
+        {
+            vector.push_back(X(i));
+        }
+        X* buffer = vector.data();
+
+        // Временный вектор отдает свою память без выделения новой
+        SimpleVector<X> part = std::move(vector).subvector(2, 3);
+
+        assert(part.get_size() == 3);
+        assert(part.data() == buffer);
+        assert(part[0].get_x() == 2 && part[2].get_x() == 4);
+
+        SimpleVector<int> source{ 1, 2, 3, 4 };
+        SimpleVector<int> copy = source.subvector(1, 2);
+
+        assert((copy == SimpleVector<int>{ 2, 3 }));
+        assert(source.get_size() == 4);
+    }
+}
+
+inline void TestVectorExpression()
+{
+    {
+        const SimpleVector<double> a{ 1.0, 2.0, 3.0, 4.0 };
+        const SimpleVector<double> b{ 10.0, 20.0, 30.0, 40.0 };
+
+        SimpleVector<double> c = a * 2.0 + b;
+
+        assert((c == SimpleVector<double>{ 12.0, 24.0, 36.0, 48.0 }));
+
+        const double* buffer = c.data();
+
+        // Вместимости хватает, поэтому результат пишется в ту же память
+        c = fma(a, b, 1.0);
+
+        assert(c.data() == buffer);
+        assert((c == SimpleVector<double>{ 11.0, 41.0, 91.0, 161.0 }));
+
+        c = abs(a - 5.0) / 2.0;
+
+        assert((c == SimpleVector<double>{ 2.0, 1.5, 1.0, 0.5 }));
+
+        // Приемник может быть операндом своего же выражения
+        c = c + c * -1.0 + a;
+
+        assert(c == a);
+
+        const SimpleVector<bool> mask = mask_greater(a, 2.0);
+
+        assert((mask == SimpleVector<bool>{ false, false, true, true }));
+
+        c = where(mask, a, -a);
+
+        assert((c == SimpleVector<double>{ -1.0, -2.0, 3.0, 4.0 }));
+        assert((SimpleVector<bool>(mask_equal(a, b / 10.0)) == SimpleVector<bool>(4, true)));
+
+        try
+        {
+            c = a + SimpleVector<double>(3, 1.0);
+            assert(false);
+        }
+        catch (const std::invalid_argument&)
+        {
+        }
+    }
+
+    {
+        const size_t size = kParallelExpressionThreshold * 4 + 3;
+
+        SimpleVector<float> x(size);
+        SimpleVector<float> y(size);
+        for (size_t i = 0; i < size; ++i)
+        {
+            x[i] = static_cast<float>(i % 1000);
+            y[i] = static_cast<float>(i % 7);
+        }
+
+        const SimpleVector<float> sequential = x * 0.5f - y;
+        const SimpleVector<float> threaded = parallel(x * 0.5f - y);
+
+        assert(sequential == threaded);
+
+        // Деление на части проверяется и там, где потоков у машины меньше порога
+        SimpleVector<float> split(size);
+        EvaluateExpressionParallel(split.data(), x * 0.5f - y, 3);
+
+        assert(split == sequential);
+        assert(threaded[size - 1] == static_cast<float>((size - 1) % 1000) * 0.5f - static_cast<float>((size - 1) % 7));
+    }
+
+    static_assert([]()
+        {
+            SimpleVector<int> a{ 1, -2, 3 };
+            SimpleVector<int> b = abs(a) * 3 - 1;
+            return b == SimpleVector<int>{ 2, 5, 8 };
+        }());
+}
+
+inline void TestRangePipeline()
+{
+    const SimpleVector<int> numbers{ 1, 2, 3, 4, 5, 6, 7, 8, 9, 10 };
+
+    {
+        SimpleVector<int> squares = numbers
+            | filter([](int value) { return value % 2 == 0; })
+            | transform([](int value) { return value * value; })
+            | collect<SimpleVector>();
+
+        assert((squares == SimpleVector<int>{ 4, 16, 36, 64, 100 }));
+
+        // Фильтр знает только верхнюю границу размера, память выделяется один раз под неё
+        assert(squares.get_capacity() == numbers.get_size());
+
+        auto halves = numbers | transform([](int value) { return value / 2.0; });
+        SimpleVector<double> collected = halves | collect();
+
+        assert(collected.get_capacity() == numbers.get_size());
+        assert(collected[9] == 5.0);
+    }
+
+    {
+        size_t visited = 0;
+        SimpleVector<int> first = numbers
+            | transform([&visited](int value) { ++visited; return value * 10; })
+            | take(3)
+            | collect();
+
+        assert((first == SimpleVector<int>{ 10, 20, 30 }));
+        assert(first.get_capacity() == 3);
+
+        // Источник не читается дальше, чем нужно take
+        assert(visited == 3);
+        assert((numbers | take(100) | collect()).get_size() == 10);
+        assert((numbers | take(0) | collect()).is_empty());
+    }
+
+    {
+        SimpleVector<VectorView<int>> parts = numbers | chunk(4) | collect();
+
+        assert(parts.get_size() == 3);
+        assert(parts[0].data() == numbers.data());
+        assert((parts[1] == SimpleVector<int>{ 5, 6, 7, 8 }));
+        assert((parts[2] == SimpleVector<int>{ 9, 10 }));
+
+        SimpleVector<SimpleVector<int>> odd_parts = numbers
+            | filter([](int value) { return value % 2 == 1; })
+            | chunk(2)
+            | collect();
+
+        assert(odd_parts.get_size() == 3);
+        assert((odd_parts[1] == SimpleVector<int>{ 5, 7 }));
+        assert((odd_parts[2] == SimpleVector<int>{ 9 }));
+    }
+
+    {
+        const SimpleVector<std::string> names{ "a"s, "b"s, "c"s };
+
+        SimpleVector<std::pair<int, std::string>> pairs = numbers | zip(names) | collect();
+
+        assert(pairs.get_size() == 3);
+        assert(pairs[2].first == 3 && pairs[2].second == "c"s);
+
+        SimpleVector<std::pair<size_t, std::string>> indexed = names
+            | enumerate()
+            | filter([](const auto& item) { return item.first != 1; })
+            | collect();
+
+        assert(indexed.get_size() == 2);
+        assert(indexed[1].first == 2 && indexed[1].second == "c"s);
+    }
+
+    static_assert([]()
+        {
+            SimpleVector<int> source{ 3, 1, 4, 1, 5, 9, 2, 6 };
+            SimpleVector<int> result = source | filter([](int value) { return value > 2; }) | take(3) | collect();
+            return result == SimpleVector<int>{ 3, 4, 5 };
+        }());
+}
+
+inline void TestSort()
+{
+    std::mt19937_64 generator(39);
+
+    {
+        SimpleVector<int64_t> vector;
+        for (size_t i = 0; i < 10000; ++i)
+        {
+            vector.push_back(static_cast<int64_t>(generator()) >> (i % 40));
+        }
+        SimpleVector<int64_t> expected = vector;
+        std::sort(expected.begin(), expected.end());
+
+        radix_sort(vector);
+
+        assert(vector == expected);
+
+        // Буфером служит свободная вместимость, и отсортированный результат остается на месте
+        SimpleVector<uint16_t> small;
+        small.reserve(100);
+        for (uint16_t value : { 7, 3, 65535, 0, 3, 512 })
+        {
+            small.push_back(value);
+        }
+        const uint16_t* data = small.data();
+        radix_sort(small);
+
+        assert(small.data() == data);
+        assert((small == SimpleVector<uint16_t>{ 0, 3, 3, 7, 512, 65535 }));
+    }
+
+    {
+        SimpleVector<double> vector{ 3.5, -0.0, -1e300, 2.0, -7.25, 1e-300, 0.0, -2.0 };
+        radix_sort(vector);
+
+        assert(std::is_sorted(vector.begin(), vector.end()));
+        assert(vector.front() == -1e300 && vector.back() == 3.5);
+
+        SimpleVector<float> floats{ 1.5f, -1.5f, 0.25f, -100.0f };
+        radix_sort(floats);
+
+        assert((floats == SimpleVector<float>{ -100.0f, -1.5f, 0.25f, 1.5f }));
+    }
+
+    {
+        // Записи с одинаковыми ключами сохраняют исходный порядок
+        SimpleVector<std::pair<uint32_t, size_t>> records;
+        for (size_t i = 0; i < 5000; ++i)
+        {
+            records.push_back({ static_cast<uint32_t>(generator() % 50), i });
+        }
+        const SimpleVector<std::pair<uint32_t, size_t>> original = records;
+        SimpleVector<std::pair<uint32_t, size_t>> expected = records;
+        const auto by_key = [](const auto& lhs, const auto& rhs) { return lhs.first < rhs.first; };
+        std::stable_sort(expected.begin(), expected.end(), by_key);
+
+        radix_sort(records, [](const std::pair<uint32_t, size_t>& record) { return record.first; });
+
+        assert(records == expected);
+
+        SimpleVector<std::pair<uint32_t, size_t>> parallel_records = original;
+        expected = original;
+        std::stable_sort(expected.begin(), expected.end(), [](const auto& lhs, const auto& rhs) { return lhs.first > rhs.first; });
+
+        parallel_stable_sort(parallel_records, [](const auto& lhs, const auto& rhs) { return lhs.first > rhs.first; });
+
+        assert(parallel_records == expected);
+    }
+
+    {
+        const size_t size = kParallelSortThreshold * 3 + 17;
+
+        SimpleVector<uint64_t> vector(size);
+        for (uint64_t& value : vector)
+        {
+            value = generator() % 100000;
+        }
+        SimpleVector<uint64_t> expected = vector;
+        std::sort(expected.begin(), expected.end());
+
+        // Пять частей проверяют и непарную часть при слиянии
+        SimpleVector<uint64_t> parallel_sorted = vector;
+        parallel_sort(parallel_sorted, std::less<>(), 5);
+
+        assert(parallel_sorted == expected);
+
+        SimpleVector<std::pair<uint64_t, size_t>> records(size);
+        for (size_t i = 0; i < size; ++i)
+        {
+            records[i] = { vector[i] % 100, i };
+        }
+        parallel_stable_sort(records, [](const auto& lhs, const auto& rhs) { return lhs.first < rhs.first; }, 4);
+
+        assert(std::is_sorted(records.begin(), records.end()));
+    }
+}
+
+inline void TestThreadPool()
+{
+    {
+        // Владелец работает со своим концом, вор забирает самые старые элементы
+        WorkStealingDeque<int> deque(2);
+        for (int i = 0; i < 10; ++i)
+        {
+            deque.push(i);
+        }
+        assert(deque.get_size() == 10);
+
+        int item = -1;
+        assert(deque.pop(item) && item == 9);
+        assert(deque.steal(item) && item == 0);
+        assert(deque.steal(item) && item == 1);
+        assert(deque.get_size() == 7);
+
+        while (deque.pop(item))
+        {
+        }
+        assert(item == 2);
+        assert(deque.get_size() == 0);
+        assert(!deque.steal(item));
+    }
+
+    {
+        ThreadPool pool(3);
+        assert(pool.get_thread_count() == 3);
+        assert(ThreadPool::current() == nullptr);
+
+        std::atomic<size_t> counter = 0;
+        std::atomic<bool> inside_pool = true;
+        {
+            TaskGroup group(pool);
+            for (size_t i = 0; i < 1000; ++i)
+            {
+                group.run([&]()
+                    {
+                        // Задачу выполняет рабочий пула или сам ожидающий поток
+                        if (ThreadPool::current() != &pool && ThreadPool::current() != nullptr)
+                        {
+                            inside_pool = false;
+                        }
+                        counter.fetch_add(1, std::memory_order_relaxed);
+                    });
+            }
+            group.wait();
+        }
+        assert(counter == 1000);
+
+        // Вложенные группы: задача ждет свои подзадачи, помогая их выполнять
+        counter = 0;
+        {
+            TaskGroup outer(pool);
+            for (size_t i = 0; i < 8; ++i)
+            {
+                outer.run([&]()
+                    {
+                        TaskGroup inner(pool);
+                        for (size_t j = 0; j < 16; ++j)
+                        {
+                            inner.run([&]() { counter.fetch_add(1, std::memory_order_relaxed); });
+                        }
+                        inner.wait();
+                    });
+            }
+            outer.wait();
+        }
+        assert(counter == 8 * 16);
+
+        {
+            TaskGroup group(pool);
+            group.run([]() { throw std::runtime_error("task failed"); });
+            group.run([&]() { counter.fetch_add(1, std::memory_order_relaxed); });
+
+            bool thrown = false;
+            try
+            {
+                group.wait();
+            }
+            catch (const std::runtime_error&)
+            {
+                thrown = true;
+            }
+            assert(thrown);
+            assert(counter == 8 * 16 + 1);
+
+            // Исключение выбрасывается один раз
+            group.wait();
+        }
+
+        const size_t size = 1'000'003;
+        SimpleVector<uint64_t> values(size);
+        parallel_for(0, size, [&values](size_t first, size_t last)
+            {
+                for (size_t i = first; i < last; ++i)
+                {
+                    values[i] = i;
+                }
+            }, 0, pool);
+
+        std::atomic<uint64_t> sum = 0;
+        std::atomic<size_t> ranges = 0;
+        parallel_for(0, size, [&](size_t first, size_t last)
+            {
+                assert(first < last && last - first <= 1000);
+                uint64_t partial = 0;
+                for (size_t i = first; i < last; ++i)
+                {
+                    partial += values[i];
+                }
+                sum.fetch_add(partial, std::memory_order_relaxed);
+                ranges.fetch_add(1, std::memory_order_relaxed);
+            }, 1000, pool);
+
+        assert(sum == uint64_t(size) * (size - 1) / 2);
+        assert(ranges >= size / 1000);
+
+        size_t calls = 0;
+        parallel_for(5, 5, [&calls](size_t, size_t) { ++calls; }, 0, pool);
+        parallel_for(5, 6, [&calls](size_t first, size_t last) { calls += last - first; }, 0, pool);
+        assert(calls == 1);
+
+        bool thrown = false;
+        try
+        {
+            parallel_for(0, 1000, [](size_t first, size_t) { if (first >= 500) throw std::runtime_error("body failed"); }, 10, pool);
+        }
+        catch (const std::runtime_error&)
+        {
+            thrown = true;
+        }
+        assert(thrown);
+
+        assert(inside_pool);
+    }
+
+    {
+        ThreadPool pinned(2, true);
+        std::atomic<size_t> counter = 0;
+        parallel_for(0, 100, [&counter](size_t first, size_t last) { counter += last - first; }, 1, pinned);
+        assert(counter == 100);
+    }
+}
+
+inline void TestErase()
+{
+    {
+        SimpleVector<int> vector{ 1, 2, 3, 4, 5, 6, 7, 8, 9, 10 };
+        assert(erase_if(vector, [](int value) { return value % 2 == 0; }) == 5);
+        assert((vector == SimpleVector<int>{ 1, 3, 5, 7, 9 }));
+        assert(vector.get_capacity() == 10);
+
+        assert(erase(vector, 5) == 1);
+        assert(erase(vector, 42) == 0);
+        assert((vector == SimpleVector<int>{ 1, 3, 7, 9 }));
+
+        assert(erase_if(vector, [](int) { return true; }) == 4);
+        assert(vector.is_empty());
+        assert(erase_if(vector, [](int) { return true; }) == 0);
+    }
+
+    {
+        SimpleVector<std::string> words{ "alpha"s, "beta"s, "gamma"s, "delta"s, "epsilon"s };
+        assert(erase_if(words, [](const std::string& word) { return word.size() == 5; }) == 3);
+        assert((words == SimpleVector<std::string>{ "beta"s, "epsilon"s }));
+    }
+
+    {
+        SimpleVector<int> vector{ 0, 1, 2, 3, 4, 5, 6, 7 };
+        assert(remove_indices(vector, SimpleVector<size_t>{ 0, 3, 4, 7 }) == 4);
+        assert((vector == SimpleVector<int>{ 1, 2, 5, 6 }));
+
+        assert(remove_indices(vector, SimpleVector<size_t>{}) == 0);
+        assert(vector.get_size() == 4);
+
+        bool thrown = false;
+        try
+        {
+            remove_indices(vector, SimpleVector<size_t>{ 1, 1 });
+        }
+        catch (const std::invalid_argument&)
+        {
+            thrown = true;
+        }
+        assert(thrown);
+
+        thrown = false;
+        try
+        {
+            remove_indices(vector, SimpleVector<size_t>{ 4 });
+        }
+        catch (const std::out_of_range&)
+        {
+            thrown = true;
+        }
+        assert(thrown);
+
+        // Ошибка в конце списка обнаруживается до переноса элементов
+        SimpleVector<std::string> words{ "a"s, "b"s, "c"s, "d"s, "e"s };
+        thrown = false;
+        try
+        {
+            remove_indices(words, SimpleVector<size_t>{ 0, 2, 1 });
+        }
+        catch (const std::invalid_argument&)
+        {
+            thrown = true;
+        }
+        assert(thrown);
+        assert((words == SimpleVector<std::string>{ "a"s, "b"s, "c"s, "d"s, "e"s }));
+    }
+
+    {
+        SimpleVector<int> vector{ 1, 1, 2, 2, 2, 3, 1, 1 };
+        assert(unique(vector) == 4);
+        assert((vector == SimpleVector<int>{ 1, 2, 3, 1 }));
+
+        SimpleVector<int> parity{ 1, 3, 5, 2, 4, 7 };
+        assert(unique(parity, [](int lhs, int rhs) { return lhs % 2 == rhs % 2; }) == 3);
+        assert((parity == SimpleVector<int>{ 1, 2, 7 }));
+    }
+
+    {
+        // Размеры, не кратные блоку сжатия, и оба типа ширины блока
+        std::mt19937 generator(41);
+        for (const size_t size : { size_t(0), size_t(1), size_t(15), size_t(16), size_t(17), size_t(1000) })
+        {
+            SimpleVector<uint32_t> narrow(size);
+            SimpleVector<double> wide(size);
+            for (size_t i = 0; i < size; ++i)
+            {
+                narrow[i] = static_cast<uint32_t>(generator());
+                wide[i] = static_cast<double>(narrow[i] % 1000) - 500.0;
+            }
+
+            SimpleVector<uint32_t> expected_narrow;
+            SimpleVector<double> expected_wide;
+            for (size_t i = 0; i < size; ++i)
+            {
+                if (narrow[i] % 3 != 0)
+                {
+                    expected_narrow.push_back(narrow[i]);
+                }
+                if (wide[i] >= 0.0)
+                {
+                    expected_wide.push_back(wide[i]);
+                }
+            }
+
+            erase_if(narrow, [](uint32_t value) { return value % 3 == 0; });
+            erase_if(wide, [](double value) { return value < 0.0; });
+
+            assert(narrow == expected_narrow);
+            assert(wide == expected_wide);
+        }
+    }
+
+    {
+        const size_t size = kParallelEraseThreshold * 3 + 5;
+        SimpleVector<uint64_t> vector(size);
+        for (size_t i = 0; i < size; ++i)
+        {
+            vector[i] = i;
+        }
+        SimpleVector<uint64_t> expected = vector;
+        const auto is_removed = [](uint64_t value) { return value % 7 < 4; };
+
+        const size_t removed = erase_if(expected, is_removed);
+        assert(parallel_erase_if(vector, is_removed, 5) == removed);
+        assert(vector == expected);
+
+        ThreadPool pool(2);
+        assert(parallel_erase_if(vector, [](uint64_t) { return true; }, 3, pool) == expected.get_size());
+        assert(vector.is_empty());
+    }
+}
+
+inline void TestShrinkPolicy()
+{
+    {
+        // Без политики вместимость не меняется
+        SimpleVector<std::string> vector;
+        for (size_t i = 0; i < 100; ++i)
+        {
+            vector.push_back(std::to_string(i));
+        }
+        while (vector.get_size() > 10)
+        {
+            vector.pop_back();
+        }
+        assert(vector.get_capacity() == 128);
+
+        vector.release_unused_memory();
+        assert(vector.get_capacity() == 20);
+        assert(vector[9] == "9"s);
+    }
+
+    {
+        SimpleVector<std::string> vector;
+        vector.set_shrink_policy({ .patience = 3 });
+        for (size_t i = 0; i < 100; ++i)
+        {
+            vector.push_back(std::to_string(i));
+        }
+        assert(vector.get_capacity() == 128);
+
+        // Заполненность ниже четверти начиная с размера 31, память возвращается на третьей операции подряд
+        while (vector.get_size() > 30)
+        {
+            vector.pop_back();
+        }
+        assert(vector.get_capacity() == 128);
+        vector.pop_back();
+        assert(vector.get_size() == 29 && vector.get_capacity() == 58);
+        for (size_t i = 0; i < vector.get_size(); ++i)
+        {
+            assert(vector[i] == std::to_string(i));
+        }
+
+        // Операция с заполненностью выше порога сбрасывает счетчик
+        vector.resize(14);
+        vector.push_back("x"s);
+        vector.push_back("y"s);
+        vector.erase(vector.begin());
+        vector.resize(12);
+        vector.resize(11);
+        assert(vector.get_capacity() == 58);
+        vector.resize(10);
+        assert(vector.get_capacity() == 20);
+
+        SimpleVector<std::string> copy = vector;
+        assert(copy.get_shrink_policy().patience == 3);
+
+        vector.set_shrink_policy({ .patience = 1, .min_capacity = 4 });
+        vector.clear();
+        assert(vector.get_capacity() == 4);
+    }
+
+    {
+        // Большой буфер тривиального типа отдает страницы без перемещения элементов
+        const size_t size = size_t(4) << 20;
+        SimpleVector<uint8_t> bytes(size, 7);
+        bytes.set_shrink_policy({ .patience = 1 });
+        const uint8_t* data = bytes.data();
+
+        bytes.resize(100);
+        assert(bytes.data() == data);
+        assert(bytes.get_capacity() == size);
+        assert(std::all_of(bytes.begin(), bytes.end(), [](uint8_t value) { return value == 7; }));
+
+        bytes.resize(size);
+        assert(std::all_of(bytes.begin() + 100, bytes.end(), [](uint8_t value) { return value == 0; }));
+
+        // Без разрешения отдавать страницы буфер перевыделяется
+        bytes.set_shrink_policy({ .patience = 1, .release_pages = false });
+        bytes.resize(1000);
+        assert(bytes.get_capacity() == 2000);
+    }
+
+    // Присваивание выражения с перевыделением сохраняет политику
+    {
+        const SimpleVector<double> a(100, 1.0);
+        const SimpleVector<double> b(100, 2.0);
+        SimpleVector<double> vector;
+        vector.set_shrink_policy({ .patience = 2, .min_capacity = 8 });
+        vector = a + b;
+        assert(vector.get_size() == 100 && vector[99] == 3.0);
+        assert(vector.get_shrink_policy().patience == 2 && vector.get_shrink_policy().min_capacity == 8);
+    }
+
+    assert(ReleaseMemoryPages(nullptr, 0) == 0);
+}
+
+// Элемент, считающий живые экземпляры. Держит строку в куче, как элементы, ради которых важно уничтожение
+class LifetimeCounter
+{
+public:
+    LifetimeCounter() : LifetimeCounter(0) {}
+
+    LifetimeCounter(int value) : value(value), payload(64, static_cast<char>('a' + value % 26))
+    {
+        ++live;
+    }
+
+    LifetimeCounter(const LifetimeCounter& other) : value(other.value), payload(other.payload)
+    {
+        ++live;
+    }
+
+    LifetimeCounter(LifetimeCounter&& other) noexcept : value(other.value), payload(std::move(other.payload))
+    {
+        ++live;
+    }
+
+    LifetimeCounter& operator=(const LifetimeCounter& other) = default;
+    LifetimeCounter& operator=(LifetimeCounter&& other) noexcept = default;
+
+    ~LifetimeCounter()
+    {
+        --live;
+    }
+
+    int get_value() const
+    {
+        return value;
+    }
+
+    bool operator==(const LifetimeCounter& other) const
+    {
+        return value == other.value;
+    }
+
+    inline static size_t live = 0;
+
+private:
+    int value;
+    std::string payload;
+};
+
+inline void TestElementLifetime()
+{
+    {
+        SimpleVector<LifetimeCounter> vector;
+        const auto check = [&vector]()
+        {
+            assert(LifetimeCounter::live == vector.get_size());
+        };
+
+        for (int i = 0; i < 20; ++i)
+        {
+            vector.push_back(LifetimeCounter(i));
+            check();
+        }
+        {
+            const LifetimeCounter copied(100);
+            vector.push_back(copied);
+            assert(LifetimeCounter::live == vector.get_size() + 1);
+        }
+        check();
+
+        // Вставка ссылки на собственный элемент при заполненной и незаполненной памяти
+        vector.shrink_to_fit();
+        vector.push_back(vector[0]);
+        check();
+        vector.insert(vector.begin() + 3, vector[5]);
+        check();
+        assert(vector[3].get_value() == 5);
+        vector.insert(vector.begin() + 1, LifetimeCounter(-1));
+        check();
+        vector.insert(vector.end(), LifetimeCounter(-2));
+        check();
+
+        vector.erase(vector.begin() + 2);
+        check();
+        vector.pop_back();
+        check();
+
+        vector.resize(40);
+        check();
+        vector.resize(10);
+        check();
+        assert(vector.get_capacity() >= 40);
+
+        vector.reserve(100);
+        check();
+        vector.shrink_to_fit();
+        check();
+
+        vector.assign(5, LifetimeCounter(7));
+        check();
+        vector.assign(50, LifetimeCounter(8));
+        check();
+        vector.assign(3, LifetimeCounter(9));
+        check();
+
+        vector.append_range(vector.begin(), vector.begin());
+        SimpleVector<LifetimeCounter> extra{ 1, 2, 3, 4, 5, 6 };
+        vector.append_range(extra.begin(), extra.end());
+        assert(LifetimeCounter::live == vector.get_size() + extra.get_size());
+        extra.clear();
+        check();
+
+        erase_if(vector, [](const LifetimeCounter& item) { return item.get_value() % 2 == 0; });
+        check();
+        vector.push_back(LifetimeCounter(5));
+        unique(vector);
+        check();
+        remove_indices(vector, SimpleVector<size_t>{ 0 });
+        check();
+
+        vector = std::move(vector).subvector(1, 2);
+        check();
+
+        {
+            SimpleVector<LifetimeCounter> copy = vector;
+            assert(LifetimeCounter::live == 2 * vector.get_size());
+
+            SimpleVector<LifetimeCounter> other(7);
+            copy.swap(other);
+            assert(LifetimeCounter::live == 2 * vector.get_size() + 7);
+
+            copy = vector;
+            assert(LifetimeCounter::live == 3 * vector.get_size());
+        }
+        check();
+
+        vector.set_shrink_policy({ .patience = 1 });
+        vector.resize(64);
+        vector.resize(2);
+        check();
+        assert(vector.get_capacity() == 16);
+
+        vector.clear();
+        check();
+        assert(LifetimeCounter::live == 0);
+    }
+
+    {
+        SimpleVector<LifetimeCounter> vector(10);
+        {
+            SimpleVector<LifetimeCounter> moved = std::move(vector);
+            assert(LifetimeCounter::live == 10);
+        }
+        assert(LifetimeCounter::live == 0);
+        vector.push_back(LifetimeCounter(1));
+    }
+    assert(LifetimeCounter::live == 0);
+
+    {
+        // Исключение из присваивания при вставке в середину без перевыделения
+        struct ThrowingAssign : LifetimeCounter
+        {
+            using LifetimeCounter::LifetimeCounter;
+
+            ThrowingAssign(const ThrowingAssign&) = default;
+            ThrowingAssign(ThrowingAssign&&) noexcept = default;
+
+            ThrowingAssign& operator=(const ThrowingAssign&)
+            {
+                throw InjectedFailure();
+            }
+
+            ThrowingAssign& operator=(ThrowingAssign&&)
+            {
+                throw InjectedFailure();
+            }
+        };
+
+        SimpleVector<ThrowingAssign> vector;
+        vector.reserve(8);
+        for (int i = 0; i < 4; ++i)
+        {
+            vector.push_back(ThrowingAssign(i));
+        }
+
+        try
+        {
+            vector.insert(vector.begin() + 1, ThrowingAssign(9));
+            assert(false);
+        }
+        catch (const InjectedFailure&)
+        {
+        }
+        assert(vector.get_size() == 4);
+        assert(LifetimeCounter::live == 4);
+    }
+    assert(LifetimeCounter::live == 0);
+
+    {
+        // Элементы без конструктора по умолчанию и без копирования
+        SimpleVector<X> vector;
+        vector.reserve(4);
+        for (size_t i = 0; i < 10; ++i)
+        {
+            vector.push_back(X(i));
+        }
+        vector.pop_back();
+        assert(vector.get_size() == 9 && vector.back().get_x() == 8);
+    }
+}
+
+inline void TestCheckedIterators()
+{
+#if SIMPLE_VECTOR_CHECKED_ITERATORS
+    SimpleVector<int> vector{ 1, 2, 3 };
+    vector.reserve(8);
+
+    SimpleVector<int>::Iterator first = vector.begin();
+    SimpleVector<int>::ConstIterator last = std::as_const(vector).end();
+    assert(first.is_valid() && last.is_valid());
+    assert(last - first == 3);
+    assert(std::to_address(last) == vector.data() + 3);
+
+    // Добавление без перевыделения и удаление последнего не трогают остальные итераторы
+    vector.push_back(4);
+    vector.pop_back();
+    assert(first.is_valid() && *first == 1);
+
+    vector.insert(vector.begin() + 1, 10);
+    assert(!first.is_valid() && !last.is_valid());
+
+    first = vector.begin();
+    vector.erase(vector.begin());
+    assert(!first.is_valid());
+
+    first = vector.begin();
+    vector.shrink_to_fit();
+    assert(!first.is_valid());
+
+    first = vector.begin();
+    SimpleVector<int> other{ 5 };
+    vector.swap(other);
+    assert(!first.is_valid());
+
+    first = vector.begin();
+    vector.clear();
+    assert(!first.is_valid());
+#else
+    // Без проверок итератор - обычный указатель
+    static_assert(std::is_same_v<SimpleVector<int>::Iterator, int*>);
+    static_assert(std::is_same_v<SimpleVector<int>::ConstIterator, const int*>);
+#endif
+    static_assert(std::contiguous_iterator<SimpleVector<int>::Iterator>);
+    static_assert(std::contiguous_iterator<SimpleVector<int>::ConstIterator>);
+}
+
+inline void TestDifferential()
+{
+    // Короткие прогоны на псевдослучайных данных; длинные выполняет fuzz_simple_vector.cpp
+    std::mt19937 generator(45);
+    std::vector<uint8_t> data(1024);
+    for (int run = 0; run < 200; ++run)
+    {
+        std::generate(data.begin(), data.end(), [&generator]() { return static_cast<uint8_t>(generator()); });
+        RunDifferentialTest(data.data(), data.size());
+    }
+    assert(ThrowingCopy::live == 0);
+}
+
+// Элемент, который выбрасывает исключение на заданной по счету операции копирования или бросающего перемещения
+template <bool NothrowMove>
+class CountdownElement
+{
+public:
+    CountdownElement(int value = 0) : value(value)
+    {
+        ++live;
+    }
+
+    CountdownElement(const CountdownElement& other) : value(other.value)
+    {
+        Tick();
+        ++copies;
+        ++live;
+    }
+
+    CountdownElement(CountdownElement&& other) noexcept(NothrowMove) : value(other.value)
+    {
+        if constexpr (!NothrowMove)
+        {
+            Tick();
+        }
+        ++moves;
+        ++live;
+    }
+
+    CountdownElement& operator=(const CountdownElement& other)
+    {
+        Tick();
+        value = other.value;
+        return *this;
+    }
+
+    CountdownElement& operator=(CountdownElement&& other) noexcept(NothrowMove)
+    {
+        if constexpr (!NothrowMove)
+        {
+            Tick();
+        }
+        value = other.value;
+        return *this;
+    }
+
+    ~CountdownElement()
+    {
+        --live;
+    }
+
+    int get_value() const
+    {
+        return value;
+    }
+
+    // Количество операций до исключения; отрицательное значение отключает исключения
+    inline static int operations_until_failure = -1;
+    inline static size_t copies = 0;
+    inline static size_t moves = 0;
+    inline static size_t live = 0;
+
+private:
+    int value;
+
+    static void Tick()
+    {
+        if (operations_until_failure >= 0 && operations_until_failure-- == 0)
+        {
+            throw InjectedFailure();
+        }
+    }
+};
+
+// Выполняет operation над полным вектором из 8 элементов, заказывая исключение на каждой операции по очереди,
+// пока operation не завершится. После каждого исключения вектор должен остаться прежним
+template <typename Element, typename Operation>
+void CheckStrongGuarantee(Operation operation)
+{
+    for (int failure = 0;; ++failure)
+    {
+        SimpleVector<Element> vector;
+        vector.reserve(8);
+        for (int i = 0; i < 8; ++i)
+        {
+            vector.push_back(Element(i));
+        }
+        const Element value(100);
+        const size_t live = Element::live;
+
+        Element::operations_until_failure = failure;
+        try
+        {
+            operation(vector, value);
+            Element::operations_until_failure = -1;
+            return;
+        }
+        catch (const InjectedFailure&)
+        {
+            Element::operations_until_failure = -1;
+        }
+
+        assert(Element::live == live);
+        assert(vector.get_size() == 8 && vector.get_capacity() == 8);
+        for (int i = 0; i < 8; ++i)
+        {
+            assert(vector[i].get_value() == i);
+        }
+    }
+}
+
+// Как CheckStrongGuarantee, но у вектора есть свободная память: вставка в середину без перевыделения дает только
+// базовую гарантию, поэтому после исключения проверяются размер и отсутствие утечек, а не значения
+template <typename Element, typename Operation>
+void CheckBasicGuarantee(Operation operation)
+{
+    for (int failure = 0;; ++failure)
+    {
+        SimpleVector<Element> vector;
+        vector.reserve(16);
+        for (int i = 0; i < 8; ++i)
+        {
+            vector.push_back(Element(i));
+        }
+        const Element value(100);
+        const size_t live = Element::live;
+
+        Element::operations_until_failure = failure;
+        try
+        {
+            operation(vector, value);
+            Element::operations_until_failure = -1;
+            return;
+        }
+        catch (const InjectedFailure&)
+        {
+            Element::operations_until_failure = -1;
+        }
+
+        assert(Element::live == live);
+        assert(vector.get_size() == 8 && vector.get_capacity() == 16);
+    }
+}
+
+template <typename Element>
+void TestStrongGuaranteeFor()
+{
+    CheckStrongGuarantee<Element>([](SimpleVector<Element>& vector, const Element& value) { vector.push_back(value); });
+    CheckStrongGuarantee<Element>([](SimpleVector<Element>& vector, const Element& value) { vector.push_back(Element(value)); });
+    CheckStrongGuarantee<Element>([](SimpleVector<Element>& vector, const Element& value) { vector.insert(vector.begin() + 3, value); });
+    CheckStrongGuarantee<Element>([](SimpleVector<Element>& vector, const Element& value) { vector.insert(vector.begin(), Element(value)); });
+    CheckStrongGuarantee<Element>([](SimpleVector<Element>& vector, const Element&) { vector.reserve(32); });
+    CheckStrongGuarantee<Element>([](SimpleVector<Element>& vector, const Element&) { vector.resize(20); });
+    CheckStrongGuarantee<Element>([](SimpleVector<Element>& vector, const Element& value)
+        {
+            const Element range[] = { value, value, value };
+            vector.append_range(std::begin(range), std::end(range));
+        });
+    CheckStrongGuarantee<Element>([](SimpleVector<Element>& vector, const Element&)
+        {
+            SimpleVector<Element> copy(vector);
+            copy.push_back(Element(1));
+            vector = copy;
+        });
+    CheckBasicGuarantee<Element>([](SimpleVector<Element>& vector, const Element& value) { vector.insert(vector.begin() + 3, value); });
+    CheckBasicGuarantee<Element>([](SimpleVector<Element>& vector, const Element& value) { vector.insert(vector.begin(), Element(value)); });
+    assert(Element::live == 0);
+}
+
+inline void TestStrongGuarantee()
+{
+    TestStrongGuaranteeFor<CountdownElement<true>>();
+    TestStrongGuaranteeFor<CountdownElement<false>>();
+
+    // Небросающее перемещение используется при перевыделении, бросающее заменяется копированием
+    {
+        using Element = CountdownElement<true>;
+        SimpleVector<Element> vector(8);
+        Element::copies = 0;
+        Element::moves = 0;
+        vector.push_back(Element(8));
+        assert(Element::copies == 0 && Element::moves == 9);
+    }
+    {
+        using Element = CountdownElement<false>;
+        SimpleVector<Element> vector(8);
+        Element::copies = 0;
+        Element::moves = 0;
+        vector.push_back(Element(8));
+        assert(Element::copies == 8 && Element::moves == 1);
+    }
+
+    // Тривиально копируемые элементы переносятся одним копированием памяти
+    {
+        SimpleVector<int> vector{ 1, 2, 3 };
+        vector.insert(vector.begin() + 1, 10);
+        vector.reserve(100);
+        assert((vector == SimpleVector<int>{ 1, 10, 2, 3 }));
+    }
+}
+
+inline void TestPushBackPaths()
+{
+    {
+        SimpleVector<std::pair<int, std::string>> vector;
+        std::pair<int, std::string>& first = vector.emplace_back(1, "one");
+        assert(first.first == 1 && first.second == "one");
+        vector.emplace_back(2, std::string(40, 'x'));
+        vector.emplace_back();
+        assert(vector.get_size() == 3 && vector[1].second.size() == 40 && vector[2].first == 0);
+    }
+
+    // Элемент самого вектора добавляется корректно и при перевыделении
+    {
+        SimpleVector<std::string> vector;
+        vector.emplace_back(30, 'a');
+        for (int i = 0; i < 6; ++i)
+        {
+            vector.push_back(vector[0]);
+            vector.emplace_back(vector.back());
+        }
+        assert(vector.get_size() == 13);
+        assert(std::all_of(vector.begin(), vector.end(), [](const std::string& item) { return item == std::string(30, 'a'); }));
+    }
+
+    // Вместимость растет вдвое
+    {
+        SimpleVector<int> vector;
+        size_t reallocations = 0;
+        for (int i = 0; i < 1000; ++i)
+        {
+            const size_t capacity = vector.get_capacity();
+            vector.push_back(i);
+            reallocations += vector.get_capacity() != capacity;
+        }
+        assert(reallocations == 11 && vector.get_capacity() == 1024);
+    }
+
+    {
+        SimpleVector<std::string> vector;
+        vector.reserve(4);
+        const std::string value = "value";
+        vector.push_back_unchecked(value);
+        vector.push_back_unchecked(std::string(20, 'b'));
+        assert(vector.get_size() == 2 && vector.get_capacity() == 4);
+        assert(vector[0] == "value" && vector[1] == std::string(20, 'b'));
+    }
+}
+
+inline void TestHeterogeneousVector()
+{
+    struct Large
+    {
+        int id;
+        char text[100];
+    };
+    using Vector = HeterogeneousVector<char, std::string, Large, double, LifetimeCounter>;
+
+    // Добавление копии собственного элемента при росте: элемент создается до переноса старых записей
+    {
+        HeterogeneousVector<std::string, Large> vector;
+        vector.push_back(std::string(40, 'y'));
+        vector.emplace_back<Large>(Large{ 7, "large" });
+        for (int i = 0; i < 20; ++i)
+        {
+            vector.push_back(vector.get<std::string>(0));
+            vector.push_back(vector.get<Large>(1));
+        }
+        assert(vector.get_size() == 42);
+        assert(vector.get<std::string>(40) == std::string(40, 'y') && vector.get<Large>(41).id == 7);
+
+        HeterogeneousVector<int, double> trivial;
+        trivial.push_back(1);
+        for (int i = 0; i < 20; ++i)
+        {
+            trivial.push_back(trivial.get<int>(0));
+        }
+        assert(trivial.get_size() == 21 && trivial.get<int>(20) == 1);
+    }
+
+    {
+        Vector vector;
+        assert(vector.is_empty());
+
+        for (int i = 0; i < 100; ++i)
+        {
+            vector.push_back(static_cast<char>('a' + i % 26));
+            vector.push_back(std::string(i, 'x'));
+            vector.emplace_back<Large>(Large{ i, "large" });
+            vector.push_back(i * 0.5);
+            vector.emplace_back<LifetimeCounter>(i);
+        }
+        assert(vector.get_size() == 500);
+        assert(LifetimeCounter::live == 100);
+
+        // Записи занимают место по своему типу, а не по самому большому
+        assert(vector.get_byte_size() < 500 * (sizeof(Large) + 8));
+
+        // Произвольный доступ
+        assert(vector.get_type_index(0) == 0 && vector.holds<std::string>(1) && vector.holds<LifetimeCounter>(4));
+        assert(vector.get<std::string>(51) == std::string(10, 'x'));
+        assert(vector.get<Large>(52).id == 10 && std::string(vector.get<Large>(52).text) == "large");
+        assert(vector.get<double>(498) == 49.5);
+        assert(vector.get_if<double>(0) == nullptr);
+        assert(vector.visit(4, [](const auto& item) { return sizeof(item); }) == sizeof(LifetimeCounter));
+
+        bool thrown = false;
+        try
+        {
+            vector.get<double>(0);
+        }
+        catch (const std::invalid_argument&)
+        {
+            thrown = true;
+        }
+        assert(thrown);
+        thrown = false;
+        try
+        {
+            vector.visit(500, [](const auto&) {});
+        }
+        catch (const std::out_of_range&)
+        {
+            thrown = true;
+        }
+        assert(thrown);
+
+        // Обход по порядку добавления
+        size_t index = 0;
+        size_t string_bytes = 0;
+        const Vector& const_vector = vector;
+        const_vector.for_each([&](const auto& item)
+            {
+                using Item = std::remove_cvref_t<decltype(item)>;
+                assert(Vector::kTypeIndex<Item> == index % 5);
+                if constexpr (std::is_same_v<Item, std::string>)
+                {
+                    string_bytes += item.size();
+                }
+                ++index;
+            });
+        assert(index == 500 && string_bytes == 4950);
+
+        vector.for_each([](auto& item)
+            {
+                if constexpr (std::is_same_v<std::remove_cvref_t<decltype(item)>, std::string>)
+                {
+                    item += "!";
+                }
+            });
+        assert(vector.get<std::string>(1) == "!");
+
+        Vector copy(vector);
+        assert(copy.get_size() == 500 && LifetimeCounter::live == 200);
+        assert(copy.get<std::string>(496) == std::string(99, 'x') + "!");
+
+        copy.pop_back();
+        copy.pop_back();
+        assert(copy.get_size() == 498 && LifetimeCounter::live == 199);
+        copy.push_back(std::string("tail"));
+        assert(copy.get<std::string>(498) == "tail");
+
+        vector = std::move(copy);
+        assert(vector.get_size() == 499 && LifetimeCounter::live == 99);
+
+        vector.clear();
+        assert(vector.is_empty() && LifetimeCounter::live == 0);
+    }
+
+    // Тривиально копируемые типы переносятся при росте буфера целиком
+    {
+        HeterogeneousVector<uint8_t, uint64_t> vector;
+        vector.reserve(4, 64);
+        for (uint64_t i = 0; i < 1000; ++i)
+        {
+            if (i % 3 == 0)
+            {
+                vector.push_back(static_cast<uint8_t>(i));
+            }
+            else
+            {
+                vector.push_back(i);
+            }
+        }
+        uint64_t sum = 0;
+        vector.for_each([&sum](auto item) { sum += item; });
+        assert(vector.get_size() == 1000 && sum > 0);
+        assert(vector.get<uint64_t>(1) == 1 && vector.get<uint8_t>(999) == static_cast<uint8_t>(999));
+    }
+    assert(LifetimeCounter::live == 0);
+}
+
+inline void TestNdVector()
+{
+    {
+        NdVector<int, 2> matrix({ 3, 4 });
+        assert(matrix.get_size() == 12 && matrix.get_extent(0) == 3 && matrix.get_extent(1) == 4);
+        for (size_t row = 0; row < 3; ++row)
+        {
+            for (size_t column = 0; column < 4; ++column)
+            {
+                matrix(row, column) = static_cast<int>(row * 10 + column);
+            }
+        }
+
+        // Построчное хранение в одном буфере
+        assert(matrix.data()[5] == 11);
+        assert(matrix.view().is_contiguous());
+
+        assert((matrix.row(1) == SimpleVector<int>{ 10, 11, 12, 13 }));
+        assert(matrix.row(1).is_contiguous());
+        assert((matrix.column(2) == SimpleVector<int>{ 2, 12, 22 }));
+        assert(matrix.column(2).get_stride() == 4);
+
+        matrix.column(0)[2] = -1;
+        assert(matrix(2, 0) == -1);
+
+        MutableNdView<int, 2> tile = matrix.subview({ 1, 1 }, { 2, 2 });
+        assert(tile(0, 0) == 11 && tile(1, 1) == 22 && !tile.is_contiguous());
+        tile(1, 0) = 100;
+        assert(matrix(2, 1) == 100);
+
+        const NdView<int, 2> transposed_view = matrix.view().transposed();
+        assert(transposed_view.get_extent(0) == 4 && transposed_view(3, 2) == 23);
+
+        const NdVector<int, 2> transposed = matrix.transposed();
+        assert(transposed.get_extent(0) == 4 && transposed.get_extent(1) == 3);
+        for (size_t row = 0; row < 3; ++row)
+        {
+            for (size_t column = 0; column < 4; ++column)
+            {
+                assert(transposed(column, row) == matrix(row, column));
+            }
+        }
+
+        bool thrown = false;
+        try
+        {
+            matrix.at(3, 0);
+        }
+        catch (const std::out_of_range&)
+        {
+            thrown = true;
+        }
+        assert(thrown);
+
+        // Рост внешнего измерения не сдвигает существующие строки
+        matrix.resize_outer(5);
+        assert(matrix.get_extent(0) == 5 && matrix(1, 3) == 13 && matrix(4, 3) == 0);
+        matrix.resize_outer(2);
+        assert(matrix.get_size() == 8 && matrix(1, 2) == 12);
+    }
+
+    // Хранение по столбцам: внешнее измерение - последнее
+    {
+        NdVector<int, 2> matrix({ 2, 3 }, 7, Layout::kColumnMajor);
+        matrix(1, 0) = 1;
+        assert(matrix.data()[1] == 1);
+        assert(matrix.column(0).is_contiguous() && !matrix.row(0).is_contiguous());
+        assert(matrix.get_outer_dimension() == 1);
+
+        matrix.resize_outer(4);
+        assert(matrix.get_extent(1) == 4 && matrix(1, 0) == 1 && matrix(0, 3) == 0);
+    }
+
+    // Трехмерный массив, срезы и обход блоками
+    {
+        NdVector<int, 3> cube({ 3, 5, 7 });
+        int value = 0;
+        cube.view().for_each([&value](int& item) { item = value++; });
+        assert(cube(2, 4, 6) == 104 && cube(1, 2, 3) == 1 * 35 + 2 * 7 + 3);
+
+        const NdView<int, 2> plane = cube.view().slice(0, 1);
+        assert(plane.get_extent(0) == 5 && plane.get_extent(1) == 7 && plane(2, 3) == cube(1, 2, 3));
+        const VectorView<int> line = plane.slice(1, 3);
+        assert(line.get_size() == 5 && line[4] == cube(1, 4, 3));
+
+        size_t tiles = 0;
+        long long sum = 0;
+        cube.view().for_each_tile({ 2, 2, 4 }, [&](NdView<int, 3> block)
+            {
+                ++tiles;
+                block.for_each([&sum](int item) { sum += item; });
+            });
+        assert(tiles == 2 * 3 * 2 && sum == 104LL * 105 / 2);
+    }
+
+    // Блочное транспонирование матрицы, не кратной блоку
+    {
+        NdVector<double, 2> matrix({ 70, 45 });
+        for (size_t row = 0; row < 70; ++row)
+        {
+            for (size_t column = 0; column < 45; ++column)
+            {
+                matrix(row, column) = static_cast<double>(row * 1000 + column);
+            }
+        }
+        NdVector<double, 2> transposed({ 45, 70 }, Layout::kColumnMajor);
+        transpose_into<double>(matrix.view(), transposed.view());
+        assert(transposed(44, 69) == 69044.0 && transposed(3, 5) == 5003.0);
+    }
+}
+
+inline void TestBufferRecycler()
+{
+    static_assert(BufferRecycler::get_class_bytes(1) == 64 && BufferRecycler::get_class_bytes(64) == 64);
+    static_assert(BufferRecycler::get_class_bytes(65) == 128 && BufferRecycler::get_class_bytes(BufferRecycler::kMaxBytes) == BufferRecycler::kMaxBytes);
+
+#if SIMPLE_VECTOR_BUFFER_RECYCLER
+    BufferRecycler& recycler = BufferRecycler::local();
+    BufferRecycler::SharedDepot& depot = BufferRecycler::shared();
+    assert(recycler.get_byte_limit() == 0 && recycler.get_cached_bytes() == 0);
+
+    // По умолчанию кэш выключен: буфер сразу отдается системе
+    recycler.reset_stats();
+    {
+        SimpleVector<int> vector(100);
+    }
+    assert(recycler.get_cached_bytes() == 0);
+    assert(recycler.get_stats().misses == 1 && recycler.get_stats().released == 1 && recycler.get_stats().get_hit_rate() == 0.0);
+
+    recycler.set_byte_limit(64 * 1024);
+    recycler.reset_stats();
+
+    // Буфер уничтоженного вектора достается следующему вектору того же класса
+    const int* released = nullptr;
+    {
+        SimpleVector<int> vector(100, 1);
+        released = vector.data();
+    }
+    assert(recycler.get_cached_bytes() == 512);
+    {
+        SimpleVector<double> vector(60);
+        assert(static_cast<const void*>(vector.data()) == released);
+        assert(recycler.get_cached_bytes() == 0);
+    }
+    assert(recycler.get_stats().local_hits == 1 && recycler.get_stats().misses == 1 && recycler.get_stats().get_hit_rate() == 0.5);
+
+    // shrink_to_fit и рост возвращают старый буфер в кэш
+    {
+        SimpleVector<int> vector;
+        vector.reserve(256);
+        const int* wide = vector.data();
+        vector.push_back(1);
+        vector.shrink_to_fit();
+        assert(vector.get_capacity() == 1 && recycler.get_cached_bytes() >= 1024);
+
+        SimpleVector<int> other(256);
+        assert(other.data() == wide);
+    }
+
+    // Большие и сверхвыровненные буферы не кэшируются
+    {
+        const size_t cached = recycler.get_cached_bytes();
+        {
+            SimpleVector<char> large(BufferRecycler::kMaxBytes + 1);
+            struct alignas(64) Aligned
+            {
+                char data[64];
+            };
+            SimpleVector<Aligned> aligned(4);
+        }
+        assert(recycler.get_cached_bytes() == cached);
+    }
+
+    // Переполнение кэша: буферы класса уходят в общее хранилище, откуда их забирает другой поток
+    recycler.release();
+    recycler.set_byte_limit(4096);
+    recycler.reset_stats();
+    {
+        SimpleVector<SimpleVector<char>> buffers;
+        buffers.reserve(3);
+        for (int i = 0; i < 3; ++i)
+        {
+            buffers.emplace_back(4096);
+        }
+    }
+    assert(recycler.get_cached_bytes() == 4096);
+    assert(recycler.get_stats().forwarded >= 2 && depot.get_cached_bytes() >= 2 * 4096);
+
+    std::thread([]()
+        {
+            BufferRecycler& worker = BufferRecycler::local();
+            worker.set_byte_limit(64 * 1024);
+            {
+                SimpleVector<char> first(4000);
+                SimpleVector<char> second(3000);
+            }
+            assert(worker.get_stats().shared_hits == 1 && worker.get_stats().misses == 0);
+            assert(worker.get_cached_bytes() == 2 * 4096);
+        }).join();
+    // Буферы завершившегося потока остаются в общем хранилище
+    assert(depot.get_cached_bytes() >= 2 * 4096);
+
+    // Лимит хранилища: лишнее отдается системе
+    depot.set_byte_limit(0);
+    assert(depot.get_cached_bytes() == 0);
+    depot.set_byte_limit(size_t(16) << 20);
+
+    // Вектор, созданный в одном потоке и уничтоженный в другом, попадает в кэш уничтожающего
+    recycler.release();
+    recycler.set_byte_limit(64 * 1024);
+    {
+        SimpleVector<int> moved;
+        std::thread([&moved]()
+            {
+                moved = SimpleVector<int>(512, 7);
+            }).join();
+        assert(moved[511] == 7);
+    }
+    assert(recycler.get_cached_bytes() == 2048);
+
+    // Векторы, которые переживают кэш потока, освобождают буферы напрямую у системы
+    std::thread([]()
+        {
+            thread_local SimpleVector<int> late;
+            BufferRecycler::local().set_byte_limit(64 * 1024);
+            late.push_back(1);
+        }).join();
+    static SimpleVector<int> survivor(100, 1);
+    assert(survivor[99] == 1);
+
+    recycler.set_byte_limit(0);
+    recycler.release();
+    depot.release();
+    assert(recycler.get_cached_bytes() == 0 && depot.get_cached_bytes() == 0);
+#endif
+}
+
 void TestRun()
 {
     Test1();
     Test2();
     Test3();
+    TestSoAVector();
+    TestPackedVector();
+    TestBitVector();
+    TestFlatContainers();
+    TestFlatHashMap();
+    TestRingBuffer();
+    TestConcurrentQueues();
+    TestMiddleInsertContainers();
+    TestStaticVector();
+    TestVectorView();
+    TestVectorExpression();
+    TestRangePipeline();
+    TestSort();
+    TestThreadPool();
+    TestErase();
+    TestShrinkPolicy();
+    TestElementLifetime();
+    TestCheckedIterators();
+    TestDifferential();
+    TestStrongGuarantee();
+    TestPushBackPaths();
+    TestHeterogeneousVector();
+    TestNdVector();
+    TestBufferRecycler();
 
     std::cout << "All tests have been passed"s << endl << endl;
 }
\ No newline at end of file
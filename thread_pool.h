@@ -0,0 +1,511 @@
+#pragma once
+
+#include "array_ptr.h"
+#include "ring_buffer.h"
+
+#include <algorithm>
+#include <atomic>
+#include <bit>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <utility>
+
+#if defined(__linux__)
+#include <pthread.h>
+#include <sched.h>
+#elif defined(_WIN32)
+// Без этих макросов windows.h объявляет макросы min и max, которые ломают std::numeric_limits<...>::max() у всех, кто включил пул
+#if !defined(NOMINMAX)
+#define NOMINMAX
+#endif
+#if !defined(WIN32_LEAN_AND_MEAN)
+#define WIN32_LEAN_AND_MEAN
+#endif
+#include <windows.h>
+#endif
+
+//================================================================ Дек с кражей работы ====================================================================
+
+// Дек Чейза-Лева: владелец кладет и забирает с нижнего конца без блокировок,
+// остальные потоки крадут с верхнего. Заполненный буфер удваивается; старые буферы
+// живут до уничтожения дека, потому что вор мог успеть прочитать указатель на них
+template <typename Type>
+class WorkStealingDeque
+{
+public:
+
+    explicit WorkStealingDeque(size_t capacity = 256) : buffer(new Buffer(std::bit_ceil(std::max<size_t>(capacity, 2)), nullptr)) {}
+
+    WorkStealingDeque(const WorkStealingDeque&) = delete;
+    WorkStealingDeque& operator=(const WorkStealingDeque&) = delete;
+
+    ~WorkStealingDeque()
+    {
+        Buffer* current = buffer.load(std::memory_order_relaxed);
+        while (current != nullptr)
+        {
+            Buffer* previous = current->previous;
+            delete current;
+            current = previous;
+        }
+    }
+
+    // Добавление владельцем O(1) амортизированно
+    void push(Type item)
+    {
+        const int64_t b = bottom.load(std::memory_order_relaxed);
+        const int64_t t = top.load(std::memory_order_acquire);
+        Buffer* current = buffer.load(std::memory_order_relaxed);
+
+        if (b - t >= static_cast<int64_t>(current->capacity))
+        {
+            current = Grow(current, t, b);
+        }
+        current->Put(b, item);
+        bottom.store(b + 1, std::memory_order_release);
+    }
+
+    // Извлечение владельцем последнего добавленного элемента O(1)
+    bool pop(Type& item)
+    {
+        const int64_t b = bottom.load(std::memory_order_relaxed) - 1;
+        Buffer* current = buffer.load(std::memory_order_relaxed);
+        bottom.store(b, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        int64_t t = top.load(std::memory_order_relaxed);
+
+        if (t > b)
+        {
+            bottom.store(b + 1, std::memory_order_relaxed);
+            return false;
+        }
+
+        item = current->Get(b);
+        if (t == b)
+        {
+            // Последний элемент: владелец соревнуется с ворами
+            const bool won = top.compare_exchange_strong(t, t + 1, std::memory_order_seq_cst, std::memory_order_relaxed);
+            bottom.store(b + 1, std::memory_order_relaxed);
+            return won;
+        }
+        return true;
+    }
+
+    // Кража самого старого элемента другим потоком O(1)
+    bool steal(Type& item)
+    {
+        int64_t t = top.load(std::memory_order_acquire);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        const int64_t b = bottom.load(std::memory_order_acquire);
+
+        if (t >= b)
+        {
+            return false;
+        }
+
+        Buffer* current = buffer.load(std::memory_order_acquire);
+        item = current->Get(t);
+        return top.compare_exchange_strong(t, t + 1, std::memory_order_seq_cst, std::memory_order_relaxed);
+    }
+
+    // Приблизительное количество элементов O(1)
+    size_t get_size() const noexcept
+    {
+        const int64_t b = bottom.load(std::memory_order_relaxed);
+        const int64_t t = top.load(std::memory_order_relaxed);
+        return b > t ? static_cast<size_t>(b - t) : 0;
+    }
+
+private:
+
+    struct Buffer
+    {
+        Buffer(size_t capacity, Buffer* previous) : capacity(capacity), items(capacity), previous(previous) {}
+
+        void Put(int64_t index, Type item) noexcept
+        {
+            items[static_cast<size_t>(index) & (capacity - 1)].store(item, std::memory_order_relaxed);
+        }
+
+        Type Get(int64_t index) const noexcept
+        {
+            return items[static_cast<size_t>(index) & (capacity - 1)].load(std::memory_order_relaxed);
+        }
+
+        size_t capacity;
+        ArrayPtr<std::atomic<Type>> items;
+        Buffer* previous;
+    };
+
+    std::atomic<int64_t> top{ 0 };
+    std::atomic<int64_t> bottom{ 0 };
+    std::atomic<Buffer*> buffer;
+
+    Buffer* Grow(Buffer* current, int64_t t, int64_t b)
+    {
+        Buffer* grown = new Buffer(current->capacity * 2, current);
+        for (int64_t i = t; i < b; ++i)
+        {
+            grown->Put(i, current->Get(i));
+        }
+        buffer.store(grown, std::memory_order_release);
+        return grown;
+    }
+};
+
+//================================================================ Пул потоков ============================================================================
+
+class TaskGroup;
+
+// Пул рабочих потоков с кражей работы. У каждого рабочего свой дек: задачи, порожденные внутри задачи,
+// кладутся в него и выполняются в обратном порядке, а простаивающие потоки крадут самые старые, то есть самые крупные.
+// Задачи из посторонних потоков попадают в общую очередь
+class ThreadPool
+{
+public:
+
+    // Создает пул из thread_count потоков; pin_threads закрепляет i-й поток за i-м ядром
+    explicit ThreadPool(size_t thread_count = std::max<size_t>(1, std::thread::hardware_concurrency()), bool pin_threads = false)
+        : thread_count(std::max<size_t>(1, thread_count)), workers(this->thread_count)
+    {
+        for (size_t i = 0; i < this->thread_count; ++i)
+        {
+            workers[i].thread = std::thread([this, i]() { WorkerLoop(i); });
+            if (pin_threads)
+            {
+                PinThread(workers[i].thread, i);
+            }
+        }
+    }
+
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+
+    ~ThreadPool()
+    {
+        {
+            std::lock_guard guard(sleep_mutex);
+            stopping.store(true, std::memory_order_seq_cst);
+        }
+        wake.notify_all();
+
+        for (size_t i = 0; i < thread_count; ++i)
+        {
+            workers[i].thread.join();
+        }
+    }
+
+    // Количество рабочих потоков O(1)
+    size_t get_thread_count() const noexcept
+    {
+        return thread_count;
+    }
+
+    // Пул, к которому относится текущий поток, или nullptr для посторонних потоков O(1)
+    static ThreadPool* current() noexcept
+    {
+        return current_pool;
+    }
+
+private:
+
+    friend class TaskGroup;
+
+    struct Task
+    {
+        std::function<void()> function;
+        TaskGroup* group;
+    };
+
+    struct Worker
+    {
+        WorkStealingDeque<Task*> deque;
+        std::thread thread;
+    };
+
+    static constexpr size_t kSpinsBeforeSleep = 64;
+
+    const size_t thread_count;
+    ArrayPtr<Worker> workers;
+
+    std::mutex injection_mutex;
+    RingBuffer<Task*> injection;
+
+    std::mutex sleep_mutex;
+    std::condition_variable wake;
+    std::atomic<size_t> queued{ 0 };
+    std::atomic<size_t> sleeping{ 0 };
+    std::atomic<bool> stopping{ false };
+
+    inline static thread_local ThreadPool* current_pool = nullptr;
+    inline static thread_local size_t current_index = 0;
+
+    // Кладет задачу в дек текущего рабочего или в общую очередь
+    void Submit(Task* task)
+    {
+        if (current_pool == this)
+        {
+            workers[current_index].deque.push(task);
+        }
+        else
+        {
+            std::lock_guard guard(injection_mutex);
+            injection.push_back(task);
+        }
+
+        queued.fetch_add(1, std::memory_order_seq_cst);
+        if (sleeping.load(std::memory_order_seq_cst) > 0)
+        {
+            {
+                std::lock_guard guard(sleep_mutex);
+            }
+            wake.notify_one();
+        }
+    }
+
+    // Находит задачу: свой дек, общая очередь, деки других рабочих
+    Task* FindTask()
+    {
+        Task* task = nullptr;
+
+        if (current_pool == this && workers[current_index].deque.pop(task))
+        {
+            return Taken(task);
+        }
+
+        if (queued.load(std::memory_order_acquire) == 0)
+        {
+            return nullptr;
+        }
+
+        {
+            std::lock_guard guard(injection_mutex);
+            if (!injection.is_empty())
+            {
+                task = injection.front();
+                injection.pop_front();
+                return Taken(task);
+            }
+        }
+
+        const size_t start = current_pool == this ? current_index + 1 : 0;
+        for (size_t i = 0; i < thread_count; ++i)
+        {
+            Worker& victim = workers[(start + i) % thread_count];
+            if (victim.deque.steal(task))
+            {
+                return Taken(task);
+            }
+        }
+        return nullptr;
+    }
+
+    Task* Taken(Task* task) noexcept
+    {
+        queued.fetch_sub(1, std::memory_order_relaxed);
+        return task;
+    }
+
+    // Выполняет одну найденную задачу; false, если задач нет
+    bool RunPendingTask();
+
+    void WorkerLoop(size_t index)
+    {
+        current_pool = this;
+        current_index = index;
+
+        size_t spins = 0;
+        while (!stopping.load(std::memory_order_acquire))
+        {
+            if (RunPendingTask())
+            {
+                spins = 0;
+                continue;
+            }
+            if (++spins < kSpinsBeforeSleep)
+            {
+                std::this_thread::yield();
+                continue;
+            }
+
+            std::unique_lock lock(sleep_mutex);
+            sleeping.fetch_add(1, std::memory_order_seq_cst);
+            wake.wait(lock, [this]()
+                {
+                    return stopping.load(std::memory_order_seq_cst) || queued.load(std::memory_order_seq_cst) > 0;
+                });
+            sleeping.fetch_sub(1, std::memory_order_seq_cst);
+            spins = 0;
+        }
+    }
+
+    static void PinThread(std::thread& thread, size_t index)
+    {
+        const size_t cores = std::max<size_t>(1, std::thread::hardware_concurrency());
+#if defined(__linux__)
+        cpu_set_t set;
+        CPU_ZERO(&set);
+        CPU_SET(index % cores, &set);
+        pthread_setaffinity_np(thread.native_handle(), sizeof(set), &set);
+#elif defined(_WIN32)
+        SetThreadAffinityMask(thread.native_handle(), DWORD_PTR(1) << (index % cores % (sizeof(DWORD_PTR) * 8)));
+#else
+        (void)thread;
+        (void)index;
+        (void)cores;
+#endif
+    }
+};
+
+// Пул по умолчанию, создается при первом обращении
+inline ThreadPool& DefaultThreadPool()
+{
+    static ThreadPool pool;
+    return pool;
+}
+
+//================================================================ Группа задач ===========================================================================
+
+// Набор задач, завершения которых можно дождаться. Ожидающий поток не простаивает,
+// а выполняет задачи пула, поэтому ожидание внутри задачи не приводит к взаимной блокировке.
+// Первое исключение из задач группы повторно выбрасывается из wait()
+class TaskGroup
+{
+public:
+
+    explicit TaskGroup(ThreadPool& pool = DefaultThreadPool()) noexcept : pool(pool) {}
+
+    TaskGroup(const TaskGroup&) = delete;
+    TaskGroup& operator=(const TaskGroup&) = delete;
+
+    ~TaskGroup()
+    {
+        WaitAll();
+    }
+
+    // Запускает function в пуле
+    template <typename Function>
+    void run(Function&& function)
+    {
+        pending.fetch_add(1, std::memory_order_relaxed);
+        pool.Submit(new ThreadPool::Task{ std::forward<Function>(function), this });
+    }
+
+    // Ждет завершения всех задач группы, помогая их выполнять
+    void wait()
+    {
+        WaitAll();
+
+        std::exception_ptr first_error;
+        {
+            std::lock_guard guard(error_mutex);
+            std::swap(first_error, error);
+        }
+        if (first_error)
+        {
+            std::rethrow_exception(first_error);
+        }
+    }
+
+    ThreadPool& get_pool() const noexcept
+    {
+        return pool;
+    }
+
+private:
+
+    friend class ThreadPool;
+
+    ThreadPool& pool;
+    std::atomic<size_t> pending{ 0 };
+    std::mutex error_mutex;
+    std::exception_ptr error;
+
+    void WaitAll()
+    {
+        while (pending.load(std::memory_order_acquire) > 0)
+        {
+            if (!pool.RunPendingTask())
+            {
+                std::this_thread::yield();
+            }
+        }
+    }
+
+    void Execute(std::function<void()>& function) noexcept
+    {
+        try
+        {
+            function();
+        }
+        catch (...)
+        {
+            std::lock_guard guard(error_mutex);
+            if (!error)
+            {
+                error = std::current_exception();
+            }
+        }
+        pending.fetch_sub(1, std::memory_order_release);
+    }
+};
+
+inline bool ThreadPool::RunPendingTask()
+{
+    Task* task = FindTask();
+    if (task == nullptr)
+    {
+        return false;
+    }
+
+    task->group->Execute(task->function);
+    delete task;
+    return true;
+}
+
+//================================================================ Параллельный цикл ======================================================================
+
+// Вызывает body(range_first, range_last) для непересекающихся частей [first, last), покрывающих весь диапазон.
+// Диапазон делится пополам, пока часть больше grain, и правые половины уходят в пул.
+// При grain == 0 размер части подбирается по размеру диапазона: около восьми частей на поток
+template <typename Body>
+void parallel_for(size_t first, size_t last, Body body, size_t grain = 0, ThreadPool& pool = DefaultThreadPool())
+{
+    if (first >= last)
+    {
+        return;
+    }
+
+    const size_t size = last - first;
+    if (grain == 0)
+    {
+        grain = std::max<size_t>(1, size / (pool.get_thread_count() * 8));
+    }
+    if (size <= grain)
+    {
+        body(first, last);
+        return;
+    }
+
+    // Делит [range_first, range_last), оставляя себе левую половину.
+    // Объявлена до группы, чтобы пережить ожидание в её деструкторе при исключении
+    const auto split = [&body, grain](auto& self, TaskGroup& group, size_t range_first, size_t range_last) -> void
+    {
+        while (range_last - range_first > grain)
+        {
+            const size_t middle = range_first + (range_last - range_first) / 2;
+            group.run([&self, &group, middle, range_last]() { self(self, group, middle, range_last); });
+            range_last = middle;
+        }
+        body(range_first, range_last);
+    };
+
+    TaskGroup group(pool);
+    split(split, group, first, last);
+    group.wait();
+}
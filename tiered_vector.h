@@ -0,0 +1,393 @@
+#pragma once
+
+#include "ring_buffer.h"
+#include "simple_vector.h"
+
+#include <algorithm>
+#include <cassert>
+#include <initializer_list>
+#include <iterator>
+#include <stdexcept>
+#include <utility>
+
+// Двухуровневый вектор: элементы разложены по блокам-кольцевым буферам одинаковой вместимости B,
+// все блоки, кроме последнего, заполнены. Вставка и удаление сдвигают элементы только внутри одного блока,
+// а между блоками переносят по одному элементу с края на край, поэтому стоят O(B + N / B) = O(sqrt(N)).
+// Доступ по индексу остается O(1): номер блока и смещение получаются сдвигом и маской
+template <typename Type>
+class TieredVector
+{
+public:
+
+    // Итератор произвольного доступа по логическим индексам
+    template <bool IsConst>
+    class BasicIterator
+    {
+    public:
+
+        using VectorPointer = std::conditional_t<IsConst, const TieredVector*, TieredVector*>;
+
+        using iterator_category = std::random_access_iterator_tag;
+        using value_type = Type;
+        using difference_type = std::ptrdiff_t;
+        using pointer = std::conditional_t<IsConst, const Type*, Type*>;
+        using reference = std::conditional_t<IsConst, const Type&, Type&>;
+
+        BasicIterator() = default;
+
+        BasicIterator(VectorPointer vector, size_t index) noexcept : vector(vector), index(index) {}
+
+        reference operator*() const noexcept
+        {
+            return (*vector)[index];
+        }
+
+        pointer operator->() const noexcept
+        {
+            return &(*vector)[index];
+        }
+
+        BasicIterator& operator++() noexcept
+        {
+            ++index;
+            return *this;
+        }
+
+        BasicIterator operator++(int) noexcept
+        {
+            BasicIterator temp(*this);
+            ++index;
+            return temp;
+        }
+
+        BasicIterator& operator--() noexcept
+        {
+            --index;
+            return *this;
+        }
+
+        BasicIterator operator--(int) noexcept
+        {
+            BasicIterator temp(*this);
+            --index;
+            return temp;
+        }
+
+        BasicIterator& operator+=(difference_type offset) noexcept
+        {
+            index += offset;
+            return *this;
+        }
+
+        BasicIterator operator+(difference_type offset) const noexcept
+        {
+            return BasicIterator(vector, index + offset);
+        }
+
+        BasicIterator operator-(difference_type offset) const noexcept
+        {
+            return BasicIterator(vector, index - offset);
+        }
+
+        difference_type operator-(const BasicIterator& other) const noexcept
+        {
+            return static_cast<difference_type>(index) - static_cast<difference_type>(other.index);
+        }
+
+        bool operator==(const BasicIterator& other) const noexcept
+        {
+            return index == other.index;
+        }
+
+        bool operator!=(const BasicIterator& other) const noexcept
+        {
+            return index != other.index;
+        }
+
+        bool operator<(const BasicIterator& other) const noexcept
+        {
+            return index < other.index;
+        }
+
+    private:
+
+        VectorPointer vector = nullptr;
+        size_t index = 0;
+    };
+
+    using Iterator = BasicIterator<false>;
+    using ConstIterator = BasicIterator<true>;
+
+//===================================================================== Конструкторы и деструктор ==========================================================
+
+    TieredVector() noexcept = default;
+
+    // Создает вектор с помощью {}
+    TieredVector(std::initializer_list<Type> init)
+    {
+        for (const Type& value : init)
+        {
+            push_back(value);
+        }
+    }
+
+//================================================================ Операторы ===============================================================================
+
+    // Элемент по индексу O(1)
+    Type& operator[](size_t index) noexcept
+    {
+        assert(index < size);
+        return blocks[index >> block_shift][index & (BlockSize() - 1)];
+    }
+
+    // Константный элемент по индексу O(1)
+    const Type& operator[](size_t index) const noexcept
+    {
+        assert(index < size);
+        return blocks[index >> block_shift][index & (BlockSize() - 1)];
+    }
+
+//===================================================================== Итераторы ==========================================================================
+
+    Iterator begin() noexcept
+    {
+        return Iterator(this, 0);
+    }
+
+    Iterator end() noexcept
+    {
+        return Iterator(this, size);
+    }
+
+    ConstIterator begin() const noexcept
+    {
+        return ConstIterator(this, 0);
+    }
+
+    ConstIterator end() const noexcept
+    {
+        return ConstIterator(this, size);
+    }
+
+//===================================================================== Методы =============================================================================
+
+//------------------------------------------------------------- Заполнение и добавление --------------------------------------------------------------------
+
+    // Вставка перед index с копированием O(sqrt(N))
+    void insert(size_t index, const Type& value)
+    {
+        Type copy(value);
+        insert(index, std::move(copy));
+    }
+
+    // Вставка перед index с перемещением O(sqrt(N))
+    void insert(size_t index, Type&& value)
+    {
+        assert(index <= size);
+
+        if (blocks.is_empty() || blocks.back().get_size() == BlockSize())
+        {
+            AppendBlock();
+        }
+
+        // Каждый заполненный блок правее целевого отдает свой последний элемент в начало следующего
+        const size_t target = index >> block_shift;
+        for (size_t i = blocks.get_size() - 1; i > target; --i)
+        {
+            blocks[i].push_front(std::move(blocks[i - 1].back()));
+            blocks[i - 1].pop_back();
+        }
+
+        InsertIntoBlock(blocks[target], index & (BlockSize() - 1), std::move(value));
+        ++size;
+
+        if (blocks.get_size() > 2 * BlockSize())
+        {
+            Rebuild(block_shift + 1);
+        }
+    }
+
+    // Добавление в конец с копированием O(1) амортизированно
+    void push_back(const Type& value)
+    {
+        insert(size, value);
+    }
+
+    // Добавление в конец с перемещением O(1) амортизированно
+    void push_back(Type&& value)
+    {
+        insert(size, std::move(value));
+    }
+
+//-------------------------------------------------------------- Получение значений ------------------------------------------------------------------------
+
+    // Текущий размер O(1)
+    size_t get_size() const noexcept
+    {
+        return size;
+    }
+
+    // Проверка на пустоту O(1)
+    bool is_empty() const noexcept
+    {
+        return size == 0;
+    }
+
+    // Вместимость одного блока O(1)
+    size_t get_block_size() const noexcept
+    {
+        return BlockSize();
+    }
+
+    // Ссылка на элемент по индексу с проверкой O(1)
+    Type& at(size_t index)
+    {
+        if (index >= size)
+        {
+            throw std::out_of_range("Out of range");
+        }
+        return (*this)[index];
+    }
+
+    // Константная ссылка на элемент по индексу с проверкой O(1)
+    const Type& at(size_t index) const
+    {
+        if (index >= size)
+        {
+            throw std::out_of_range("Out of range");
+        }
+        return (*this)[index];
+    }
+
+//------------------------------------------------------------------------ Очистка и удаление --------------------------------------------------------------
+
+    // Удаление элемента по индексу O(sqrt(N))
+    void erase(size_t index)
+    {
+        assert(index < size);
+
+        const size_t target = index >> block_shift;
+        EraseFromBlock(blocks[target], index & (BlockSize() - 1));
+
+        // Каждый следующий блок отдает свой первый элемент в конец предыдущего
+        for (size_t i = target + 1; i < blocks.get_size(); ++i)
+        {
+            blocks[i - 1].push_back(std::move(blocks[i].front()));
+            blocks[i].pop_front();
+        }
+        if (blocks.back().is_empty())
+        {
+            blocks.pop_back();
+        }
+        --size;
+    }
+
+    // Удаление последнего элемента O(1)
+    void pop_back()
+    {
+        assert(size > 0);
+
+        erase(size - 1);
+    }
+
+    // Очистить вектор O(1)
+    void clear() noexcept
+    {
+        blocks.clear();
+        size = 0;
+    }
+
+    // Обмен значений O(1)
+    void swap(TieredVector& other) noexcept
+    {
+        blocks.swap(other.blocks);
+        std::swap(size, other.size);
+        std::swap(block_shift, other.block_shift);
+    }
+
+private:
+
+    static constexpr size_t kInitialBlockShift = 4;
+
+    SimpleVector<RingBuffer<Type>> blocks;
+    size_t size = 0;
+    size_t block_shift = kInitialBlockShift;
+
+    size_t BlockSize() const noexcept
+    {
+        return size_t(1) << block_shift;
+    }
+
+    void AppendBlock()
+    {
+        RingBuffer<Type> block;
+        block.reserve(BlockSize());
+        blocks.push_back(std::move(block));
+    }
+
+    // Вставка внутрь блока со сдвигом более короткой из двух частей O(B)
+    static void InsertIntoBlock(RingBuffer<Type>& block, size_t offset, Type&& value)
+    {
+        if (offset < block.get_size() / 2)
+        {
+            block.push_front(std::move(value));
+            std::rotate(block.begin(), block.begin() + 1, block.begin() + offset + 1);
+        }
+        else
+        {
+            block.push_back(std::move(value));
+            std::rotate(block.begin() + offset, block.end() - 1, block.end());
+        }
+    }
+
+    // Удаление изнутри блока со сдвигом более короткой из двух частей O(B)
+    static void EraseFromBlock(RingBuffer<Type>& block, size_t offset)
+    {
+        if (offset < block.get_size() / 2)
+        {
+            std::move_backward(block.begin(), block.begin() + offset, block.begin() + offset + 1);
+            block.pop_front();
+        }
+        else
+        {
+            std::move(block.begin() + offset + 1, block.end(), block.begin() + offset);
+            block.pop_back();
+        }
+    }
+
+    // Перекладывает элементы в блоки вместимости 2^new_shift, чтобы число блоков оставалось порядка sqrt(N) O(N)
+    void Rebuild(size_t new_shift)
+    {
+        TieredVector rebuilt;
+        rebuilt.block_shift = new_shift;
+
+        for (RingBuffer<Type>& block : blocks)
+        {
+            for (Type& value : block)
+            {
+                if (rebuilt.blocks.is_empty() || rebuilt.blocks.back().get_size() == rebuilt.BlockSize())
+                {
+                    rebuilt.AppendBlock();
+                }
+                rebuilt.blocks.back().push_back(std::move(value));
+            }
+        }
+        rebuilt.size = size;
+
+        swap(rebuilt);
+    }
+};
+
+//================================================= Блок перегруженных операторов =========================================================
+
+template <typename Type>
+inline bool operator==(const TieredVector<Type>& lhs, const TieredVector<Type>& rhs)
+{
+    return std::equal(lhs.begin(), lhs.end(), rhs.begin(), rhs.end());
+}
+
+template <typename Type>
+inline bool operator!=(const TieredVector<Type>& lhs, const TieredVector<Type>& rhs)
+{
+    return !(lhs == rhs);
+}
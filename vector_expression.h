@@ -0,0 +1,361 @@
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <concepts>
+#include <cstddef>
+#include <functional>
+#include <limits>
+#include <memory>
+#include <stdexcept>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+// Подсказка компилятору, что итерации цикла вычисления независимы: приемник может совпадать
+// с операндом только поэлементно, поэтому цикл можно векторизовать без проверок перекрытия
+#if defined(_MSC_VER) && !defined(__clang__)
+#define VECTOR_EXPRESSION_IVDEP __pragma(loop(ivdep))
+#elif defined(__clang__)
+#define VECTOR_EXPRESSION_IVDEP _Pragma("clang loop vectorize(enable)")
+#elif defined(__GNUC__)
+#define VECTOR_EXPRESSION_IVDEP _Pragma("GCC ivdep")
+#else
+#define VECTOR_EXPRESSION_IVDEP
+#endif
+
+// Поэлементные выражения над числовыми векторами. Операторы не вычисляют ничего сами, а строят дерево
+// выражения; всё дерево вычисляется за один проход при присваивании в SimpleVector, без промежуточных векторов.
+// Выражение хранит указатели на данные операндов и не должно переживать их
+
+template <typename Type>
+inline constexpr bool kIsVectorExpression = false;
+
+template <typename Type>
+concept VectorExpression = kIsVectorExpression<std::remove_cvref_t<Type>>;
+
+// Непрерывный контейнер чисел с итераторами-указателями: SimpleVector, StaticVector
+template <typename Container>
+concept ArithmeticContainer = !VectorExpression<Container>
+    && requires(const Container& container)
+    {
+        { std::to_address(container.begin()) } -> std::same_as<decltype(container.data())>;
+        container.get_size();
+    }
+    && std::is_arithmetic_v<std::remove_cvref_t<decltype(*std::declval<const Container&>().data())>>;
+
+template <typename Type>
+concept ExpressionScalar = std::is_arithmetic_v<std::remove_cvref_t<Type>>;
+
+// Хотя бы один из операндов должен быть вектором или выражением, иначе операторы перехватили бы арифметику чисел
+template <typename... Operands>
+concept ExpressionOperands = ((VectorExpression<Operands> || ArithmeticContainer<Operands> || ExpressionScalar<Operands>) && ...)
+    && ((VectorExpression<Operands> || ArithmeticContainer<Operands>) || ...);
+
+// Размер, подходящий операнду любого размера, то есть числу
+inline constexpr size_t kAnyExpressionSize = std::numeric_limits<size_t>::max();
+
+//================================================================ Листья выражения ========================================================================
+
+// Данные вектора-операнда
+template <typename Type>
+class VectorOperand
+{
+public:
+
+    using value_type = Type;
+
+    constexpr VectorOperand(const Type* items, size_t size) noexcept : items(items), size(size) {}
+
+    constexpr Type operator[](size_t index) const noexcept
+    {
+        return items[index];
+    }
+
+    constexpr size_t get_size() const noexcept
+    {
+        return size;
+    }
+
+private:
+
+    const Type* items;
+    size_t size;
+};
+
+// Число, подставляемое в каждую позицию
+template <typename Type>
+class ScalarOperand
+{
+public:
+
+    using value_type = Type;
+
+    constexpr explicit ScalarOperand(Type value) noexcept : value(value) {}
+
+    constexpr Type operator[](size_t) const noexcept
+    {
+        return value;
+    }
+
+    constexpr size_t get_size() const noexcept
+    {
+        return kAnyExpressionSize;
+    }
+
+private:
+
+    Type value;
+};
+
+//================================================================ Узлы выражения ==========================================================================
+
+// Применение операции Operation к элементам операндов с одинаковым индексом
+template <typename Operation, typename... Arguments>
+class ElementwiseExpression
+{
+public:
+
+    using value_type = std::remove_cvref_t<std::invoke_result_t<Operation, typename Arguments::value_type...>>;
+
+    constexpr explicit ElementwiseExpression(Arguments... arguments) : arguments(std::move(arguments)...), size(kAnyExpressionSize)
+    {
+        std::apply([this](const auto&... argument) { (MergeSize(argument.get_size()), ...); }, this->arguments);
+    }
+
+    constexpr value_type operator[](size_t index) const
+    {
+        return std::apply([index](const auto&... argument) { return Operation{}(argument[index]...); }, arguments);
+    }
+
+    constexpr size_t get_size() const noexcept
+    {
+        return size;
+    }
+
+private:
+
+    std::tuple<Arguments...> arguments;
+    size_t size;
+
+    constexpr void MergeSize(size_t argument_size)
+    {
+        if (argument_size == kAnyExpressionSize)
+        {
+            return;
+        }
+        if (size != kAnyExpressionSize && size != argument_size)
+        {
+            throw std::invalid_argument("Vector sizes differ");
+        }
+        size = argument_size;
+    }
+};
+
+template <typename Operation, typename... Arguments>
+inline constexpr bool kIsVectorExpression<ElementwiseExpression<Operation, Arguments...>> = true;
+
+// Выражения, которые вычисляются несколькими потоками, объявлены в parallel_expression.h:
+// без него SimpleVector не зависит от пула потоков
+template <typename Type>
+inline constexpr bool kIsParallelExpression = false;
+
+// Вычисляет параллельное выражение в пуле потоков; false, если выражение слишком мало для деления.
+// Определена в parallel_expression.h
+template <typename Type, typename Expression>
+bool TryEvaluateExpressionParallel(Type* out, const Expression& expression);
+
+//================================================================ Операции ================================================================================
+
+// Модуль числа
+struct AbsOperation
+{
+    template <typename Type>
+    constexpr Type operator()(Type value) const noexcept
+    {
+        if constexpr (std::is_unsigned_v<Type>)
+        {
+            return value;
+        }
+        else
+        {
+            return value < Type() ? -value : value;
+        }
+    }
+};
+
+// a * b + c; при аппаратной поддержке с одним округлением
+struct FmaOperation
+{
+    template <typename A, typename B, typename C>
+    constexpr auto operator()(A a, B b, C c) const noexcept
+    {
+#ifdef FP_FAST_FMA
+        if constexpr (std::is_floating_point_v<std::common_type_t<A, B, C>>)
+        {
+            if (!std::is_constant_evaluated())
+            {
+                return std::fma(static_cast<std::common_type_t<A, B, C>>(a), b, c);
+            }
+        }
+#endif
+        return a * b + c;
+    }
+};
+
+// Выбор элемента по маске
+struct WhereOperation
+{
+    template <typename Mask, typename A, typename B>
+    constexpr std::common_type_t<A, B> operator()(Mask mask, A a, B b) const noexcept
+    {
+        return mask ? a : b;
+    }
+};
+
+//================================================================ Построение выражений ====================================================================
+
+// Приводит операнд к узлу выражения: выражения берутся как есть, векторы и числа оборачиваются
+template <typename Operand>
+constexpr auto MakeExpressionOperand(const Operand& operand)
+{
+    if constexpr (VectorExpression<Operand>)
+    {
+        return operand;
+    }
+    else if constexpr (ArithmeticContainer<Operand>)
+    {
+        using Type = std::remove_cvref_t<decltype(*operand.data())>;
+        return VectorOperand<Type>(operand.data(), operand.get_size());
+    }
+    else
+    {
+        return ScalarOperand<std::remove_cvref_t<Operand>>(operand);
+    }
+}
+
+template <typename Operation, typename... Operands>
+constexpr auto MakeElementwiseExpression(const Operands&... operands)
+{
+    return ElementwiseExpression<Operation, decltype(MakeExpressionOperand(operands))...>(MakeExpressionOperand(operands)...);
+}
+
+//================================================================ Вычисление ==============================================================================
+
+// Вычисляет элементы [first, last) выражения в out за один проход
+template <typename Type, typename Expression>
+constexpr void EvaluateExpressionRange(Type* out, const Expression& expression, size_t first, size_t last)
+{
+    VECTOR_EXPRESSION_IVDEP
+    for (size_t i = first; i < last; ++i)
+    {
+        out[i] = static_cast<Type>(expression[i]);
+    }
+}
+
+// Вычисляет выражение в массив out размером не меньше expression.get_size() O(N)
+template <typename Type, typename Expression>
+constexpr void EvaluateExpression(Type* out, const Expression& expression)
+{
+    const size_t size = expression.get_size();
+
+    if constexpr (kIsParallelExpression<Expression>)
+    {
+        if (!std::is_constant_evaluated() && TryEvaluateExpressionParallel(out, expression))
+        {
+            return;
+        }
+    }
+    EvaluateExpressionRange(out, expression, 0, size);
+}
+
+//================================================= Блок перегруженных операторов =========================================================
+
+template <typename Operand> requires ExpressionOperands<Operand>
+constexpr auto operator-(const Operand& operand)
+{
+    return MakeElementwiseExpression<std::negate<>>(operand);
+}
+
+template <typename Lhs, typename Rhs> requires ExpressionOperands<Lhs, Rhs>
+constexpr auto operator+(const Lhs& lhs, const Rhs& rhs)
+{
+    return MakeElementwiseExpression<std::plus<>>(lhs, rhs);
+}
+
+template <typename Lhs, typename Rhs> requires ExpressionOperands<Lhs, Rhs>
+constexpr auto operator-(const Lhs& lhs, const Rhs& rhs)
+{
+    return MakeElementwiseExpression<std::minus<>>(lhs, rhs);
+}
+
+template <typename Lhs, typename Rhs> requires ExpressionOperands<Lhs, Rhs>
+constexpr auto operator*(const Lhs& lhs, const Rhs& rhs)
+{
+    return MakeElementwiseExpression<std::multiplies<>>(lhs, rhs);
+}
+
+template <typename Lhs, typename Rhs> requires ExpressionOperands<Lhs, Rhs>
+constexpr auto operator/(const Lhs& lhs, const Rhs& rhs)
+{
+    return MakeElementwiseExpression<std::divides<>>(lhs, rhs);
+}
+
+//================================================= Поэлементные функции =========================================================
+
+template <typename Operand> requires ExpressionOperands<Operand>
+constexpr auto abs(const Operand& operand)
+{
+    return MakeElementwiseExpression<AbsOperation>(operand);
+}
+
+template <typename A, typename B, typename C> requires ExpressionOperands<A, B, C>
+constexpr auto fma(const A& a, const B& b, const C& c)
+{
+    return MakeElementwiseExpression<FmaOperation>(a, b, c);
+}
+
+// Поэлементный выбор: mask[i] ? a[i] : b[i]
+template <typename Mask, typename A, typename B> requires ExpressionOperands<Mask, A, B>
+constexpr auto where(const Mask& mask, const A& a, const B& b)
+{
+    return MakeElementwiseExpression<WhereOperation>(mask, a, b);
+}
+
+// Маски сравнения. Операторы < и == у SimpleVector уже заняты лексикографическим сравнением,
+// поэтому поэлементные сравнения вынесены в именованные функции
+template <typename Lhs, typename Rhs> requires ExpressionOperands<Lhs, Rhs>
+constexpr auto mask_less(const Lhs& lhs, const Rhs& rhs)
+{
+    return MakeElementwiseExpression<std::less<>>(lhs, rhs);
+}
+
+template <typename Lhs, typename Rhs> requires ExpressionOperands<Lhs, Rhs>
+constexpr auto mask_less_equal(const Lhs& lhs, const Rhs& rhs)
+{
+    return MakeElementwiseExpression<std::less_equal<>>(lhs, rhs);
+}
+
+template <typename Lhs, typename Rhs> requires ExpressionOperands<Lhs, Rhs>
+constexpr auto mask_greater(const Lhs& lhs, const Rhs& rhs)
+{
+    return MakeElementwiseExpression<std::greater<>>(lhs, rhs);
+}
+
+template <typename Lhs, typename Rhs> requires ExpressionOperands<Lhs, Rhs>
+constexpr auto mask_greater_equal(const Lhs& lhs, const Rhs& rhs)
+{
+    return MakeElementwiseExpression<std::greater_equal<>>(lhs, rhs);
+}
+
+template <typename Lhs, typename Rhs> requires ExpressionOperands<Lhs, Rhs>
+constexpr auto mask_equal(const Lhs& lhs, const Rhs& rhs)
+{
+    return MakeElementwiseExpression<std::equal_to<>>(lhs, rhs);
+}
+
+template <typename Lhs, typename Rhs> requires ExpressionOperands<Lhs, Rhs>
+constexpr auto mask_not_equal(const Lhs& lhs, const Rhs& rhs)
+{
+    return MakeElementwiseExpression<std::not_equal_to<>>(lhs, rhs);
+}
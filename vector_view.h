@@ -0,0 +1,338 @@
+#pragma once
+
+#include <algorithm>
+#include <cassert>
+#include <concepts>
+#include <cstddef>
+#include <iterator>
+#include <stdexcept>
+#include <type_traits>
+
+// Невладеющее представление последовательности элементов с шагом: часть вектора или столбец матрицы
+// без копирования. ElementType - const Type для только читающего представления и Type для изменяющего.
+// Представление не продлевает жизнь данных и становится недействительным при перевыделении памяти владельца
+template <typename ElementType>
+class BasicVectorView;
+
+// Является ли тип представлением
+template <typename Type>
+inline constexpr bool kIsVectorView = false;
+
+template <typename ElementType>
+inline constexpr bool kIsVectorView<BasicVectorView<ElementType>> = true;
+
+template <typename ElementType>
+class BasicVectorView
+{
+public:
+
+    using value_type = std::remove_const_t<ElementType>;
+
+    // Итератор произвольного доступа, проходящий элементы с заданным шагом.
+    // Хранит номер элемента, а не указатель, чтобы конец представления с шагом не выходил за пределы массива
+    class Iterator
+    {
+    public:
+
+        using iterator_category = std::random_access_iterator_tag;
+        using value_type = std::remove_const_t<ElementType>;
+        using difference_type = std::ptrdiff_t;
+        using pointer = ElementType*;
+        using reference = ElementType&;
+
+        constexpr Iterator() = default;
+
+        constexpr Iterator(ElementType* first, difference_type index, difference_type stride) noexcept : first(first), index(index), stride(stride) {}
+
+        constexpr reference operator*() const noexcept
+        {
+            return first[index * stride];
+        }
+
+        constexpr pointer operator->() const noexcept
+        {
+            return first + index * stride;
+        }
+
+        constexpr reference operator[](difference_type offset) const noexcept
+        {
+            return first[(index + offset) * stride];
+        }
+
+        constexpr Iterator& operator++() noexcept
+        {
+            ++index;
+            return *this;
+        }
+
+        constexpr Iterator operator++(int) noexcept
+        {
+            Iterator temp(*this);
+            ++index;
+            return temp;
+        }
+
+        constexpr Iterator& operator--() noexcept
+        {
+            --index;
+            return *this;
+        }
+
+        constexpr Iterator operator--(int) noexcept
+        {
+            Iterator temp(*this);
+            --index;
+            return temp;
+        }
+
+        constexpr Iterator& operator+=(difference_type offset) noexcept
+        {
+            index += offset;
+            return *this;
+        }
+
+        constexpr Iterator& operator-=(difference_type offset) noexcept
+        {
+            index -= offset;
+            return *this;
+        }
+
+        constexpr Iterator operator+(difference_type offset) const noexcept
+        {
+            return Iterator(first, index + offset, stride);
+        }
+
+        friend constexpr Iterator operator+(difference_type offset, const Iterator& it) noexcept
+        {
+            return it + offset;
+        }
+
+        constexpr Iterator operator-(difference_type offset) const noexcept
+        {
+            return Iterator(first, index - offset, stride);
+        }
+
+        constexpr difference_type operator-(const Iterator& other) const noexcept
+        {
+            return index - other.index;
+        }
+
+        constexpr bool operator==(const Iterator& other) const noexcept
+        {
+            return index == other.index;
+        }
+
+        constexpr bool operator!=(const Iterator& other) const noexcept
+        {
+            return index != other.index;
+        }
+
+        constexpr bool operator<(const Iterator& other) const noexcept
+        {
+            return index < other.index;
+        }
+
+        constexpr bool operator>(const Iterator& other) const noexcept
+        {
+            return index > other.index;
+        }
+
+        constexpr bool operator<=(const Iterator& other) const noexcept
+        {
+            return index <= other.index;
+        }
+
+        constexpr bool operator>=(const Iterator& other) const noexcept
+        {
+            return index >= other.index;
+        }
+
+    private:
+
+        ElementType* first = nullptr;
+        difference_type index = 0;
+        difference_type stride = 1;
+    };
+
+//===================================================================== Конструкторы ========================================================================
+
+    constexpr BasicVectorView() noexcept = default;
+
+    // Представление size элементов, начиная с first, через каждые stride элементов
+    constexpr BasicVectorView(ElementType* first, size_t size, size_t stride = 1) noexcept : first(first), size(size), stride(stride)
+    {
+        assert(stride > 0);
+    }
+
+    // Представление всего непрерывного контейнера с методами data() и get_size()
+    template <typename Container>
+        requires (!kIsVectorView<std::remove_const_t<Container>>)
+            && requires(Container& container) { { container.data() } -> std::convertible_to<ElementType*>; container.get_size(); }
+    constexpr BasicVectorView(Container& container) noexcept : first(container.data()), size(container.get_size()) {}
+
+    // Изменяющее представление приводится к только читающему
+    constexpr operator BasicVectorView<const ElementType>() const noexcept requires (!std::is_const_v<ElementType>)
+    {
+        return BasicVectorView<const ElementType>(first, size, stride);
+    }
+
+//================================================================ Операторы ===============================================================================
+
+    // Элемент по индексу O(1)
+    constexpr ElementType& operator[](size_t index) const noexcept
+    {
+        assert(index < size);
+        return first[index * stride];
+    }
+
+//===================================================================== Итераторы ==========================================================================
+
+    constexpr Iterator begin() const noexcept
+    {
+        return Iterator(first, 0, static_cast<std::ptrdiff_t>(stride));
+    }
+
+    constexpr Iterator end() const noexcept
+    {
+        return Iterator(first, static_cast<std::ptrdiff_t>(size), static_cast<std::ptrdiff_t>(stride));
+    }
+
+//===================================================================== Методы =============================================================================
+
+    // Количество элементов O(1)
+    constexpr size_t get_size() const noexcept
+    {
+        return size;
+    }
+
+    // Шаг между соседними элементами O(1)
+    constexpr size_t get_stride() const noexcept
+    {
+        return stride;
+    }
+
+    // Проверка на пустоту O(1)
+    constexpr bool is_empty() const noexcept
+    {
+        return size == 0;
+    }
+
+    // Лежат ли элементы подряд, то есть можно ли передать data() как обычный массив O(1)
+    constexpr bool is_contiguous() const noexcept
+    {
+        return stride == 1 || size <= 1;
+    }
+
+    // Указатель на первый элемент O(1)
+    constexpr ElementType* data() const noexcept
+    {
+        return first;
+    }
+
+    // Ссылка на элемент по индексу с проверкой O(1)
+    constexpr ElementType& at(size_t index) const
+    {
+        if (index >= size)
+        {
+            throw std::out_of_range("Out of range");
+        }
+        return first[index * stride];
+    }
+
+    // Ссылка на первый элемент O(1)
+    constexpr ElementType& front() const
+    {
+        if (size == 0)
+        {
+            throw std::out_of_range("View is empty!");
+        }
+        return first[0];
+    }
+
+    // Ссылка на последний элемент O(1)
+    constexpr ElementType& back() const
+    {
+        if (size == 0)
+        {
+            throw std::out_of_range("View is empty!");
+        }
+        return first[(size - 1) * stride];
+    }
+
+    // Часть представления из count элементов, начиная с индекса offset O(1)
+    constexpr BasicVectorView slice(size_t offset, size_t count) const
+    {
+        if (offset > size || count > size - offset)
+        {
+            throw std::out_of_range("Slice is out of range");
+        }
+        return BasicVectorView(count == 0 ? first : first + offset * stride, count, stride);
+    }
+
+    // Каждый step-й элемент представления O(1)
+    constexpr BasicVectorView every(size_t step) const
+    {
+        if (step == 0)
+        {
+            throw std::invalid_argument("Step must be positive");
+        }
+        return BasicVectorView(first, (size + step - 1) / step, stride * step);
+    }
+
+private:
+
+    ElementType* first = nullptr;
+    size_t size = 0;
+    size_t stride = 1;
+};
+
+// Только читающее представление
+template <typename Type>
+using VectorView = BasicVectorView<const Type>;
+
+// Представление с возможностью изменять элементы
+template <typename Type>
+using MutableVectorView = BasicVectorView<Type>;
+
+//================================================= Блок перегруженных операторов =========================================================
+
+// Представления сравниваются поэлементно между собой и с любой последовательностью, имеющей begin() и end()
+template <typename Lhs, typename Rhs>
+concept VectorViewComparable = (kIsVectorView<Lhs> || kIsVectorView<Rhs>)
+    && requires(const Lhs& lhs, const Rhs& rhs) { lhs.begin(); lhs.end(); rhs.begin(); rhs.end(); };
+
+template <typename Lhs, typename Rhs> requires VectorViewComparable<Lhs, Rhs>
+constexpr bool operator==(const Lhs& lhs, const Rhs& rhs)
+{
+    return std::equal(lhs.begin(), lhs.end(), rhs.begin(), rhs.end());
+}
+
+template <typename Lhs, typename Rhs> requires VectorViewComparable<Lhs, Rhs>
+constexpr bool operator!=(const Lhs& lhs, const Rhs& rhs)
+{
+    return !(lhs == rhs);
+}
+
+template <typename Lhs, typename Rhs> requires VectorViewComparable<Lhs, Rhs>
+constexpr bool operator<(const Lhs& lhs, const Rhs& rhs)
+{
+    return std::lexicographical_compare(lhs.begin(), lhs.end(), rhs.begin(), rhs.end());
+}
+
+template <typename Lhs, typename Rhs> requires VectorViewComparable<Lhs, Rhs>
+constexpr bool operator<=(const Lhs& lhs, const Rhs& rhs)
+{
+    return !(rhs < lhs);
+}
+
+template <typename Lhs, typename Rhs> requires VectorViewComparable<Lhs, Rhs>
+constexpr bool operator>(const Lhs& lhs, const Rhs& rhs)
+{
+    return rhs < lhs;
+}
+
+template <typename Lhs, typename Rhs> requires VectorViewComparable<Lhs, Rhs>
+constexpr bool operator>=(const Lhs& lhs, const Rhs& rhs)
+{
+    return !(lhs < rhs);
+}